@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <boost/graph/breadth_first_search.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/bfs.hpp>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using Csr = py::CsrGraph<>;
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+// Undirected R-MAT graph (a=0.57, b=c=0.19): 2^20 vertices, 2^24 edge pairs
+static auto power_law() -> const Csr& {
+    static const auto gra = [] {
+        constexpr auto scale = 20;
+        auto edges = rmat_edges(scale, std::size_t{1} << 23, 42);
+        const auto size = edges.size();
+        for (auto i = std::size_t{0}; i != size; ++i) {
+            edges.emplace_back(edges[i].second, edges[i].first);
+        }
+        return Csr(std::size_t{1} << scale, edges);
+    }();
+    return gra;
+}
+
+// Undirected 1024 x 1024 grid
+static auto grid() -> const Csr& {
+    static const auto gra = [] {
+        constexpr auto side = std::uint32_t{1024};
+        auto edges = EdgeList{};
+        for (auto r = std::uint32_t{0}; r != side; ++r) {
+            for (auto c = std::uint32_t{0}; c != side; ++c) {
+                const auto v = r * side + c;
+                if (c + 1 != side) {
+                    edges.emplace_back(v, v + 1);
+                    edges.emplace_back(v + 1, v);
+                }
+                if (r + 1 != side) {
+                    edges.emplace_back(v, v + side);
+                    edges.emplace_back(v + side, v);
+                }
+            }
+        }
+        return Csr(std::size_t{side} * side, edges);
+    }();
+    return gra;
+}
+
+template <const Csr& (*Make)()> static void BM_bgl_bfs(benchmark::State& state) {
+    const auto& gra = Make();
+    auto dist = std::vector<std::uint32_t>(num_vertices(gra));
+    for (auto _ : state) {
+        std::fill(dist.begin(), dist.end(), 0);
+        auto record = boost::record_distances(dist.data(), boost::on_tree_edge{});
+        boost::breadth_first_search(gra, 1, boost::visitor(boost::make_bfs_visitor(record)));
+        benchmark::DoNotOptimize(dist.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(num_edges(gra)));
+}
+
+template <const Csr& (*Make)()> static void BM_parallel_bfs(benchmark::State& state) {
+    const auto& gra = Make();
+    py::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+    auto bfs = py::ParallelBfs<>{pool, gra, true};
+    for (auto _ : state) {
+        auto parent = bfs.parents(std::vector<std::uint32_t>{1});
+        benchmark::DoNotOptimize(parent.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(num_edges(gra)));
+}
+
+// 64 searches: one by one, then as one batch
+static void BM_parallel_bfs_64_sources(benchmark::State& state) {
+    const auto& gra = power_law();
+    py::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+    auto bfs = py::ParallelBfs<>{pool, gra, true};
+    for (auto _ : state) {
+        for (auto s = std::uint32_t{0}; s != 64; ++s) {
+            auto parent = bfs.parents(std::vector<std::uint32_t>{s});
+            benchmark::DoNotOptimize(parent.data());
+        }
+    }
+}
+
+static void BM_batched_distances_64_sources(benchmark::State& state) {
+    const auto& gra = power_law();
+    py::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+    auto bfs = py::ParallelBfs<>{pool, gra, true};
+    auto sources = std::vector<std::uint32_t>(64);
+    for (auto s = std::uint32_t{0}; s != 64; ++s) {
+        sources[s] = s;
+    }
+    for (auto _ : state) {
+        auto dist = bfs.distances(sources);
+        benchmark::DoNotOptimize(dist.data());
+    }
+}
+
+BENCHMARK(BM_bgl_bfs<power_law>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_parallel_bfs<power_law>)->ArgName("threads")->Arg(1)->Arg(4)->Arg(8)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_bgl_bfs<grid>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_parallel_bfs<grid>)->ArgName("threads")->Arg(1)->Arg(4)->Arg(8)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_parallel_bfs_64_sources)->ArgName("threads")->Arg(1)->Arg(8)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_batched_distances_64_sources)->ArgName("threads")->Arg(1)->Arg(8)->Unit(
+    benchmark::kMillisecond);
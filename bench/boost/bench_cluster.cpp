@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/cluster.hpp>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using Csr = py::CsrGraph<>;
+using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+constexpr auto scale = 18;
+
+// Undirected R-MAT graph (a=0.57, b=c=0.19): 2^18 vertices, 2^21 edges
+// less the self-loops
+static auto simple_rmat() -> const EdgeList& {
+    static const auto edges = [] {
+        auto result = rmat_edges(scale, std::size_t{1} << 21, 42);
+        std::erase_if(result, [](const auto& e) { return e.first == e.second; });
+        return result;
+    }();
+    return edges;
+}
+
+static auto bgl_graph() -> const Graph& {
+    static const auto gra = [] {
+        auto result = Graph(std::size_t{1} << scale);
+        for (const auto& [u, v] : simple_rmat()) boost::add_edge(u, v, result);
+        return result;
+    }();
+    return gra;
+}
+
+static auto csr_graph() -> const Csr& {
+    static const auto gra = Csr(std::size_t{1} << scale, simple_rmat());
+    return gra;
+}
+
+// Baseline: mark the neighbours of every vertex, then scan theirs (adjacency_list, one thread)
+static void BM_triangles_marking(benchmark::State& state) {
+    const auto& gra = bgl_graph();
+    const auto n = num_vertices(gra);
+    for (auto _ : state) {
+        auto count = std::vector<std::size_t>(n);
+        auto mark = std::vector<std::size_t>(n, n);
+        for (auto u = std::size_t{0}; u != n; ++u) {
+            for (auto [it, last] = adjacent_vertices(u, gra); it != last; ++it) mark[*it] = u;
+            mark[u] = n;
+            auto pairs = std::size_t{0};
+            for (auto [it, last] = adjacent_vertices(u, gra); it != last; ++it) {
+                if (*it == u) continue;
+                for (auto [jt, end] = adjacent_vertices(*it, gra); jt != end; ++jt) {
+                    pairs += static_cast<std::size_t>(mark[*jt] == u);
+                }
+            }
+            count[u] = pairs / 2;
+        }
+        benchmark::DoNotOptimize(count.data());
+    }
+}
+
+static void BM_neighbor_index(benchmark::State& state) {
+    const auto& gra = csr_graph();
+    py::ThreadPool pool{static_cast<unsigned>(state.range(0))};
+    for (auto _ : state) {
+        auto index = py::NeighborIndex<>(pool, gra);
+        benchmark::DoNotOptimize(index.num_vertices());
+    }
+}
+
+static void BM_triangles(benchmark::State& state) {
+    const auto& gra = csr_graph();
+    py::ThreadPool pool{static_cast<unsigned>(state.range(0))};
+    const auto index = py::NeighborIndex<>(pool, gra);
+    for (auto _ : state) {
+        auto count = index.triangles();
+        benchmark::DoNotOptimize(count.data());
+    }
+}
+
+// 2^16 common-neighbour queries between the endpoints of edges
+template <bool Indexed> static void BM_common_neighbors(benchmark::State& state) {
+    const auto& gra = csr_graph();
+    const auto& edges = simple_rmat();
+    py::ThreadPool pool{1};
+    const auto index = py::NeighborIndex<>(pool, gra);
+    for (auto _ : state) {
+        auto total = std::size_t{0};
+        for (auto i = std::size_t{0}; i != 1 << 16; ++i) {
+            const auto& [u, v] = edges[i * 31];
+            total += Indexed ? index.common_neighbors(u, v).size()
+                             : py::common_neighbors(gra, u, v).size();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+BENCHMARK(BM_triangles_marking)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_neighbor_index)->ArgName("threads")->Arg(1)->Arg(8)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_triangles)->ArgName("threads")->RangeMultiplier(2)->Range(1, 64)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_common_neighbors<false>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_common_neighbors<true>)->Unit(benchmark::kMillisecond);
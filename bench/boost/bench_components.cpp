@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/connected_components.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/components.hpp>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+using Undirected = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
+
+constexpr auto scale = 20;
+
+// R-MAT edges (a=0.57, b=c=0.19): 2^20 vertices, 2^22 edges
+static auto rmat() -> const EdgeList& {
+    static const auto edges = rmat_edges(scale, std::size_t{1} << 22, 42);
+    return edges;
+}
+
+// Both directions of every edge
+static auto symmetric_csr() -> const py::CsrGraph<>& {
+    static const auto gra = [] {
+        auto edges = rmat();
+        const auto size = edges.size();
+        for (auto i = std::size_t{0}; i != size; ++i) {
+            edges.emplace_back(edges[i].second, edges[i].first);
+        }
+        return py::CsrGraph<>(std::size_t{1} << scale, edges);
+    }();
+    return gra;
+}
+
+static void BM_bgl_connected_components(benchmark::State& state) {
+    const auto& edges = rmat();
+    const auto gra = Undirected(edges.begin(), edges.end(), std::size_t{1} << scale);
+    auto component = std::vector<std::size_t>(num_vertices(gra));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(boost::connected_components(gra, component.data()));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+}
+
+static void BM_connected_components(benchmark::State& state) {
+    const auto& gra = symmetric_csr();
+    py::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        auto labels = py::connected_components(pool, gra, true);
+        benchmark::DoNotOptimize(labels.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(num_edges(gra) / 2));
+}
+
+// Without the sampling step: every edge is linked
+static void BM_connected_components_unsampled(benchmark::State& state) {
+    const auto& gra = symmetric_csr();
+    py::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        auto labels = py::connected_components(pool, gra, false);
+        benchmark::DoNotOptimize(labels.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(num_edges(gra) / 2));
+}
+
+BENCHMARK(BM_bgl_connected_components)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_connected_components)
+    ->ArgName("threads")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_connected_components_unsampled)
+    ->ArgName("threads")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/topological_sort.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/dag.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using Csr = py::CsrGraph<>;
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+constexpr auto num_nodes = std::uint32_t{1} << 20;
+
+// Timing graph: 2^20 vertices, 2^22 edges, each to a vertex up to 2^12 later
+static auto dag_edges() -> const EdgeList& {
+    static const auto edges = [] {
+        auto random = Lcg{42};
+        auto result = EdgeList{};
+        while (result.size() != std::size_t{1} << 22) {
+            const auto u = random() % num_nodes;
+            const auto v = u + 1 + random() % 4096;
+            if (v < num_nodes) result.emplace_back(u, v);
+        }
+        return result;
+    }();
+    return edges;
+}
+
+static auto forward() -> const Csr& {
+    static const auto gra = Csr(num_nodes, dag_edges());
+    return gra;
+}
+
+// The in-edges of every vertex, with the delay of edge i being i % 7 + 1
+static auto backward() -> const py::CsrGraph<std::uint32_t>& {
+    static const auto gra = [] {
+        const auto& edges = dag_edges();
+        auto reversed = EdgeList{};
+        auto delay = std::vector<std::uint32_t>{};
+        for (auto i = std::size_t{0}; i != edges.size(); ++i) {
+            reversed.emplace_back(edges[i].second, edges[i].first);
+            delay.push_back(static_cast<std::uint32_t>(i % 7 + 1));
+        }
+        return py::CsrGraph<std::uint32_t>(num_nodes, reversed, delay);
+    }();
+    return gra;
+}
+
+// Latest arrival time at `v` from the arrival times of its predecessors
+static void propagate(std::uint32_t v, std::vector<std::uint32_t>& arrival) {
+    const auto& in = backward();
+    const auto offsets = in.row_offsets();
+    const auto sources = in.column_indices();
+    const auto delay = in.edge_properties();
+    auto latest = std::uint32_t{0};
+    for (auto i = offsets[v]; i != offsets[v + 1]; ++i) {
+        latest = std::max(latest, arrival[sources[i]] + delay[i]);
+    }
+    arrival[v] = latest;
+}
+
+// Baseline: BGL topological sort of an adjacency_list, then one sequential sweep
+static void BM_bgl_topological_sweep(benchmark::State& state) {
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS>;
+    static const auto gra = [] {
+        auto result = Graph(num_nodes);
+        for (const auto& [u, v] : dag_edges()) boost::add_edge(u, v, result);
+        return result;
+    }();
+    backward();
+    for (auto _ : state) {
+        auto order = std::vector<std::size_t>{};
+        boost::topological_sort(gra, std::back_inserter(order));
+        auto arrival = std::vector<std::uint32_t>(num_nodes);
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            propagate(static_cast<std::uint32_t>(*it), arrival);
+        }
+        benchmark::DoNotOptimize(arrival.data());
+    }
+}
+
+static void BM_topological_generations(benchmark::State& state) {
+    const auto& gra = forward();
+    py::ThreadPool pool{static_cast<unsigned>(state.range(0))};
+    for (auto _ : state) {
+        auto levels = py::topological_generations(pool, gra);
+        benchmark::DoNotOptimize(levels.data());
+    }
+}
+
+template <py::DagSchedule Schedule> static void BM_dag_foreach(benchmark::State& state) {
+    const auto& gra = forward();
+    backward();
+    py::ThreadPool pool{static_cast<unsigned>(state.range(0))};
+    for (auto _ : state) {
+        auto arrival = std::vector<std::uint32_t>(num_nodes);
+        py::dag_foreach(
+            pool, gra, [&arrival](std::uint32_t v) { propagate(v, arrival); }, Schedule);
+        benchmark::DoNotOptimize(arrival.data());
+    }
+}
+
+BENCHMARK(BM_bgl_topological_sweep)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_topological_generations)
+    ->ArgName("threads")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_dag_foreach<py::DagSchedule::levels>)
+    ->ArgName("threads")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_dag_foreach<py::DagSchedule::dependencies>)
+    ->ArgName("threads")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/dynamic_graph.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+constexpr auto num_nodes = std::size_t{1} << 20;
+
+// Uniform random edges between 2^20 vertices
+static auto random_edges(std::size_t count, std::uint64_t seed) -> EdgeList {
+    auto random = Lcg{seed};
+    auto edges = EdgeList{};
+    for (auto i = std::size_t{0}; i != count; ++i) {
+        edges.emplace_back(random(num_nodes), random(num_nodes));
+    }
+    return edges;
+}
+
+static auto base_edges() -> const EdgeList& {
+    static const auto edges = random_edges(std::size_t{1} << 22, 42);
+    return edges;
+}
+
+// Baseline: keep an immutable CsrGraph by rebuilding it after every batch of 2^14 updates
+static void BM_rebuild_csr(benchmark::State& state) {
+    py::ThreadPool pool{4};
+    auto edges = base_edges();
+    const auto updates = random_edges(std::size_t{1} << 14, 7);
+    for (auto _ : state) {
+        edges.insert(edges.end(), updates.begin(), updates.end());
+        auto gra = py::CsrGraph<>(pool, num_nodes, edges);
+        benchmark::DoNotOptimize(gra.column_indices().data());
+    }
+    state.SetItemsProcessed(state.iterations() * (std::int64_t{1} << 14));
+}
+
+// 2^18 updates (3 insertions to 1 deletion), compacting every `threshold` updates
+static void BM_update_throughput(benchmark::State& state) {
+    py::ThreadPool pool{4};
+    auto gra = py::DynamicGraph<>(pool, num_nodes, base_edges());
+    gra.compaction_threshold = static_cast<std::size_t>(state.range(0));
+    const auto updates = random_edges(std::size_t{1} << 18, 7);
+    for (auto _ : state) {
+        for (auto i = std::size_t{0}; i != updates.size(); ++i) {
+            const auto [u, v] = updates[i];
+            if (i % 4 == 3) {
+                gra.remove_edge(u, v);
+            } else {
+                gra.add_edge(u, v);
+            }
+        }
+        gra.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(updates.size()));
+}
+
+// 16 batches of 2^10 reads (a snapshot, then the out-neighbours of 2^10
+// vertices) with a writer running alongside when `writing` is 1, which
+// keeps compactions going
+static void BM_query_latency(benchmark::State& state) {
+    py::ThreadPool pool{4};
+    auto gra = py::DynamicGraph<>(pool, num_nodes, base_edges());
+    auto stop = std::atomic<bool>{false};
+    auto writer = std::thread{};
+    if (state.range(0) != 0) {
+        writer = std::thread{[&] {
+            const auto updates = random_edges(std::size_t{1} << 20, 9);
+            for (auto i = std::size_t{0}; !stop.load(std::memory_order_relaxed); ++i) {
+                const auto [u, v] = updates[i % updates.size()];
+                gra.add_edge(u, v);
+            }
+        }};
+    }
+    const auto queries = random_edges(std::size_t{1} << 14, 11);
+    for (auto _ : state) {
+        auto total = std::size_t{0};
+        for (auto batch = std::size_t{0}; batch != queries.size(); batch += 1024) {
+            const auto snap = gra.snapshot();
+            for (auto i = batch; i != batch + 1024; ++i) {
+                const auto [u, v] = queries[i];
+                total += snap.neighbors(u).size() + static_cast<std::size_t>(snap.has_edge(v, u));
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    stop.store(true);
+    if (writer.joinable()) writer.join();
+    gra.wait();
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(queries.size()));
+}
+
+BENCHMARK(BM_rebuild_csr)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_update_throughput)
+    ->ArgName("threshold")
+    ->RangeMultiplier(4)
+    ->Range(1 << 12, 1 << 18)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_query_latency)->ArgName("writing")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
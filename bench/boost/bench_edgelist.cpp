@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/edgelist.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+// A weighted edge list with 2^22 random edges on 2^18 vertices (written once)
+static auto edgelist_file() -> const std::string& {
+    static const auto path = [] {
+        auto name = (std::filesystem::temp_directory_path() / "py2cpp_bench.edgelist").string();
+        auto out = std::ofstream(name, std::ios::binary);
+        auto random = Lcg{42};
+        for (auto i = 0; i != 1 << 22; ++i) {
+            out << random(1 << 18) << ' ' << random(1 << 18) << ' ' << random(1000) << ".5\n";
+        }
+        return name;
+    }();
+    return path;
+}
+
+static void BM_ifstream_edgelist(benchmark::State& state) {
+    const auto& path = edgelist_file();
+    const auto bytes = static_cast<std::int64_t>(std::filesystem::file_size(path));
+    for (auto _ : state) {
+        auto in = std::ifstream(path);
+        auto edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+        auto weights = std::vector<double>{};
+        auto u = std::uint32_t{};
+        auto v = std::uint32_t{};
+        auto w = 0.0;
+        auto n = std::uint32_t{0};
+        while (in >> u >> v >> w) {
+            edges.emplace_back(u, v);
+            weights.push_back(w);
+            n = std::max({n, u + 1, v + 1});
+        }
+        auto gra = py::CsrGraph<double>(n, edges, weights);
+        benchmark::DoNotOptimize(gra.column_indices().data());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+static void BM_read_edgelist(benchmark::State& state) {
+    const auto& path = edgelist_file();
+    const auto bytes = static_cast<std::int64_t>(std::filesystem::file_size(path));
+    py::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        auto result = py::read_edgelist<double>(pool, path, {.relabel = false});
+        benchmark::DoNotOptimize(result.graph.column_indices().data());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+BENCHMARK(BM_ifstream_edgelist)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_read_edgelist)->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(
+    benchmark::kMillisecond);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+using AdjList = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS>;
+
+// Uniformly random edges on n = m / 16 vertices (fixed seed)
+static auto random_edges(std::size_t m) -> const EdgeList& {
+    static auto cache = std::vector<std::pair<std::size_t, EdgeList>>{};
+    for (const auto& [size, edges] : cache) {
+        if (size == m) return edges;
+    }
+    const auto n = m / 16;
+    auto edges = EdgeList{};
+    edges.reserve(m);
+    auto random = Lcg{42};
+    for (auto i = std::size_t{0}; i != m; ++i) {
+        const auto u = random(n);
+        edges.emplace_back(u, random(n));
+    }
+    return cache.emplace_back(m, std::move(edges)).second;
+}
+
+static void BM_AdjacencyList_add_edge(benchmark::State& state) {
+    const auto m = static_cast<std::size_t>(state.range(0));
+    const auto& edges = random_edges(m);
+    for (auto _ : state) {
+        auto G = py::GrAdaptor<AdjList>(AdjList(m / 16));
+        for (auto [u, v] : edges) {
+            G.add_edge(static_cast<int>(u), static_cast<int>(v));
+        }
+        benchmark::DoNotOptimize(G.number_of_edges());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_AdjacencyList_add_edges_from(benchmark::State& state) {
+    const auto m = static_cast<std::size_t>(state.range(0));
+    const auto& edges = random_edges(m);
+    for (auto _ : state) {
+        auto G = py::GrAdaptor<AdjList>(AdjList(0));
+        G.add_edges_from(edges);
+        benchmark::DoNotOptimize(G.number_of_edges());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_CsrGraph_sequential(benchmark::State& state) {
+    const auto m = static_cast<std::size_t>(state.range(0));
+    const auto& edges = random_edges(m);
+    for (auto _ : state) {
+        auto G = py::CsrGraph<>(m / 16, edges);
+        benchmark::DoNotOptimize(G.column_indices().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_CsrGraph_parallel(benchmark::State& state) {
+    const auto m = static_cast<std::size_t>(state.range(0));
+    const auto& edges = random_edges(m);
+    py::ThreadPool pool{static_cast<std::size_t>(state.range(1))};
+    for (auto _ : state) {
+        auto G = py::CsrGraph<>(pool, m / 16, edges);
+        benchmark::DoNotOptimize(G.column_indices().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_AdjacencyList_add_edge)->Arg(1 << 20)->Arg(1 << 23)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AdjacencyList_add_edges_from)
+    ->Arg(1 << 20)
+    ->Arg(1 << 23)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CsrGraph_sequential)->Arg(1 << 20)->Arg(1 << 23)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CsrGraph_parallel)
+    ->ArgNames({"edges", "threads"})
+    ->ArgsProduct({{1 << 20, 1 << 23}, {1, 2, 4, 8}})
+    ->Unit(benchmark::kMillisecond);
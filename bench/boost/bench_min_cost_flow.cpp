@@ -0,0 +1,159 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/successive_shortest_path_nonnegative_weights.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/min_cost_flow.hpp>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+using Solver = py::MinCostFlowSolver<>;
+
+constexpr auto num_nodes = std::uint32_t{1} << 12;
+
+// Transportation-like instance: 8 random edges out of every vertex, a ring
+// of expensive uncapacitated edges keeping it feasible, and 256 supplies
+// of up to 50 units; edges are sorted by source so that ids are positions
+struct Instance {
+    py::CsrGraph<> graph;
+    std::vector<std::int64_t> demand;
+    std::vector<std::int64_t> capacity;
+    std::vector<std::int64_t> cost;
+};
+
+static auto instance() -> const Instance& {
+    static const auto inst = [] {
+        auto random = Lcg{42};
+        auto edges = EdgeList{};
+        auto result = Instance{};
+        for (auto u = std::uint32_t{0}; u != num_nodes; ++u) {
+            for (auto k = 0; k != 8; ++k) {
+                edges.emplace_back(u, random() % num_nodes);
+                result.capacity.push_back(random() % 20 + 1);
+                result.cost.push_back(random() % 100 + 1);
+            }
+            edges.emplace_back(u, (u + 1) % num_nodes);
+            result.capacity.push_back(Solver::infinite);
+            result.cost.push_back(1000);
+        }
+        result.graph = py::CsrGraph<>(num_nodes, edges);
+        result.demand.assign(num_nodes, 0);
+        for (auto k = 0; k != 256; ++k) {
+            const auto amount = std::int64_t{random() % 50 + 1};
+            result.demand[random() % num_nodes] -= amount;
+            result.demand[random() % num_nodes] += amount;
+        }
+        return result;
+    }();
+    return inst;
+}
+
+// Baseline: successive shortest paths (BGL) from a super source to a super sink
+static void BM_bgl_successive_shortest_path(benchmark::State& state) {
+    using Traits = boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS>;
+    using Graph = boost::adjacency_list<
+        boost::vecS, boost::vecS, boost::directedS, boost::no_property,
+        boost::property<
+            boost::edge_capacity_t, std::int64_t,
+            boost::property<
+                boost::edge_residual_capacity_t, std::int64_t,
+                boost::property<boost::edge_reverse_t, Traits::edge_descriptor,
+                                boost::property<boost::edge_weight_t, std::int64_t>>>>>;
+    const auto& inst = instance();
+    auto total = std::int64_t{0};
+    for (const auto d : inst.demand) total += d > 0 ? d : 0;
+    auto gra = Graph(num_nodes + 2);
+    const auto source = num_nodes;
+    const auto sink = num_nodes + 1;
+    auto capacity = get(boost::edge_capacity, gra);
+    auto residual = get(boost::edge_residual_capacity, gra);
+    auto reverse = get(boost::edge_reverse, gra);
+    auto weight = get(boost::edge_weight, gra);
+    const auto add = [&](std::size_t u, std::size_t v, std::int64_t cap, std::int64_t cost) {
+        const auto e = boost::add_edge(u, v, gra).first;
+        const auto r = boost::add_edge(v, u, gra).first;
+        capacity[e] = cap;
+        capacity[r] = 0;
+        weight[e] = cost;
+        weight[r] = -cost;
+        reverse[e] = r;
+        reverse[r] = e;
+    };
+    const auto offsets = inst.graph.row_offsets();
+    const auto targets = inst.graph.column_indices();
+    for (auto u = std::size_t{0}; u != num_nodes; ++u) {
+        for (auto i = offsets[u]; i != offsets[u + 1]; ++i) {
+            add(u, targets[i], std::min(inst.capacity[i], total), inst.cost[i]);
+        }
+        if (inst.demand[u] < 0) add(source, u, -inst.demand[u], 0);
+        if (inst.demand[u] > 0) add(u, sink, inst.demand[u], 0);
+    }
+    for (auto _ : state) {
+        boost::successive_shortest_path_nonnegative_weights(gra, source, sink);
+        auto flow_cost = std::int64_t{0};
+        for (auto [ei, eend] = edges(gra); ei != eend; ++ei) {
+            if (capacity[*ei] > 0) flow_cost += (capacity[*ei] - residual[*ei]) * weight[*ei];
+        }
+        benchmark::DoNotOptimize(flow_cost);
+    }
+}
+
+static void BM_network_simplex(benchmark::State& state) {
+    const auto& inst = instance();
+    for (auto _ : state) {
+        auto solver = Solver(inst.graph);
+        benchmark::DoNotOptimize(solver.run(inst.demand, inst.capacity, inst.cost));
+    }
+}
+
+// 16 solves, each after 64 costs change, reusing the solver when `warm` is 1
+static void BM_resolve_costs(benchmark::State& state) {
+    const auto& inst = instance();
+    auto solver = Solver(inst.graph);
+    solver.run(inst.demand, inst.capacity, inst.cost);
+    auto cost = inst.cost;
+    auto random = Lcg{7};
+    for (auto _ : state) {
+        for (auto round = 0; round != 16; ++round) {
+            for (auto k = 0; k != 64; ++k) cost[random() % cost.size()] = random() % 100 + 1;
+            if (state.range(0) != 0) {
+                benchmark::DoNotOptimize(solver.run(inst.demand, inst.capacity, cost));
+            } else {
+                benchmark::DoNotOptimize(Solver(inst.graph).run(inst.demand, inst.capacity, cost));
+            }
+        }
+    }
+}
+
+// 16 solves, each after 4 units of supply move, reusing the solver when `warm` is 1
+static void BM_resolve_demands(benchmark::State& state) {
+    const auto& inst = instance();
+    auto solver = Solver(inst.graph);
+    solver.run(inst.demand, inst.capacity, inst.cost);
+    auto demand = inst.demand;
+    auto random = Lcg{9};
+    for (auto _ : state) {
+        for (auto round = 0; round != 16; ++round) {
+            for (auto k = 0; k != 4; ++k) {
+                --demand[random() % num_nodes];
+                ++demand[random() % num_nodes];
+            }
+            if (state.range(0) != 0) {
+                benchmark::DoNotOptimize(solver.run(demand, inst.capacity, inst.cost));
+            } else {
+                benchmark::DoNotOptimize(Solver(inst.graph).run(demand, inst.capacity, inst.cost));
+            }
+        }
+    }
+}
+
+BENCHMARK(BM_bgl_successive_shortest_path)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_network_simplex)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_resolve_costs)->ArgName("warm")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_resolve_demands)->ArgName("warm")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
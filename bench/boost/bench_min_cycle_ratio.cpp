@@ -0,0 +1,151 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/fractions.hpp>
+#include <py2cpp/min_cycle_ratio.hpp>
+#include <py2cpp/neg_cycle.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using Fraction = fun::Fraction<std::int64_t>;
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+struct Instance {
+    py::CsrGraph<> graph;
+    std::vector<std::int64_t> cost;
+    std::vector<std::int64_t> time;
+};
+
+// Builds the instance with edges sorted by source, so that the edge ids
+// of the CsrGraph are the positions in `cost` and `time`
+static auto make_instance(std::size_t n, std::vector<std::vector<std::uint32_t>>& out,
+                          std::vector<std::vector<std::pair<std::int64_t, std::int64_t>>>& data)
+    -> Instance {
+    auto result = Instance{};
+    auto edges = EdgeList{};
+    for (auto u = std::uint32_t{0}; u != n; ++u) {
+        for (auto k = std::size_t{0}; k != out[u].size(); ++k) {
+            edges.emplace_back(u, out[u][k]);
+            result.cost.push_back(data[u][k].first);
+            result.time.push_back(data[u][k].second);
+        }
+    }
+    result.graph = py::CsrGraph<>(n, edges);
+    return result;
+}
+
+// Random directed graph: 2^14 vertices, 2^16 edges, cost 1 .. 1000, time 1 .. 10
+static auto random_instance() -> const Instance& {
+    static const auto instance = [] {
+        constexpr auto n = std::size_t{1} << 14;
+        auto out = std::vector<std::vector<std::uint32_t>>(n);
+        auto data = std::vector<std::vector<std::pair<std::int64_t, std::int64_t>>>(n);
+        auto random = Lcg{42};
+        for (auto i = 0; i != 1 << 16; ++i) {
+            const auto u = random() % n;
+            out[u].push_back(static_cast<std::uint32_t>(random() % n));
+            data[u].emplace_back(random() % 1000 + 1, random() % 10 + 1);
+        }
+        return make_instance(n, out, data);
+    }();
+    return instance;
+}
+
+// Sequential circuit: 64 levels of 256 gates with fan-in 2 (gate delays
+// 1 .. 20, no registers), and 4096 register edges (time 1) from deeper
+// levels back to shallower ones
+static auto circuit_instance() -> const Instance& {
+    static const auto instance = [] {
+        constexpr auto levels = std::size_t{64};
+        constexpr auto width = std::size_t{256};
+        constexpr auto n = levels * width;
+        auto out = std::vector<std::vector<std::uint32_t>>(n);
+        auto data = std::vector<std::vector<std::pair<std::int64_t, std::int64_t>>>(n);
+        auto random = Lcg{7};
+        for (auto level = std::size_t{1}; level != levels; ++level) {
+            for (auto g = std::size_t{0}; g != width; ++g) {
+                const auto v = static_cast<std::uint32_t>(level * width + g);
+                for (auto k = 0; k != 2; ++k) {
+                    const auto u = (level - 1) * width + random() % width;
+                    out[u].push_back(v);
+                    data[u].emplace_back(random() % 20 + 1, 0);
+                }
+            }
+        }
+        for (auto i = 0; i != 4096; ++i) {
+            const auto from = random() % levels;
+            const auto to = random() % (from + 1);
+            const auto u = from * width + random() % width;
+            out[u].push_back(static_cast<std::uint32_t>(to * width + random() % width));
+            data[u].emplace_back(1, 1);
+        }
+        return make_instance(n, out, data);
+    }();
+    return instance;
+}
+
+// The solver: one graph, integer weights, buffers reused
+template <const Instance& (*Make)()> static void BM_min_cycle_ratio(benchmark::State& state) {
+    const auto& [gra, cost, time] = Make();
+    auto solver = py::MinCycleRatioSolver<>(gra);
+    for (auto _ : state) {
+        auto result = solver.run(cost, time);
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["steps"] = static_cast<double>(solver.iterations());
+}
+
+template <const Instance& (*Make)()>
+static void BM_min_cycle_ratio_parallel(benchmark::State& state) {
+    const auto& [gra, cost, time] = Make();
+    py::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+    auto solver = py::MinCycleRatioSolver<>(pool, gra);
+    for (auto _ : state) {
+        auto result = solver.run(cost, time);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+// Baseline: parametric search driven from outside, with a new finder and
+// Fraction weights in every step
+template <const Instance& (*Make)()> static void BM_external_parametric(benchmark::State& state) {
+    const auto& [gra, cost, time] = Make();
+    for (auto _ : state) {
+        auto ratio = Fraction(1);
+        for (const auto c : cost) ratio += c;
+        for (;;) {
+            auto finder = py::NegCycleFinder<Fraction>(gra);
+            auto weight = std::vector<Fraction>{};
+            for (auto id = std::size_t{0}; id != cost.size(); ++id) {
+                weight.push_back(Fraction(cost[id]) - ratio * time[id]);
+            }
+            auto dist = std::vector<Fraction>(num_vertices(gra));
+            const auto cycles = finder.howard(dist, weight);
+            if (cycles.empty()) break;
+            for (const auto& cycle : cycles) {
+                auto c = std::int64_t{0};
+                auto t = std::int64_t{0};
+                for (const auto id : cycle) {
+                    c += cost[id];
+                    t += time[id];
+                }
+                if (Fraction(c, t) < ratio) ratio = Fraction(c, t);
+            }
+        }
+        benchmark::DoNotOptimize(ratio);
+    }
+}
+
+BENCHMARK(BM_min_cycle_ratio<random_instance>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_min_cycle_ratio_parallel<random_instance>)->ArgName("threads")->Arg(1)->Arg(8)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_external_parametric<random_instance>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_min_cycle_ratio<circuit_instance>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_min_cycle_ratio_parallel<circuit_instance>)->ArgName("threads")->Arg(1)->Arg(8)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_external_parametric<circuit_instance>)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/fractions.hpp>
+#include <py2cpp/neg_cycle.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using Fraction = fun::Fraction<std::int64_t>;
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+constexpr auto num_nodes = std::uint32_t{1} << 16;
+
+// Random directed graph with 2^18 edges and weights in -8/12 .. 91/12
+// (no negative cycle)
+static auto random_graph() -> const std::pair<py::CsrGraph<>, std::vector<Fraction>>& {
+    static const auto result = [] {
+        auto edges = EdgeList{};
+        auto weight = std::vector<Fraction>{};
+        auto random = Lcg{42};
+        for (auto i = 0; i != 1 << 18; ++i) {
+            const auto u = random() % num_nodes;
+            edges.emplace_back(u, random() % num_nodes);
+            weight.emplace_back(static_cast<std::int64_t>(random() % 100) - 8, 12);
+        }
+        return std::pair{py::CsrGraph<>(num_nodes, edges), std::move(weight)};
+    }();
+    return result;
+}
+
+static void BM_howard_cold(benchmark::State& state) {
+    const auto& [gra, weight] = random_graph();
+    auto finder = py::NegCycleFinder<Fraction>(gra);
+    for (auto _ : state) {
+        auto dist = std::vector<Fraction>(num_nodes);
+        auto cycles = finder.howard(dist, weight);
+        benchmark::DoNotOptimize(cycles.data());
+    }
+}
+
+// Lower one weight per search (and restore the previous one), starting
+// from the previous distances and the changed edges
+static void BM_howard_warm(benchmark::State& state) {
+    const auto& [gra, original] = random_graph();
+    auto weight = original;
+    auto finder = py::NegCycleFinder<Fraction>(gra);
+    auto dist = std::vector<Fraction>(num_nodes);
+    finder.howard(dist, weight);
+    auto id = std::size_t{0};
+    for (auto _ : state) {
+        const auto changed = std::array{id, (id + 7919) % weight.size()};
+        weight[changed[0]] = original[changed[0]];
+        weight[changed[1]] = original[changed[1]] - Fraction(1, 24);
+        id = changed[1];
+        auto cycles = finder.howard(dist, weight, changed);
+        benchmark::DoNotOptimize(cycles.data());
+    }
+}
+
+static void BM_howard_parallel_cold(benchmark::State& state) {
+    const auto& [gra, weight] = random_graph();
+    py::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+    auto finder = py::NegCycleFinder<Fraction>(pool, gra);
+    for (auto _ : state) {
+        auto dist = std::vector<Fraction>(num_nodes);
+        auto cycles = finder.howard(dist, weight);
+        benchmark::DoNotOptimize(cycles.data());
+    }
+}
+
+BENCHMARK(BM_howard_cold)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_howard_warm)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_howard_parallel_cold)->ArgName("threads")->Arg(1)->Arg(4)->Arg(8)->Unit(
+    benchmark::kMillisecond);
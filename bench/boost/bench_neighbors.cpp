@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using AdjList = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS>;
+using Csr = py::CsrGraph<>;
+
+// 2^20 vertices of out-degree 16 with random targets (fixed seed)
+static auto random_edges() -> const std::vector<std::pair<std::uint32_t, std::uint32_t>>& {
+    static const auto edges = [] {
+        constexpr auto n = std::uint32_t{1} << 20;
+        auto result = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+        auto random = Lcg{42};
+        for (auto u = std::uint32_t{0}; u != n; ++u) {
+            for (auto k = 0; k != 16; ++k) {
+                result.emplace_back(u, random(n));
+            }
+        }
+        return result;
+    }();
+    return edges;
+}
+
+// Sum of the neighbour ids of every vertex: the inner loop of a pull-style sweep
+template <typename Graph> static void BM_neighbors_target(benchmark::State& state) {
+    auto G = py::GrAdaptor<Graph>(Graph(1U << 20));
+    G.add_edges_from(random_edges());
+    for (auto _ : state) {
+        auto sum = std::size_t{0};
+        for (auto u : G) {
+            for (auto e : G.neighbors(u)) {
+                sum += G.target(e);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(G.number_of_edges()));
+}
+
+template <typename Graph> static void BM_adjacent_nodes(benchmark::State& state) {
+    auto G = py::GrAdaptor<Graph>(Graph(1U << 20));
+    G.add_edges_from(random_edges());
+    for (auto _ : state) {
+        auto sum = std::size_t{0};
+        for (auto u : G) {
+            for (auto v : G.adjacent_nodes(u)) {
+                sum += v;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(G.number_of_edges()));
+}
+
+static void BM_csr_neighbors_target(benchmark::State& state) {
+    const auto G = py::GrAdaptor<Csr>(Csr(1U << 20, random_edges()));
+    for (auto _ : state) {
+        auto sum = std::size_t{0};
+        for (auto u : G) {
+            for (auto e : G.neighbors(u)) {
+                sum += G.target(e);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(G.number_of_edges()));
+}
+
+static void BM_csr_adjacent_nodes(benchmark::State& state) {
+    const auto G = py::GrAdaptor<Csr>(Csr(1U << 20, random_edges()));
+    for (auto _ : state) {
+        auto sum = std::size_t{0};
+        for (auto u : G) {
+            for (auto v : G.adjacent_nodes(u)) {
+                sum += v;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(G.number_of_edges()));
+}
+
+BENCHMARK(BM_neighbors_target<AdjList>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_adjacent_nodes<AdjList>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_csr_neighbors_target)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_csr_adjacent_nodes)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <boost/range/iterator_range.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/pagerank.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using Csr = py::CsrGraph<>;
+
+constexpr auto scale = 20;
+
+// Directed R-MAT graph (a=0.57, b=c=0.19): 2^20 vertices, 2^23 edges
+static auto rmat() -> const Csr& {
+    static const auto gra = [] {
+        return Csr(std::size_t{1} << scale, rmat_edges(scale, std::size_t{1} << 23, 42));
+    }();
+    return gra;
+}
+
+// Baseline: push-style power iteration over the out-edges on one thread,
+// with the stopping rule of py::pagerank()
+static auto push_pagerank(const Csr& gra) -> std::vector<double> {
+    const auto n = num_vertices(gra);
+    auto x = std::vector<double>(n, 1.0 / static_cast<double>(n));
+    auto next = std::vector<double>(n);
+    for (auto change = 1.0; change >= static_cast<double>(n) * 1.0e-6;) {
+        auto dangling = 0.0;
+        std::fill(next.begin(), next.end(), 0.0);
+        for (auto u = std::uint32_t{0}; u != n; ++u) {
+            const auto degree = out_degree(u, gra);
+            if (degree == 0) {
+                dangling += x[u];
+                continue;
+            }
+            const auto share = x[u] / static_cast<double>(degree);
+            for (const auto e : boost::make_iterator_range(out_edges(u, gra))) {
+                next[target(e, gra)] += share;
+            }
+        }
+        const auto base = (0.85 * dangling + 0.15) / static_cast<double>(n);
+        change = 0.0;
+        for (auto v = std::size_t{0}; v != n; ++v) {
+            next[v] = 0.85 * next[v] + base;
+            change += std::abs(next[v] - x[v]);
+        }
+        std::swap(x, next);
+    }
+    return x;
+}
+
+static void BM_push_pagerank(benchmark::State& state) {
+    const auto& gra = rmat();
+    for (auto _ : state) {
+        auto rank = push_pagerank(gra);
+        benchmark::DoNotOptimize(rank.data());
+    }
+}
+
+static void BM_pagerank(benchmark::State& state) {
+    const auto& gra = rmat();
+    py::ThreadPool pool{static_cast<unsigned>(state.range(0))};
+    for (auto _ : state) {
+        auto rank = py::pagerank(pool, gra);
+        benchmark::DoNotOptimize(rank.data());
+    }
+}
+
+static auto seeds(std::size_t count) -> std::vector<std::uint32_t> {
+    auto result = std::vector<std::uint32_t>(count);
+    for (auto b = std::size_t{0}; b != count; ++b) {
+        result[b] = static_cast<std::uint32_t>(b * 7919);
+    }
+    return result;
+}
+
+// Personalized PageRank for 8 seeds, one call per seed
+static void BM_personalized_one_by_one(benchmark::State& state) {
+    const auto& gra = rmat();
+    py::ThreadPool pool{static_cast<unsigned>(state.range(0))};
+    const auto sources = seeds(8);
+    for (auto _ : state) {
+        for (auto b = std::size_t{0}; b != sources.size(); ++b) {
+            auto rank = py::personalized_pagerank(pool, gra, std::span(sources).subspan(b, 1));
+            benchmark::DoNotOptimize(rank.data());
+        }
+    }
+}
+
+// Personalized PageRank for 8 seeds in one batch
+static void BM_personalized_batch(benchmark::State& state) {
+    const auto& gra = rmat();
+    py::ThreadPool pool{static_cast<unsigned>(state.range(0))};
+    const auto sources = seeds(8);
+    for (auto _ : state) {
+        auto rank = py::personalized_pagerank(pool, gra, std::span(sources));
+        benchmark::DoNotOptimize(rank.data());
+    }
+}
+
+BENCHMARK(BM_push_pagerank)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_pagerank)->ArgName("threads")->RangeMultiplier(2)->Range(1, 64)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_personalized_one_by_one)->ArgName("threads")->Arg(1)->Arg(8)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_personalized_batch)->ArgName("threads")->Arg(1)->Arg(8)->Unit(
+    benchmark::kMillisecond);
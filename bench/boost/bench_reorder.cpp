@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/bfs.hpp>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/reorder.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using Csr = py::CsrGraph<>;
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+constexpr auto scale = 20;
+
+// Undirected R-MAT graph (a=0.57, b=c=0.19): 2^20 vertices, 2^22 edge
+// pairs, with the vertex ids shuffled as if they came from an arbitrary input
+static auto shuffled_rmat() -> const Csr& {
+    static const auto gra = [] {
+        constexpr auto n = std::uint32_t{1} << scale;
+        auto random = Lcg{43};
+        auto id = std::vector<std::uint32_t>(n);
+        for (auto v = std::uint32_t{0}; v != n; ++v) id[v] = v;
+        for (auto i = n - 1; i != 0; --i) std::swap(id[i], id[random(i + 1)]);
+        auto edges = EdgeList{};
+        for (const auto& [u, v] : rmat_edges(scale, std::size_t{1} << 22, 42)) {
+            edges.emplace_back(id[u], id[v]);
+            edges.emplace_back(id[v], id[u]);
+        }
+        return Csr(n, edges);
+    }();
+    return gra;
+}
+
+static auto identity(const Csr& gra) -> py::Permutation<> {
+    auto order = std::vector<std::uint32_t>(num_vertices(gra));
+    for (auto v = std::uint32_t{0}; v != order.size(); ++v) order[v] = v;
+    return py::Permutation<>::from_order(std::move(order));
+}
+
+static auto rcm(const Csr& gra) -> py::Permutation<> {
+    return py::reverse_cuthill_mckee_ordering(gra);
+}
+static auto by_degree(const Csr& gra) -> py::Permutation<> { return py::degree_ordering(gra); }
+static auto by_bfs(const Csr& gra) -> py::Permutation<> { return py::bfs_ordering(gra); }
+
+template <py::Permutation<> (*Order)(const Csr&)> static auto relabeled() -> const Csr& {
+    static const auto gra = py::relabel_nodes(shuffled_rmat(), Order(shuffled_rmat()));
+    return gra;
+}
+
+// Cost of computing an ordering and applying it
+template <py::Permutation<> (*Order)(const Csr&)> static void BM_reorder(benchmark::State& state) {
+    const auto& gra = shuffled_rmat();
+    for (auto _ : state) {
+        auto result = py::relabel_nodes(gra, Order(gra));
+        benchmark::DoNotOptimize(result.column_indices().data());
+    }
+}
+
+// One pull sweep of PageRank: every vertex sums the values of its neighbours
+template <py::Permutation<> (*Order)(const Csr&)>
+static void BM_pull_sweep(benchmark::State& state) {
+    const auto& gra = relabeled<Order>();
+    const auto offsets = gra.row_offsets();
+    const auto targets = gra.column_indices();
+    const auto n = num_vertices(gra);
+    auto rank = std::vector<double>(n, 1.0 / static_cast<double>(n));
+    auto next = std::vector<double>(n);
+    for (auto _ : state) {
+        for (auto v = std::size_t{0}; v != n; ++v) {
+            auto sum = 0.0;
+            for (auto k = offsets[v]; k != offsets[v + 1]; ++k) sum += rank[targets[k]];
+            next[v] = sum;
+        }
+        benchmark::DoNotOptimize(next.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(num_edges(gra)));
+}
+
+// Breadth-first search on one thread, from the vertex of largest degree
+template <py::Permutation<> (*Order)(const Csr&)> static void BM_bfs(benchmark::State& state) {
+    const auto& gra = relabeled<Order>();
+    py::ThreadPool pool{1};
+    auto bfs = py::ParallelBfs<>(pool, gra, true);
+    const auto source = py::degree_ordering(gra).old_id.front();
+    for (auto _ : state) {
+        auto parents = bfs.parents(std::span<const std::uint32_t>(&source, 1));
+        benchmark::DoNotOptimize(parents.data());
+    }
+}
+
+BENCHMARK(BM_reorder<rcm>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_reorder<by_degree>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_reorder<by_bfs>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_pull_sweep<identity>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_pull_sweep<rcm>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_pull_sweep<by_degree>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_pull_sweep<by_bfs>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_bfs<identity>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_bfs<rcm>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_bfs<by_degree>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_bfs<by_bfs>)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/fractions.hpp>
+#include <py2cpp/shortest_path.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using Fraction = fun::Fraction<std::int64_t>;
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+// Random directed graph: 2^20 vertices, 2^23 edges, weights in 1 .. 255
+static auto random_graph() -> const py::CsrGraph<int>& {
+    static const auto gra = [] {
+        constexpr auto n = std::uint32_t{1} << 20;
+        auto edges = EdgeList{};
+        auto weight = std::vector<int>{};
+        auto random = Lcg{42};
+        for (auto i = 0; i != 1 << 23; ++i) {
+            const auto u = random() % n;
+            edges.emplace_back(u, random() % n);
+            weight.push_back(static_cast<int>(random() % 255 + 1));
+        }
+        return py::CsrGraph<int>(n, edges, weight);
+    }();
+    return gra;
+}
+
+// The same graph with weights in sixtieths
+static auto fraction_graph() -> const py::CsrGraph<Fraction>& {
+    static const auto gra = [] {
+        const auto& base = random_graph();
+        auto weight = std::vector<Fraction>{};
+        for (const auto w : base.edge_properties()) {
+            weight.emplace_back(w, 60);
+        }
+        const auto offsets = base.row_offsets();
+        const auto targets = base.column_indices();
+        return py::CsrGraph<Fraction>(std::vector<std::size_t>(offsets.begin(), offsets.end()),
+                                      std::vector<std::uint32_t>(targets.begin(), targets.end()),
+                                      std::move(weight));
+    }();
+    return gra;
+}
+
+static void BM_bgl_dijkstra(benchmark::State& state) {
+    const auto& gra = random_graph();
+    auto dist = std::vector<int>(num_vertices(gra));
+    auto pred = std::vector<std::uint32_t>(num_vertices(gra));
+    const auto weight = boost::make_iterator_property_map(gra.edge_properties().begin(),
+                                                          get(boost::edge_index, gra));
+    for (auto _ : state) {
+        boost::dijkstra_shortest_paths(
+            gra, 0,
+            boost::weight_map(weight).distance_map(dist.data()).predecessor_map(pred.data()));
+        benchmark::DoNotOptimize(dist.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(num_edges(gra)));
+}
+
+static void BM_radix_heap_dijkstra(benchmark::State& state) {
+    const auto& gra = random_graph();
+    for (auto _ : state) {
+        auto sp = py::single_source_dijkstra(gra, 0);
+        benchmark::DoNotOptimize(sp.distance.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(num_edges(gra)));
+}
+
+static void BM_delta_stepping(benchmark::State& state) {
+    const auto& gra = random_graph();
+    py::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        auto sp = py::single_source_dijkstra(pool, gra, 0, 32);
+        benchmark::DoNotOptimize(sp.distance.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(num_edges(gra)));
+}
+
+static void BM_fraction_dijkstra(benchmark::State& state) {
+    const auto& gra = fraction_graph();
+    for (auto _ : state) {
+        auto sp = py::single_source_dijkstra(gra, 0);
+        benchmark::DoNotOptimize(sp.distance.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(num_edges(gra)));
+}
+
+static void BM_fraction_delta_stepping(benchmark::State& state) {
+    const auto& gra = fraction_graph();
+    py::ThreadPool pool{static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        auto sp = py::single_source_dijkstra(pool, gra, 0, Fraction(32, 60));
+        benchmark::DoNotOptimize(sp.distance.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(num_edges(gra)));
+}
+
+BENCHMARK(BM_bgl_dijkstra)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_radix_heap_dijkstra)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_delta_stepping)->ArgName("threads")->Arg(1)->Arg(4)->Arg(8)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_fraction_dijkstra)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_fraction_delta_stepping)->ArgName("threads")->Arg(1)->Arg(8)->Unit(
+    benchmark::kMillisecond);
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/subgraph.hpp>
+#include <utility>
+#include <vector>
+
+#include "random_graph.hpp"
+
+using Index = boost::property<boost::edge_index_t, std::size_t>;
+using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                    boost::no_property, Index>;
+
+constexpr auto num_nodes = std::size_t{1} << 18;
+
+// Random directed graph: 2^18 vertices, 2^21 edges, with a "weight" column
+static auto random_graph() -> const py::GrAdaptor<Graph>& {
+    static const auto gra = [] {
+        auto G = py::GrAdaptor<Graph>(Graph(num_nodes));
+        auto edges = std::vector<std::pair<std::size_t, std::size_t>>{};
+        auto random = Lcg{42};
+        for (auto i = 0; i != 1 << 21; ++i) {
+            edges.emplace_back(random(num_nodes), random(num_nodes));
+        }
+        G.add_edges_from(edges);
+        auto weight = G.edge_data().add_column<double>("weight");
+        for (auto i = std::size_t{0}; i != weight.size(); ++i) {
+            weight[i] = 1.0 + static_cast<double>(i % 7);
+        }
+        return G;
+    }();
+    return gra;
+}
+
+// Every third vertex is left out
+static auto kept_nodes() -> std::vector<std::size_t> {
+    auto nodes = std::vector<std::size_t>{};
+    for (auto v = std::size_t{0}; v != num_nodes; ++v) {
+        if (v % 3 != 0) nodes.push_back(v);
+    }
+    return nodes;
+}
+
+// Total weight of the out-edges of every node, `rounds` times
+template <typename View> static auto sweep(const View& H, int rounds) -> double {
+    const auto weight = H.edge_data().template column<double>("weight");
+    auto total = 0.0;
+    for (auto r = 0; r != rounds; ++r) {
+        for (const auto v : H) {
+            for (const auto& e : H.neighbors(v)) total += weight[H.edge_id(e)];
+        }
+    }
+    return total;
+}
+
+// Baseline: copy the induced subgraph into a new adjacency_list
+static void BM_copy_subgraph(benchmark::State& state) {
+    const auto& G = random_graph();
+    const auto nodes = kept_nodes();
+    for (auto _ : state) {
+        auto keep = std::vector<char>(num_nodes);
+        for (const auto v : nodes) keep[v] = 1;
+        auto H = py::GrAdaptor<Graph>(Graph(num_nodes));
+        auto edges = std::vector<std::pair<std::size_t, std::size_t>>{};
+        auto old_edge = std::vector<std::size_t>{};
+        for (const auto& e : G.edges()) {
+            if (keep[G.source(e)] != 0 && keep[G.target(e)] != 0) {
+                edges.emplace_back(G.source(e), G.target(e));
+                old_edge.push_back(G.edge_id(e));
+            }
+        }
+        H.add_edges_from(edges);
+        H.edge_data() = G.edge_data().take(old_edge);
+        benchmark::DoNotOptimize(sweep(H, static_cast<int>(state.range(0))));
+    }
+}
+
+static void BM_subgraph_view(benchmark::State& state) {
+    const auto& G = random_graph();
+    const auto nodes = kept_nodes();
+    for (auto _ : state) {
+        const auto H = py::subgraph(G, nodes);
+        benchmark::DoNotOptimize(sweep(H, static_cast<int>(state.range(0))));
+    }
+}
+
+static void BM_subgraph_compact(benchmark::State& state) {
+    const auto& G = random_graph();
+    const auto nodes = kept_nodes();
+    for (auto _ : state) {
+        const auto compact = py::subgraph(G, nodes).compact();
+        benchmark::DoNotOptimize(sweep(compact.graph, static_cast<int>(state.range(0))));
+    }
+}
+
+BENCHMARK(BM_copy_subgraph)->ArgName("sweeps")->Arg(1)->Arg(10)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_subgraph_view)->ArgName("sweeps")->Arg(1)->Arg(10)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_subgraph_compact)->ArgName("sweeps")->Arg(1)->Arg(10)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,59 @@
+/**
+ * @file random_graph.hpp
+ * @brief Deterministic random inputs shared by the graph benchmarks
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// 64-bit linear congruential generator (Knuth's MMIX constants)
+class Lcg {
+    std::uint64_t _state;
+
+    auto step() noexcept -> std::uint64_t {
+        return _state = _state * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+
+  public:
+    explicit Lcg(std::uint64_t seed) noexcept : _state{seed} {}
+
+    /// Next 31-bit value (the high bits, which are the well-mixed ones)
+    auto operator()() noexcept -> std::uint32_t { return static_cast<std::uint32_t>(step() >> 33); }
+
+    /// Next value in [0, bound)
+    auto operator()(std::uint64_t bound) noexcept -> std::uint32_t {
+        return static_cast<std::uint32_t>((*this)() % bound);
+    }
+
+    /// Next double in [0, 1) with 53 random bits
+    auto uniform() noexcept -> double { return static_cast<double>(step() >> 11) * 0x1.0p-53; }
+};
+
+/**
+ * @brief R-MAT edge list (a=0.57, b=c=0.19, d=0.05) on 2^scale vertices
+ *
+ * Each edge descends `scale` levels of the adjacency matrix, picking a
+ * quadrant per level, which gives the skewed degrees of real-world graphs.
+ * Self-loops and duplicates are kept; one direction of each edge is listed.
+ */
+inline auto rmat_edges(int scale, std::size_t edges, std::uint64_t seed)
+    -> std::vector<std::pair<std::uint32_t, std::uint32_t>> {
+    auto random = Lcg{seed};
+    auto result = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+    result.reserve(edges);
+    for (auto i = std::size_t{0}; i != edges; ++i) {
+        auto u = std::uint32_t{0};
+        auto v = std::uint32_t{0};
+        for (auto bit = 0; bit != scale; ++bit) {
+            const auto r = random.uniform();
+            u = u << 1 | static_cast<std::uint32_t>(r >= 0.76);
+            v = v << 1 | static_cast<std::uint32_t>((r >= 0.57 && r < 0.76) || r >= 0.95);
+        }
+        result.emplace_back(u, v);
+    }
+    return result;
+}
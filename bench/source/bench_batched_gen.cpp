@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <py2cpp/batched_gen.hpp>
+#include <py2cpp/gen.hpp>
+
+static py::Generator<int> plain_iota(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+
+static py::BatchedGenerator<int, 256> batched_iota(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+
+static void BM_Generator_per_element(benchmark::State& state) {
+    const auto n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        auto sum = std::int64_t{0};
+        for (auto val : plain_iota(n)) {
+            sum += val;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BatchedGenerator_per_element(benchmark::State& state) {
+    const auto n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        auto sum = std::int64_t{0};
+        for (auto val : batched_iota(n)) {
+            sum += val;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BatchedGenerator_batches(benchmark::State& state) {
+    const auto n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        auto sum = std::int64_t{0};
+        auto gen = batched_iota(n);
+        for (auto batch : gen.batches()) {
+            for (auto val : batch) {
+                sum += val;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Generator_per_element)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_BatchedGenerator_per_element)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_BatchedGenerator_batches)->Arg(1 << 10)->Arg(1 << 16);
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <py2cpp/gen.hpp>
+
+// See FrameAllocated: GCC misreports the allocator-aware frames below, and the
+// frames freed through the replaced operator delete once it is inlined.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// Count every trip through the global heap so that the benchmarks can report
+// allocations per generator next to the latency.
+static std::atomic<std::size_t> heap_allocs{0};
+
+void* operator new(std::size_t size) {
+    heap_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+static py::Generator<int> pooled_iota(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+
+// Frames routed through std::allocator reproduce the plain new/delete behaviour
+// that Generator had before frame pooling.
+static py::Generator<int> heap_iota(std::allocator_arg_t, std::allocator<std::byte>, int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+
+static py::Generator<int> arena_iota(std::allocator_arg_t, std::pmr::polymorphic_allocator<>,
+                                     int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#    pragma GCC diagnostic pop
+#endif
+
+template <typename Make> static void run_short_generators(benchmark::State& state, Make make) {
+    const auto len = static_cast<int>(state.range(0));
+    const auto before = heap_allocs.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        auto sum = 0;
+        for (auto val : make(len)) {
+            sum += val;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    const auto allocs = heap_allocs.load(std::memory_order_relaxed) - before;
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocs),
+                                                  benchmark::Counter::kAvgIterations);
+}
+
+static void BM_Generator_heap(benchmark::State& state) {
+    run_short_generators(state, [](int n) {
+        return heap_iota(std::allocator_arg, std::allocator<std::byte>{}, n);
+    });
+}
+
+static void BM_Generator_pooled(benchmark::State& state) {
+    run_short_generators(state, [](int n) { return pooled_iota(n); });
+}
+
+static void BM_Generator_arena(benchmark::State& state) {
+    std::array<std::byte, 1 << 16> buffer{};
+    std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size()};
+    auto created = 0;
+    run_short_generators(state, [&](int n) {
+        if (++created % 64 == 0) {
+            arena.release();
+        }
+        return arena_iota(std::allocator_arg, &arena, n);
+    });
+}
+
+BENCHMARK(BM_Generator_heap)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(BM_Generator_pooled)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(BM_Generator_arena)->Arg(1)->Arg(8)->Arg(64);
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <py2cpp/recursive_gen.hpp>
+#include <utility>
+#include <vector>
+
+// Implicit complete tree: every node above `depth` has `fanout` children and
+// yields its level in pre-order.
+
+static py::RecursiveGenerator<int> walk(int level, int depth, int fanout) {
+    co_yield level;
+    if (level < depth) {
+        for (int i = 0; i < fanout; ++i) {
+            co_yield walk(level + 1, depth, fanout);
+        }
+    }
+}
+
+static auto tree_size(std::int64_t depth, std::int64_t fanout) -> std::int64_t {
+    auto total = std::int64_t{0};
+    auto width = std::int64_t{1};
+    for (auto level = std::int64_t{0}; level <= depth; ++level) {
+        total += width;
+        width *= fanout;
+    }
+    return total;
+}
+
+static void BM_RecursiveGenerator(benchmark::State& state) {
+    const auto depth = static_cast<int>(state.range(0));
+    const auto fanout = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        auto sum = std::int64_t{0};
+        for (auto val : walk(0, depth, fanout)) {
+            sum += val;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * tree_size(depth, fanout));
+}
+
+static void BM_ExplicitStack(benchmark::State& state) {
+    const auto depth = static_cast<int>(state.range(0));
+    const auto fanout = static_cast<int>(state.range(1));
+    auto stack = std::vector<std::pair<int, int>>{};  // (level, children left)
+    for (auto _ : state) {
+        auto sum = std::int64_t{0};
+        stack.clear();
+        stack.emplace_back(0, depth > 0 ? fanout : 0);
+        while (!stack.empty()) {
+            auto& [level, left] = stack.back();
+            if (left == 0) {
+                stack.pop_back();
+                continue;
+            }
+            --left;
+            const auto child = level + 1;
+            sum += child;
+            stack.emplace_back(child, child < depth ? fanout : 0);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * tree_size(depth, fanout));
+}
+
+// (depth, fanout): chains up to 1e6 deep, then bushier trees of ~1e5 nodes
+static void tree_shapes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"depth", "fanout"});
+    for (auto depth : {10, 1000, 100000, 1000000}) {
+        bench->Args({depth, 1});
+    }
+    for (auto [depth, fanout] : {std::pair{10, 2}, {16, 2}, {8, 4}, {5, 8}, {4, 16}, {3, 64}}) {
+        bench->Args({depth, fanout});
+    }
+}
+
+BENCHMARK(BM_RecursiveGenerator)->Apply(tree_shapes);
+BENCHMARK(BM_ExplicitStack)->Apply(tree_shapes);
@@ -0,0 +1,186 @@
+/**
+ * @file async_gen.hpp
+ * @brief Asynchronous C++20 coroutine generator (Python async generator)
+ *
+ * Provides an AsyncGenerator template whose coroutine may both `co_await`
+ * (e.g. a Task, py::sleep() or I/O readiness) and `co_yield` values. The
+ * consumer iterates it from inside another coroutine by awaiting begin()
+ * and operator++ of the iterator.
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "frame_alloc.hpp"
+
+namespace py {
+
+    /**
+     * @brief Generator that may suspend on awaitables between yields.
+     *
+     * Mirrors Python's `async def ... yield`. Iteration is written as
+     *
+     * @code
+     * for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) {
+     *     use(*it);
+     * }
+     * @endcode
+     *
+     * Each `co_await` on begin() or `++it` resumes the producer until its
+     * next `co_yield` (or its end), using symmetric transfer in both
+     * directions. While the producer waits on something else, the consumer
+     * stays suspended and the event loop is free to run other coroutines.
+     *
+     * Yielded values are passed by pointer, like Generator<T>. An exception
+     * escaping the producer is rethrown from the awaited begin() / `++it`.
+     *
+     * @tparam T Value type to yield
+     */
+    template <typename T> class [[nodiscard]] AsyncGenerator {
+      public:
+        struct promise_type : FrameAllocated {
+            using value_type = std::remove_reference_t<T>;
+
+            value_type* m_value{};
+            std::exception_ptr m_exception{};
+            std::coroutine_handle<> m_consumer{};
+
+            struct transfer_awaiter {
+                bool await_ready() const noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(
+                    std::coroutine_handle<promise_type> coro) const noexcept {
+                    return coro.promise().m_consumer;
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            auto get_return_object() noexcept {
+                return AsyncGenerator{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            transfer_awaiter final_suspend() noexcept { return {}; }
+
+            transfer_awaiter yield_value(value_type& value) noexcept {
+                m_value = std::addressof(value);
+                return {};
+            }
+
+            transfer_awaiter yield_value(value_type&& value) noexcept {
+                m_value = std::addressof(value);
+                return {};
+            }
+
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { m_exception = std::current_exception(); }
+
+            void throw_if_exception() {
+                if (m_exception != nullptr) {
+                    std::rethrow_exception(std::exchange(m_exception, nullptr));
+                }
+            }
+        };
+
+      private:
+        using handle_type = std::coroutine_handle<promise_type>;
+        handle_type coro_{};
+
+        explicit AsyncGenerator(handle_type coro) noexcept : coro_(coro) {}
+
+      public:
+        AsyncGenerator() noexcept = default;
+        ~AsyncGenerator() {
+            if (coro_) coro_.destroy();
+        }
+
+        AsyncGenerator(AsyncGenerator&& other) noexcept : coro_(std::exchange(other.coro_, {})) {}
+        AsyncGenerator& operator=(AsyncGenerator&& other) noexcept {
+            if (this != &other) {
+                if (coro_) coro_.destroy();
+                coro_ = std::exchange(other.coro_, {});
+            }
+            return *this;
+        }
+
+        AsyncGenerator(const AsyncGenerator&) = delete;
+        AsyncGenerator& operator=(const AsyncGenerator&) = delete;
+
+        class iterator;
+
+        /**
+         * @brief Awaitable that resumes the producer up to its next yield
+         */
+        template <typename Result> class advance_awaiter {
+            handle_type coro_;
+            Result* result_;
+
+          public:
+            advance_awaiter(handle_type coro, Result* result) noexcept
+                : coro_(coro), result_(result) {}
+
+            bool await_ready() const noexcept { return !coro_ || coro_.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept {
+                coro_.promise().m_consumer = consumer;
+                return coro_;
+            }
+
+            auto await_resume() -> Result& {
+                if (coro_ && coro_.done()) {
+                    *result_ = Result{};
+                    coro_.promise().throw_if_exception();
+                }
+                return *result_;
+            }
+        };
+
+        class iterator {
+            handle_type coro_{};
+
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::remove_reference_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<std::is_reference_v<T>, T, T&>;
+            using pointer = std::add_pointer_t<value_type>;
+
+            iterator() noexcept = default;
+            explicit iterator(handle_type coro) noexcept : coro_(coro) {}
+
+            /**
+             * @brief Advance; must be awaited (`co_await ++it`)
+             */
+            auto operator++() noexcept { return advance_awaiter<iterator>{coro_, this}; }
+
+            reference operator*() const noexcept {
+                return static_cast<reference>(*coro_.promise().m_value);
+            }
+
+            pointer operator->() const noexcept { return std::addressof(operator*()); }
+
+            bool operator==(const iterator& other) const noexcept { return coro_ == other.coro_; }
+            bool operator!=(const iterator& other) const noexcept { return !(*this == other); }
+        };
+
+        /**
+         * @brief Start iteration; must be awaited (`co_await gen.begin()`)
+         */
+        auto begin() noexcept {
+            this->first_ = iterator{coro_};
+            return advance_awaiter<iterator>{coro_, &this->first_};
+        }
+
+        iterator end() noexcept { return iterator{}; }
+
+      private:
+        iterator first_{};
+    };
+
+}  // namespace py
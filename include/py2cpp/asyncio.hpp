@@ -0,0 +1,568 @@
+/**
+ * @file asyncio.hpp
+ * @brief Single-threaded epoll event loop for Task and AsyncGenerator
+ *
+ * Provides an asyncio-style EventLoop together with py::run(), py::gather(),
+ * py::sleep() and file descriptor readiness awaitables, so that one thread
+ * can multiplex many concurrent coroutine streams over pipes, sockets and
+ * files without blocking.
+ *
+ * Linux only (epoll).
+ */
+
+#pragma once
+
+#if !defined(__linux__)
+#    error "py2cpp/asyncio.hpp requires Linux (epoll)"
+#endif
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "task.hpp"
+
+namespace py {
+
+    /**
+     * @brief Single-threaded event loop driving coroutines.
+     *
+     * The loop owns a FIFO of ready coroutines, a min-heap of timers and an
+     * epoll instance watching file descriptors. Each iteration waits in
+     * `epoll_wait` (without blocking if anything is ready) until the next
+     * timer expires or a watched descriptor becomes ready, then resumes all
+     * ready coroutines.
+     *
+     * While run_until_complete() executes, the loop is reachable from the
+     * running coroutines through EventLoop::current().
+     */
+    class EventLoop {
+      public:
+        using clock = std::chrono::steady_clock;
+
+        EventLoop() : _epfd{::epoll_create1(EPOLL_CLOEXEC)} {
+            if (this->_epfd < 0) {
+                throw std::system_error(errno, std::generic_category(), "epoll_create1");
+            }
+        }
+
+        ~EventLoop() { ::close(this->_epfd); }
+
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+
+        /**
+         * @brief The loop running on the calling thread
+         *
+         * @return EventLoop& The running loop
+         * @throw std::runtime_error if no loop is running
+         */
+        static auto current() -> EventLoop& {
+            if (running() == nullptr) {
+                throw std::runtime_error("no running event loop");
+            }
+            return *running();
+        }
+
+        /**
+         * @brief Resume a coroutine on the next loop iteration
+         *
+         * @param[in] coro Coroutine to resume
+         */
+        void schedule(std::coroutine_handle<> coro) { this->_ready.push_back(coro); }
+
+        /**
+         * @brief Resume a coroutine once `deadline` has passed
+         *
+         * @param[in] deadline Point in time to wait for
+         * @param[in] coro Coroutine to resume
+         */
+        void call_at(clock::time_point deadline, std::coroutine_handle<> coro) {
+            this->_timers.push(Timer{deadline, this->_timer_seq++, coro});
+        }
+
+        /**
+         * @brief Resume a coroutine when `fd` becomes readable
+         *
+         * Descriptors that epoll cannot watch (regular files) are always
+         * considered ready.
+         *
+         * @param[in] fd File descriptor
+         * @param[in] coro Coroutine to resume
+         */
+        void add_reader(int fd, std::coroutine_handle<> coro) { this->watch(fd, coro, true); }
+
+        /**
+         * @brief Resume a coroutine when `fd` becomes writable
+         *
+         * @param[in] fd File descriptor
+         * @param[in] coro Coroutine to resume
+         */
+        void add_writer(int fd, std::coroutine_handle<> coro) { this->watch(fd, coro, false); }
+
+        /**
+         * @brief Run the loop until `task` has completed
+         *
+         * @tparam T Result type of the task
+         * @param[in] task The task to run
+         * @return T The task's result (its exception is rethrown)
+         * @throw std::runtime_error if the task can never complete
+         */
+        template <typename T> auto run_until_complete(Task<T>& task) -> T {
+            auto* const previous = std::exchange(running(), this);
+            struct restore {
+                EventLoop* loop;
+                ~restore() { running() = loop; }
+            } guard{previous};
+
+            if (!task.done()) {
+                this->schedule(task.handle());
+            }
+            while (!task.done()) {
+                this->run_once();
+            }
+            return task.result();
+        }
+
+      private:
+        struct Timer {
+            clock::time_point deadline;
+            std::uint64_t seq;
+            std::coroutine_handle<> coro;
+
+            bool operator>(const Timer& other) const noexcept {
+                return std::tie(deadline, seq) > std::tie(other.deadline, other.seq);
+            }
+        };
+
+        struct Watch {
+            std::coroutine_handle<> reader{};
+            std::coroutine_handle<> writer{};
+            std::uint32_t events{};
+        };
+
+        static auto running() noexcept -> EventLoop*& {
+            thread_local EventLoop* loop = nullptr;
+            return loop;
+        }
+
+        void watch(int fd, std::coroutine_handle<> coro, bool reading) {
+            auto& entry = this->_watches[fd];
+            auto& slot = reading ? entry.reader : entry.writer;
+            if (slot) {
+                throw std::logic_error("another coroutine is already waiting on this descriptor");
+            }
+            slot = coro;
+            if (!this->update(fd, entry)) {
+                // epoll refuses regular files: they never block, so resume right away
+                slot = {};
+                this->_watches.erase(fd);
+                this->schedule(coro);
+            }
+        }
+
+        auto update(int fd, Watch& entry) -> bool {
+            std::uint32_t events = 0;
+            if (entry.reader) events |= EPOLLIN;
+            if (entry.writer) events |= EPOLLOUT;
+            if (events == entry.events) return true;
+
+            auto ev = epoll_event{};
+            ev.events = events;
+            ev.data.fd = fd;
+            const auto op = entry.events == 0 ? EPOLL_CTL_ADD
+                            : events == 0     ? EPOLL_CTL_DEL
+                                              : EPOLL_CTL_MOD;
+            if (::epoll_ctl(this->_epfd, op, fd, &ev) < 0) {
+                if (errno == EPERM) return false;
+                throw std::system_error(errno, std::generic_category(), "epoll_ctl");
+            }
+            entry.events = events;
+            return true;
+        }
+
+        auto timeout_ms() const -> int {
+            if (!this->_ready.empty()) return 0;
+            if (this->_timers.empty()) {
+                if (this->_watches.empty()) {
+                    throw std::runtime_error("event loop has nothing left to wait for");
+                }
+                return -1;
+            }
+            const auto wait = this->_timers.top().deadline - clock::now();
+            if (wait <= clock::duration::zero()) return 0;
+            const auto ms = std::chrono::ceil<std::chrono::milliseconds>(wait).count();
+            return static_cast<int>(std::min<decltype(ms)>(ms, 1 << 30));
+        }
+
+        void run_once() {
+            const auto timeout = this->timeout_ms();
+            epoll_event events[64];
+            const auto n = ::epoll_wait(this->_epfd, events, 64, timeout);
+            if (n < 0 && errno != EINTR) {
+                throw std::system_error(errno, std::generic_category(), "epoll_wait");
+            }
+            for (auto i = 0; i < n; ++i) {
+                const auto fd = events[i].data.fd;
+                auto found = this->_watches.find(fd);
+                if (found == this->_watches.end()) continue;
+                auto& entry = found->second;
+                const auto ev = events[i].events;
+                const auto failed = (ev & (EPOLLERR | EPOLLHUP)) != 0;
+                if (entry.reader && ((ev & EPOLLIN) != 0 || failed)) {
+                    this->schedule(std::exchange(entry.reader, {}));
+                }
+                if (entry.writer && ((ev & EPOLLOUT) != 0 || failed)) {
+                    this->schedule(std::exchange(entry.writer, {}));
+                }
+                this->update(fd, entry);
+                if (entry.events == 0) this->_watches.erase(found);
+            }
+
+            const auto now = clock::now();
+            while (!this->_timers.empty() && this->_timers.top().deadline <= now) {
+                this->schedule(this->_timers.top().coro);
+                this->_timers.pop();
+            }
+
+            for (auto count = this->_ready.size(); count != 0; --count) {
+                auto coro = this->_ready.front();
+                this->_ready.pop_front();
+                coro.resume();
+            }
+        }
+
+        int _epfd;
+        std::deque<std::coroutine_handle<>> _ready{};
+        std::priority_queue<Timer, std::vector<Timer>, std::greater<>> _timers{};
+        std::uint64_t _timer_seq{0};
+        std::unordered_map<int, Watch> _watches{};
+    };
+
+    /**
+     * @brief Run a task on a fresh event loop and return its result
+     *
+     * Python's `asyncio.run(main())`.
+     *
+     * @tparam T Result type
+     * @param[in] task The task to run
+     * @return T The task's result
+     */
+    template <typename T> auto run(Task<T> task) -> T {
+        auto loop = EventLoop{};
+        return loop.run_until_complete(task);
+    }
+
+    /**
+     * @brief Suspend the calling coroutine for (at least) `duration`
+     *
+     * A zero or negative duration just yields to the other ready coroutines.
+     *
+     * @param[in] duration Time to sleep
+     * @return Awaitable
+     */
+    template <typename Rep, typename Period>
+    auto sleep(std::chrono::duration<Rep, Period> duration) noexcept {
+        struct awaiter {
+            EventLoop::clock::duration m_duration;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> coro) const {
+                auto& loop = EventLoop::current();
+                if (m_duration <= EventLoop::clock::duration::zero()) {
+                    loop.schedule(coro);
+                } else {
+                    loop.call_at(EventLoop::clock::now() + m_duration, coro);
+                }
+            }
+
+            void await_resume() const noexcept {}
+        };
+        return awaiter{std::chrono::duration_cast<EventLoop::clock::duration>(duration)};
+    }
+
+    /**
+     * @brief Suspend until `fd` is readable (or has hung up / failed)
+     *
+     * @param[in] fd File descriptor
+     * @return Awaitable
+     */
+    inline auto wait_readable(int fd) noexcept {
+        struct awaiter {
+            int m_fd;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> coro) const {
+                EventLoop::current().add_reader(m_fd, coro);
+            }
+            void await_resume() const noexcept {}
+        };
+        return awaiter{fd};
+    }
+
+    /**
+     * @brief Suspend until `fd` is writable (or has hung up / failed)
+     *
+     * @param[in] fd File descriptor
+     * @return Awaitable
+     */
+    inline auto wait_writable(int fd) noexcept {
+        struct awaiter {
+            int m_fd;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> coro) const {
+                EventLoop::current().add_writer(m_fd, coro);
+            }
+            void await_resume() const noexcept {}
+        };
+        return awaiter{fd};
+    }
+
+    /**
+     * @brief Put a file descriptor into non-blocking mode
+     *
+     * @param[in] fd File descriptor
+     * @throw std::system_error on failure
+     */
+    inline void set_nonblocking(int fd) {
+        const auto flags = ::fcntl(fd, F_GETFL);
+        if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+            throw std::system_error(errno, std::generic_category(), "fcntl");
+        }
+    }
+
+    /**
+     * @brief Read up to `buffer.size()` bytes without blocking the thread
+     *
+     * `fd` should be in non-blocking mode (see set_nonblocking()).
+     *
+     * @param[in] fd File descriptor
+     * @param[out] buffer Destination
+     * @return Task<std::size_t> Number of bytes read, 0 at end of file
+     */
+    inline auto async_read(int fd, std::span<std::byte> buffer) -> Task<std::size_t> {
+        for (;;) {
+            const auto n = ::read(fd, buffer.data(), buffer.size());
+            if (n >= 0) co_return static_cast<std::size_t>(n);
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                co_await wait_readable(fd);
+            } else if (errno != EINTR) {
+                throw std::system_error(errno, std::generic_category(), "read");
+            }
+        }
+    }
+
+    /**
+     * @brief Write all of `data` without blocking the thread
+     *
+     * `fd` should be in non-blocking mode (see set_nonblocking()).
+     *
+     * @param[in] fd File descriptor
+     * @param[in] data Bytes to write
+     * @return Task<std::size_t> Number of bytes written (always `data.size()`)
+     */
+    inline auto async_write(int fd, std::span<const std::byte> data) -> Task<std::size_t> {
+        auto done = std::size_t{0};
+        while (done < data.size()) {
+            const auto n = ::write(fd, data.data() + done, data.size() - done);
+            if (n >= 0) {
+                done += static_cast<std::size_t>(n);
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                co_await wait_writable(fd);
+            } else if (errno != EINTR) {
+                throw std::system_error(errno, std::generic_category(), "write");
+            }
+        }
+        co_return done;
+    }
+
+    namespace detail {
+
+        struct JoinCounter {
+            std::size_t remaining;
+            std::coroutine_handle<> waiter;
+        };
+
+        /**
+         * @brief Helper coroutine awaiting one task on behalf of gather()
+         *
+         * When the last of a group finishes it transfers control to the
+         * coroutine waiting in gather().
+         */
+        class JoinTask {
+          public:
+            struct promise_type : FrameAllocated {
+                JoinCounter* m_counter{};
+
+                auto get_return_object() noexcept {
+                    return JoinTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+
+                std::suspend_always initial_suspend() noexcept { return {}; }
+
+                auto final_suspend() noexcept {
+                    struct final_awaiter {
+                        bool await_ready() const noexcept { return false; }
+
+                        std::coroutine_handle<> await_suspend(
+                            std::coroutine_handle<promise_type> coro) const noexcept {
+                            auto* counter = coro.promise().m_counter;
+                            if (--counter->remaining == 0) return counter->waiter;
+                            return std::noop_coroutine();
+                        }
+
+                        void await_resume() const noexcept {}
+                    };
+                    return final_awaiter{};
+                }
+
+                void return_void() noexcept {}
+                void unhandled_exception() noexcept {}
+            };
+
+            JoinTask(JoinTask&& other) noexcept : coro_(std::exchange(other.coro_, {})) {}
+            JoinTask(const JoinTask&) = delete;
+            JoinTask& operator=(const JoinTask&) = delete;
+            JoinTask& operator=(JoinTask&&) = delete;
+
+            ~JoinTask() {
+                if (coro_) coro_.destroy();
+            }
+
+            void start(JoinCounter& counter, EventLoop& loop) {
+                coro_.promise().m_counter = &counter;
+                loop.schedule(coro_);
+            }
+
+          private:
+            explicit JoinTask(std::coroutine_handle<promise_type> coro) noexcept : coro_(coro) {}
+
+            std::coroutine_handle<promise_type> coro_;
+        };
+
+        /**
+         * @brief Awaitable that runs a task to completion without taking its result
+         *
+         * The result (or exception) stays in the task for gather() to collect.
+         */
+        template <typename T> struct TaskDone {
+            typename Task<T>::handle_type m_coro;
+
+            bool await_ready() const noexcept { return !m_coro || m_coro.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                m_coro.promise().m_continuation = awaiting;
+                return m_coro;
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        template <typename T> auto join_one(Task<T>& task) -> JoinTask {
+            co_await TaskDone<T>{task.handle()};
+        }
+
+        /**
+         * @brief Awaitable that starts all joins and resumes when they are done
+         */
+        struct JoinAll {
+            std::vector<JoinTask>& m_joins;
+            JoinCounter m_counter;
+
+            bool await_ready() const noexcept { return m_counter.remaining == 0; }
+
+            void await_suspend(std::coroutine_handle<> coro) {
+                m_counter.waiter = coro;
+                auto& loop = EventLoop::current();
+                for (auto& join : m_joins) {
+                    join.start(m_counter, loop);
+                }
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        template <typename T>
+        using gather_value_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        template <typename T> auto gather_result(Task<T>& task) -> gather_value_t<T> {
+            if constexpr (std::is_void_v<T>) {
+                task.result();
+                return {};
+            } else {
+                return task.result();
+            }
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Run tasks concurrently and collect their results in order
+     *
+     * Python's `asyncio.gather(*tasks)`. All tasks are started on the
+     * running loop; the first stored exception (in argument order) is
+     * rethrown once every task has finished.
+     *
+     * @tparam T Result type of the tasks
+     * @param[in] tasks Tasks to run
+     * @return Task<std::vector<T>> (Task<void> for void tasks)
+     */
+    template <typename T> auto gather(std::vector<Task<T>> tasks)
+        -> Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> {
+        auto joins = std::vector<detail::JoinTask>{};
+        joins.reserve(tasks.size());
+        for (auto& task : tasks) {
+            joins.push_back(detail::join_one(task));
+        }
+        co_await detail::JoinAll{joins, detail::JoinCounter{joins.size(), {}}};
+
+        if constexpr (std::is_void_v<T>) {
+            for (auto& task : tasks) {
+                task.result();
+            }
+        } else {
+            auto results = std::vector<T>{};
+            results.reserve(tasks.size());
+            for (auto& task : tasks) {
+                results.push_back(task.result());
+            }
+            co_return results;
+        }
+    }
+
+    /**
+     * @overload
+     *
+     * Heterogeneous form; results of void tasks become std::monostate.
+     */
+    template <typename... Ts> auto gather(Task<Ts>... tasks)
+        -> Task<std::tuple<detail::gather_value_t<Ts>...>> {
+        auto joins = std::vector<detail::JoinTask>{};
+        joins.reserve(sizeof...(Ts));
+        (joins.push_back(detail::join_one(tasks)), ...);
+        co_await detail::JoinAll{joins, detail::JoinCounter{joins.size(), {}}};
+        co_return std::tuple<detail::gather_value_t<Ts>...>{detail::gather_result(tasks)...};
+    }
+
+}  // namespace py
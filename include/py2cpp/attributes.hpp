@@ -0,0 +1,233 @@
+/**
+ * @file attributes.hpp
+ * @brief Named, typed attribute columns indexed by dense ids
+ *
+ * Provides AttributeTable, a structure of arrays in which every attribute
+ * (e.g. "weight" or "cost") is a contiguous std::vector indexed by vertex
+ * or edge id. It replaces side dictionaries keyed by descriptor: a single
+ * value is one indexed load, and an algorithm can take a whole column as a
+ * std::span. GrAdaptor keeps one table for its nodes and one for its edges.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace py {
+
+    /**
+     * @brief Columns of attributes for the ids `0 .. size()-1`
+     *
+     * All columns have size() entries; resize() grows or shrinks them all,
+     * filling new entries with the column's fill value.
+     */
+    class AttributeTable {
+        struct ColumnBase {
+            virtual ~ColumnBase() = default;
+            virtual void resize(std::size_t size) = 0;
+            [[nodiscard]] virtual auto type() const noexcept -> const std::type_info& = 0;
+            [[nodiscard]] virtual auto clone() const -> std::unique_ptr<ColumnBase> = 0;
+            [[nodiscard]] virtual auto take(std::span<const std::size_t> rows) const
+                -> std::unique_ptr<ColumnBase> = 0;
+        };
+
+        template <typename T> struct Column final : ColumnBase {
+            std::vector<T> data;
+            T fill;
+
+            Column(std::size_t size, T fill_) : data(size, fill_), fill(std::move(fill_)) {}
+            void resize(std::size_t size) override { this->data.resize(size, this->fill); }
+            [[nodiscard]] auto type() const noexcept -> const std::type_info& override {
+                return typeid(T);
+            }
+            [[nodiscard]] auto clone() const -> std::unique_ptr<ColumnBase> override {
+                return std::make_unique<Column>(*this);
+            }
+            [[nodiscard]] auto take(std::span<const std::size_t> rows) const
+                -> std::unique_ptr<ColumnBase> override {
+                auto result = std::make_unique<Column>(0, this->fill);
+                result->data.reserve(rows.size());
+                for (const auto row : rows) {
+                    result->data.push_back(this->data[row]);
+                }
+                return result;
+            }
+        };
+
+        std::size_t _size{0};
+        std::map<std::string, std::unique_ptr<ColumnBase>, std::less<>> _columns{};
+
+        template <typename T> auto find(std::string_view name) const -> Column<T>& {
+            const auto it = this->_columns.find(name);
+            if (it == this->_columns.end()) {
+                throw std::out_of_range("no attribute named '" + std::string(name) + "'");
+            }
+            if (it->second->type() != typeid(T)) {
+                throw std::invalid_argument("attribute '" + std::string(name)
+                                            + "' has another type");
+            }
+            return static_cast<Column<T>&>(*it->second);
+        }
+
+      public:
+        /**
+         * @brief Construct a table for `size` ids, without columns
+         */
+        explicit AttributeTable(std::size_t size = 0) : _size{size} {}
+
+        AttributeTable(const AttributeTable& other) : _size{other._size} {
+            for (const auto& [name, column] : other._columns) {
+                this->_columns.emplace(name, column->clone());
+            }
+        }
+
+        AttributeTable& operator=(const AttributeTable& other) {
+            if (this != &other) *this = AttributeTable(other);
+            return *this;
+        }
+
+        AttributeTable(AttributeTable&&) noexcept = default;
+        AttributeTable& operator=(AttributeTable&&) noexcept = default;
+        ~AttributeTable() = default;
+
+        /**
+         * @brief Number of ids (entries per column)
+         */
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return this->_size; }
+
+        /**
+         * @brief Change the number of ids of every column
+         */
+        void resize(std::size_t size) {
+            for (auto& [name, column] : this->_columns) {
+                column->resize(size);
+            }
+            this->_size = size;
+        }
+
+        /**
+         * @brief New table whose row `i` is row `rows[i]` of this one
+         *
+         * Every column is gathered, so a permutation of `0 .. size()-1`
+         * renumbers the ids and a subset of them selects rows.
+         *
+         * @param[in] rows Row of this table for every row of the result
+         * @return AttributeTable A table with `rows.size()` ids
+         * @throw std::out_of_range if a row is not below size()
+         */
+        [[nodiscard]] auto take(std::span<const std::size_t> rows) const -> AttributeTable {
+            for (const auto row : rows) {
+                if (row >= this->_size) throw std::out_of_range("row is not in the table");
+            }
+            auto result = AttributeTable{rows.size()};
+            for (const auto& [name, column] : this->_columns) {
+                result._columns.emplace(name, column->take(rows));
+            }
+            return result;
+        }
+
+        /**
+         * @brief Add a column whose entries all start as `fill`
+         *
+         * Adding an existing column of the same type keeps its values.
+         *
+         * @tparam T Value type (not bool, whose vector has no contiguous storage)
+         * @param[in] name Attribute name
+         * @param[in] fill Initial value, also used when the table grows
+         * @return std::span<T> The column
+         * @throw std::invalid_argument if a column `name` of another type exists
+         */
+        template <typename T> auto add_column(std::string_view name, T fill = T{})
+            -> std::span<T> {
+            static_assert(!std::is_same_v<T, bool>, "use char or std::uint8_t for flags");
+            if (!this->contains(name)) {
+                this->_columns.emplace(std::string(name),
+                                       std::make_unique<Column<T>>(this->_size, std::move(fill)));
+            }
+            return this->find<T>(name).data;
+        }
+
+        /**
+         * @brief Whether a column `name` exists
+         */
+        [[nodiscard]] auto contains(std::string_view name) const -> bool {
+            return this->_columns.find(name) != this->_columns.end();
+        }
+
+        /**
+         * @brief Remove the column `name`, if any
+         */
+        void erase(std::string_view name) {
+            if (const auto it = this->_columns.find(name); it != this->_columns.end()) {
+                this->_columns.erase(it);
+            }
+        }
+
+        /**
+         * @brief Names of all columns, in sorted order
+         */
+        [[nodiscard]] auto names() const -> std::vector<std::string> {
+            auto result = std::vector<std::string>{};
+            result.reserve(this->_columns.size());
+            for (const auto& [name, column] : this->_columns) {
+                result.push_back(name);
+            }
+            return result;
+        }
+
+        /**
+         * @brief The column `name` as a contiguous span
+         *
+         * @throw std::out_of_range if there is no such column
+         * @throw std::invalid_argument if the column has another type
+         */
+        template <typename T> auto column(std::string_view name) -> std::span<T> {
+            return this->find<T>(name).data;
+        }
+
+        template <typename T> auto column(std::string_view name) const -> std::span<const T> {
+            return this->find<T>(name).data;
+        }
+
+        /**
+         * @brief Attribute `name` of id `id`, as in NetworkX `G.nodes[n][name]`
+         *
+         * @throw std::out_of_range if there is no such column or id
+         * @throw std::invalid_argument if the column has another type
+         */
+        template <typename T> auto at(std::size_t id, std::string_view name) -> T& {
+            return this->find<T>(name).data.at(id);
+        }
+
+        template <typename T> auto at(std::size_t id, std::string_view name) const -> const T& {
+            return this->find<T>(name).data.at(id);
+        }
+    };
+
+    namespace detail {
+
+        // Rows of `table` (padded to `size` ids first if it is shorter, as
+        // when vertices or edges were added to a graph without going through
+        // its GrAdaptor)
+        inline auto take_rows(const AttributeTable& table, std::size_t size,
+                              std::span<const std::size_t> rows) -> AttributeTable {
+            if (table.size() == size) return table.take(rows);
+            auto padded = table;
+            padded.resize(size);
+            return padded.take(rows);
+        }
+
+    }  // namespace detail
+
+}  // namespace py
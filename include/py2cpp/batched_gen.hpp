@@ -0,0 +1,238 @@
+/**
+ * @file batched_gen.hpp
+ * @brief Buffered C++20 coroutine generator that resumes once per batch
+ *
+ * Provides a BatchedGenerator template whose coroutine yields into a
+ * fixed-size buffer held in the promise. The producer only suspends when
+ * the buffer is full, so the resume/suspend cost is paid once per N
+ * elements instead of once per element.
+ */
+
+#pragma once
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "frame_alloc.hpp"
+
+namespace py {
+
+    /**
+     * @brief Generator that hands out its values in batches of up to N.
+     *
+     * Written exactly like a Generator<T> coroutine, but every `co_yield`
+     * copies (or moves) the value into an internal buffer of N elements.
+     * Control only returns to the consumer when the buffer is full or the
+     * coroutine finishes.
+     *
+     * Two ways of consuming the values are offered:
+     *
+     * - begin()/end() iterate element by element, like Generator<T>;
+     * - batches() iterates over `std::span<const T>` views of each filled
+     *   buffer, so that the consumer can run a tight (vectorizable) loop
+     *   over every batch.
+     *
+     * An exception escaping the coroutine body is rethrown to the consumer
+     * after the values buffered before it.
+     *
+     * @tparam T Value type to yield (must be default constructible)
+     * @tparam N Number of elements per batch
+     */
+    template <typename T, std::size_t N = 256> class BatchedGenerator {
+        static_assert(!std::is_reference_v<T>, "BatchedGenerator stores its values by copy");
+        static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+        static_assert(N > 0, "batch size must be positive");
+
+      public:
+        struct promise_type : FrameAllocated {
+            std::array<T, N> m_buffer{};
+            std::size_t m_size{};
+
+            std::exception_ptr m_exception{};
+
+            struct flush_awaiter {
+                bool m_ready;
+
+                bool await_ready() const noexcept { return this->m_ready; }
+                void await_suspend(std::coroutine_handle<>) const noexcept {}
+                void await_resume() const noexcept {}
+            };
+
+            template <typename U = T> auto yield_value(U&& value) noexcept(
+                std::is_nothrow_assignable_v<T&, U&&>) -> flush_awaiter {
+                this->m_buffer[this->m_size++] = std::forward<U>(value);
+                return flush_awaiter{this->m_size < N};
+            }
+
+            auto initial_suspend() noexcept { return std::suspend_always{}; }
+            auto final_suspend() noexcept { return std::suspend_always{}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { m_exception = std::current_exception(); }
+
+            void throw_if_exception() {
+                if (m_exception != nullptr) {
+                    std::rethrow_exception(std::exchange(m_exception, nullptr));
+                }
+            }
+
+            auto get_return_object() noexcept {
+                return BatchedGenerator{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+        };
+
+      private:
+        using handle_type = std::coroutine_handle<promise_type>;
+        handle_type coro_{};
+
+        explicit BatchedGenerator(handle_type coro) noexcept : coro_(coro) {}
+
+        /**
+         * @brief Run the producer until the next batch is ready
+         *
+         * An exception raised by the producer is rethrown once the values
+         * buffered before it have been handed out.
+         *
+         * @return std::size_t Number of values in the new batch (0 when exhausted)
+         */
+        static auto refill(handle_type coro) -> std::size_t {
+            if (!coro) return 0;
+            auto& promise = coro.promise();
+            promise.m_size = 0;
+            if (!coro.done()) coro.resume();
+            if (promise.m_size == 0) promise.throw_if_exception();
+            return promise.m_size;
+        }
+
+      public:
+        using batch_type = std::span<const T>;
+
+        BatchedGenerator() noexcept = default;
+        ~BatchedGenerator() {
+            if (coro_) coro_.destroy();
+        }
+
+        BatchedGenerator(BatchedGenerator&& other) noexcept
+            : coro_(std::exchange(other.coro_, {})) {}
+        BatchedGenerator& operator=(BatchedGenerator&& other) noexcept {
+            if (this != &other) {
+                if (coro_) coro_.destroy();
+                coro_ = std::exchange(other.coro_, {});
+            }
+            return *this;
+        }
+
+        BatchedGenerator(const BatchedGenerator&) = delete;
+        BatchedGenerator& operator=(const BatchedGenerator&) = delete;
+
+        /**
+         * @brief Per-element input iterator
+         */
+        class iterator {
+            handle_type coro_{};
+            std::size_t idx_{};
+
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = const T&;
+            using pointer = const T*;
+
+            iterator() noexcept = default;
+            explicit iterator(handle_type coro) noexcept : coro_(coro) {}
+
+            iterator& operator++() {
+                if (++idx_ == coro_.promise().m_size) {
+                    idx_ = 0;
+                    if (refill(coro_) == 0) coro_ = {};
+                }
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+
+            reference operator*() const noexcept { return coro_.promise().m_buffer[idx_]; }
+
+            pointer operator->() const noexcept { return std::addressof(operator*()); }
+
+            bool operator==(const iterator& other) const noexcept {
+                return coro_ == other.coro_ && idx_ == other.idx_;
+            }
+            bool operator!=(const iterator& other) const noexcept { return !(*this == other); }
+        };
+
+        /**
+         * @brief Input iterator over whole batches
+         */
+        class batch_iterator {
+            handle_type coro_{};
+
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = batch_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = batch_type;
+            using pointer = void;
+
+            batch_iterator() noexcept = default;
+            explicit batch_iterator(handle_type coro) noexcept : coro_(coro) {}
+
+            batch_iterator& operator++() {
+                if (refill(coro_) == 0) coro_ = {};
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+
+            reference operator*() const noexcept {
+                const auto& promise = coro_.promise();
+                return batch_type{promise.m_buffer.data(), promise.m_size};
+            }
+
+            bool operator==(const batch_iterator& other) const noexcept {
+                return coro_ == other.coro_;
+            }
+            bool operator!=(const batch_iterator& other) const noexcept {
+                return !(*this == other);
+            }
+        };
+
+        /**
+         * @brief Range of batches, see BatchedGenerator::batches()
+         */
+        class batch_range {
+            handle_type coro_{};
+
+          public:
+            explicit batch_range(handle_type coro) noexcept : coro_(coro) {}
+
+            batch_iterator begin() {
+                if (refill(coro_) == 0) return batch_iterator{};
+                return batch_iterator{coro_};
+            }
+            batch_iterator end() noexcept { return batch_iterator{}; }
+        };
+
+        iterator begin() {
+            if (refill(coro_) == 0) return iterator{};
+            return iterator{coro_};
+        }
+
+        iterator end() noexcept { return iterator{}; }
+
+        /**
+         * @brief View the generator as a range of `std::span<const T>` batches
+         *
+         * Each span stays valid until the iterator is advanced. All batches
+         * hold N values except possibly the last one.
+         *
+         * @return batch_range Input range of batches
+         */
+        batch_range batches() noexcept { return batch_range{coro_}; }
+    };
+
+}  // namespace py
@@ -0,0 +1,414 @@
+/**
+ * @file bfs.hpp
+ * @brief Parallel direction-optimizing breadth-first search
+ *
+ * Provides ParallelBfs together with the NetworkX-style py::bfs_layers()
+ * and py::bfs_edges(). Every level of the search runs on a ThreadPool and
+ * picks one of two directions (Beamer, Asanović and Patterson, 2012):
+ *
+ * - top-down: the frontier vertices claim their unvisited out-neighbours;
+ * - bottom-up: every unvisited vertex looks for an in-neighbour in the
+ *   frontier, which is kept as a bitmap, and stops at the first one.
+ *
+ * Bottom-up wins when the frontier is a large part of the graph, because
+ * most unvisited vertices find a parent after a few edges. The search
+ * switches to bottom-up when the frontier has more than 1/alpha of the
+ * unexplored edges and back when it has fewer than 1/beta of the vertices.
+ *
+ * ParallelBfs::distances() runs many searches at once, 64 sources per
+ * sweep, with one bit per source in every vertex (multi-source BFS).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+namespace py {
+
+    /**
+     * @brief Reusable parallel BFS over a fixed graph
+     *
+     * The graph is read as CSR arrays: a CsrGraph with the same vertex type
+     * is used in place, any other BGL graph is converted with to_csr() once.
+     * The in-edges needed by the bottom-up steps are the out-edges of a
+     * `symmetric` graph (an undirected graph stored in both directions) and
+     * otherwise a transposed copy built by the constructor. The work arrays
+     * are kept between searches, so one instance should serve many of them;
+     * an instance must not run two searches at the same time.
+     *
+     * @tparam Vertex Unsigned integral vertex type
+     */
+    template <typename Vertex = std::uint32_t> class ParallelBfs {
+        static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+
+      public:
+        using Csr = CsrGraph<boost::no_property, Vertex>;
+
+        /// Distance of a vertex that cannot be reached
+        static constexpr auto unreached = std::numeric_limits<std::uint32_t>::max();
+
+        /// Switch to bottom-up when frontier edges exceed unexplored edges / alpha
+        std::size_t alpha{15};
+        /// Switch back to top-down when frontier vertices drop below n / beta
+        std::size_t beta{18};
+
+        /**
+         * @brief Prepare searches over `gra`
+         *
+         * @param[in] pool Pool running the searches (must outlive this object)
+         * @param[in] gra The graph; vertices must be `0 .. n-1`
+         * @param[in] symmetric Whether every edge `(u, v)` has a reverse edge `(v, u)`
+         */
+        template <typename Graph>
+        ParallelBfs(ThreadPool& pool, const Graph& gra, bool symmetric = false) : _pool{pool} {
+            if constexpr (requires {
+                              { gra.row_offsets() } -> std::same_as<std::span<const std::size_t>>;
+                              { gra.column_indices() } -> std::same_as<std::span<const Vertex>>;
+                          }) {
+                this->_out_offsets = gra.row_offsets();
+                this->_out_targets = gra.column_indices();
+            } else {
+                this->_own_out = to_csr<Vertex>(gra);
+                this->_out_offsets = this->_own_out.row_offsets();
+                this->_out_targets = this->_own_out.column_indices();
+            }
+            this->_n = this->_out_offsets.size() - 1;
+            if (symmetric) {
+                this->_in_offsets = this->_out_offsets;
+                this->_in_targets = this->_out_targets;
+            } else {
+                this->transpose();
+            }
+            this->_parent = std::vector<std::atomic<Vertex>>(this->_n);
+            this->_bits.assign(this->_n / 64 + 1, 0);
+        }
+
+        /**
+         * @brief Number of vertices
+         */
+        [[nodiscard]] auto num_vertices() const noexcept -> std::size_t { return this->_n; }
+
+        /**
+         * @brief The null vertex (parent of unreached vertices)
+         */
+        static auto null_vertex() noexcept -> Vertex { return std::numeric_limits<Vertex>::max(); }
+
+        /**
+         * @brief BFS tree from `sources`
+         *
+         * @return std::vector<Vertex> The parent of every vertex: some vertex
+         *         one level closer to the sources, the vertex itself for a
+         *         source and null_vertex() if unreached
+         */
+        auto parents(std::span<const Vertex> sources) -> std::vector<Vertex> {
+            this->search(sources, [](const std::vector<Vertex>&) {});
+            auto result = std::vector<Vertex>(this->_n);
+            parallel_for(this->_pool, this->_n, this->chunks(this->_n),
+                         [&](std::size_t, std::size_t lo, std::size_t hi) {
+                             for (auto v = lo; v != hi; ++v) {
+                                 result[v] = this->_parent[v].load(std::memory_order_relaxed);
+                             }
+                         });
+            return result;
+        }
+
+        /**
+         * @brief Vertices grouped by their distance from `sources`
+         *
+         * Layer 0 holds the (distinct) sources. Layers found bottom-up are
+         * sorted; the order within a top-down layer is unspecified.
+         */
+        auto layers(std::span<const Vertex> sources) -> std::vector<std::vector<Vertex>> {
+            auto result = std::vector<std::vector<Vertex>>{};
+            this->search(sources, [&result](const std::vector<Vertex>& layer) {
+                result.push_back(layer);
+            });
+            return result;
+        }
+
+        /**
+         * @brief Edges of a BFS tree from `source`, layer by layer
+         *
+         * @return std::vector<std::pair<Vertex, Vertex>> `(parent, child)` pairs
+         */
+        auto edges(Vertex source) -> std::vector<std::pair<Vertex, Vertex>> {
+            auto result = std::vector<std::pair<Vertex, Vertex>>{};
+            auto first = true;
+            this->search(std::span<const Vertex>{&source, 1},
+                         [&](const std::vector<Vertex>& layer) {
+                             if (std::exchange(first, false)) return;
+                             for (const auto v : layer) {
+                                 result.emplace_back(
+                                     this->_parent[v].load(std::memory_order_relaxed), v);
+                             }
+                         });
+            return result;
+        }
+
+        /**
+         * @brief Distances from each source separately (batched multi-source BFS)
+         *
+         * Sources are processed 64 at a time: each vertex keeps one bit per
+         * source of the batch, and one pull sweep over the in-edges advances
+         * all 64 searches by a level.
+         *
+         * @return std::vector<std::vector<std::uint32_t>> `result[k][v]`, the
+         *         distance from `sources[k]` to `v` (or `unreached`)
+         * @throw std::out_of_range if a source is not a vertex of the graph
+         */
+        auto distances(std::span<const Vertex> sources)
+            -> std::vector<std::vector<std::uint32_t>> {
+            const auto n = this->_n;
+            for (const auto s : sources) {
+                if (static_cast<std::size_t>(s) >= n) {
+                    throw std::out_of_range("BFS source is not a vertex of the graph");
+                }
+            }
+            auto result = std::vector<std::vector<std::uint32_t>>(sources.size());
+            auto seen = std::vector<std::uint64_t>(n);
+            auto visit = std::vector<std::uint64_t>(n);
+            auto next = std::vector<std::uint64_t>(n);
+            for (auto base = std::size_t{0}; base < sources.size(); base += 64) {
+                const auto batch = std::min(std::size_t{64}, sources.size() - base);
+                const auto full = batch == 64 ? ~std::uint64_t{0}
+                                              : (std::uint64_t{1} << batch) - 1;
+                std::fill(seen.begin(), seen.end(), 0);
+                std::fill(visit.begin(), visit.end(), 0);
+                for (auto k = std::size_t{0}; k != batch; ++k) {
+                    const auto s = static_cast<std::size_t>(sources[base + k]);
+                    result[base + k].assign(n, unreached);
+                    result[base + k][s] = 0;
+                    seen[s] |= std::uint64_t{1} << k;
+                    visit[s] |= std::uint64_t{1} << k;
+                }
+                auto active = std::atomic<bool>{true};
+                for (auto level = std::uint32_t{1}; active.load(); ++level) {
+                    active.store(false);
+                    parallel_for(
+                        this->_pool, n, this->chunks(n),
+                        [&](std::size_t, std::size_t lo, std::size_t hi) {
+                            auto any = false;
+                            for (auto v = lo; v != hi; ++v) {
+                                next[v] = 0;
+                                if (seen[v] == full) continue;
+                                auto found = std::uint64_t{0};
+                                for (auto i = this->_in_offsets[v]; i != this->_in_offsets[v + 1];
+                                     ++i) {
+                                    found |= visit[this->_in_targets[i]];
+                                }
+                                found &= ~seen[v];
+                                if (found == 0) continue;
+                                next[v] = found;
+                                seen[v] |= found;
+                                any = true;
+                                for (; found != 0; found &= found - 1) {
+                                    const auto k = std::countr_zero(found);
+                                    result[base + static_cast<std::size_t>(k)][v] = level;
+                                }
+                            }
+                            if (any) active.store(true, std::memory_order_relaxed);
+                        });
+                    std::swap(visit, next);
+                }
+            }
+            return result;
+        }
+
+      private:
+        auto chunks(std::size_t count) const -> std::size_t {
+            return std::min(4 * (this->_pool.size() + 1), count / 1024 + 1);
+        }
+
+        auto out_degree(std::size_t v) const -> std::size_t {
+            return this->_out_offsets[v + 1] - this->_out_offsets[v];
+        }
+
+        void transpose() {
+            const auto n = this->_n;
+            auto reversed = std::vector<std::pair<Vertex, Vertex>>(this->_out_targets.size());
+            parallel_for(this->_pool, n, this->chunks(n),
+                         [&](std::size_t, std::size_t lo, std::size_t hi) {
+                             for (auto u = lo; u != hi; ++u) {
+                                 for (auto i = this->_out_offsets[u];
+                                      i != this->_out_offsets[u + 1]; ++i) {
+                                     reversed[i] = {this->_out_targets[i], static_cast<Vertex>(u)};
+                                 }
+                             }
+                         });
+            this->_own_in = Csr(this->_pool, n, reversed);
+            this->_in_offsets = this->_own_in.row_offsets();
+            this->_in_targets = this->_own_in.column_indices();
+        }
+
+        // Run a search, calling on_layer(layer) for every layer from 0 on
+        template <typename OnLayer>
+        void search(std::span<const Vertex> sources, OnLayer&& on_layer) {
+            const auto n = this->_n;
+            parallel_for(this->_pool, n, this->chunks(n),
+                         [&](std::size_t, std::size_t lo, std::size_t hi) {
+                             for (auto v = lo; v != hi; ++v) {
+                                 this->_parent[v].store(null_vertex(), std::memory_order_relaxed);
+                             }
+                         });
+            auto frontier = std::vector<Vertex>{};
+            auto frontier_edges = std::size_t{0};
+            for (const auto s : sources) {
+                if (static_cast<std::size_t>(s) >= n) {
+                    throw std::out_of_range("BFS source is not a vertex of the graph");
+                }
+                if (this->_parent[s].exchange(s, std::memory_order_relaxed) == null_vertex()) {
+                    frontier.push_back(s);
+                    frontier_edges += this->out_degree(s);
+                }
+            }
+            auto unexplored = this->_out_targets.size() - frontier_edges;
+            auto bottom_up = false;
+            while (!frontier.empty()) {
+                on_layer(frontier);
+                if (!bottom_up) {
+                    bottom_up = frontier_edges > unexplored / this->alpha;
+                } else {
+                    bottom_up = frontier.size() >= n / this->beta;
+                }
+                frontier = bottom_up ? this->bottom_up_step(frontier, frontier_edges)
+                                     : this->top_down_step(frontier, frontier_edges);
+                unexplored -= std::min(unexplored, frontier_edges);
+            }
+        }
+
+        auto top_down_step(const std::vector<Vertex>& frontier, std::size_t& next_edges)
+            -> std::vector<Vertex> {
+            const auto num_chunks = this->chunks(frontier.size());
+            auto found = std::vector<std::vector<Vertex>>(num_chunks);
+            auto edges = std::vector<std::size_t>(num_chunks);
+            parallel_for(this->_pool, frontier.size(), num_chunks,
+                         [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                             for (auto i = lo; i != hi; ++i) {
+                                 const auto u = frontier[i];
+                                 for (auto j = this->_out_offsets[u];
+                                      j != this->_out_offsets[std::size_t{u} + 1]; ++j) {
+                                     const auto v = this->_out_targets[j];
+                                     auto& parent = this->_parent[v];
+                                     auto expected = null_vertex();
+                                     if (parent.load(std::memory_order_relaxed) == expected
+                                         && parent.compare_exchange_strong(
+                                             expected, u, std::memory_order_relaxed)) {
+                                         found[c].push_back(v);
+                                         edges[c] += this->out_degree(v);
+                                     }
+                                 }
+                             }
+                         });
+            return this->gather(found, edges, next_edges);
+        }
+
+        auto bottom_up_step(const std::vector<Vertex>& frontier, std::size_t& next_edges)
+            -> std::vector<Vertex> {
+            for (const auto u : frontier) {
+                this->_bits[u / 64] |= std::uint64_t{1} << (u % 64);
+            }
+            const auto words = this->_bits.size();
+            const auto num_chunks = this->chunks(this->_n);
+            auto found = std::vector<std::vector<Vertex>>(num_chunks);
+            auto edges = std::vector<std::size_t>(num_chunks);
+            parallel_for(
+                this->_pool, words, num_chunks, [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                    const auto last = std::min(hi * 64, this->_n);
+                    for (auto v = lo * 64; v < last; ++v) {
+                        if (this->_parent[v].load(std::memory_order_relaxed) != null_vertex()) {
+                            continue;
+                        }
+                        for (auto j = this->_in_offsets[v]; j != this->_in_offsets[v + 1]; ++j) {
+                            const auto w = this->_in_targets[j];
+                            if ((this->_bits[w / 64] >> (w % 64) & 1U) != 0) {
+                                this->_parent[v].store(w, std::memory_order_relaxed);
+                                found[c].push_back(static_cast<Vertex>(v));
+                                edges[c] += this->out_degree(v);
+                                break;
+                            }
+                        }
+                    }
+                });
+            for (const auto u : frontier) {
+                this->_bits[u / 64] = 0;
+            }
+            return this->gather(found, edges, next_edges);
+        }
+
+        static auto gather(std::vector<std::vector<Vertex>>& found,
+                           const std::vector<std::size_t>& edges, std::size_t& next_edges)
+            -> std::vector<Vertex> {
+            auto total = std::size_t{0};
+            next_edges = 0;
+            for (auto c = std::size_t{0}; c != found.size(); ++c) {
+                total += found[c].size();
+                next_edges += edges[c];
+            }
+            if (found.size() == 1) return std::move(found.front());
+            auto result = std::vector<Vertex>{};
+            result.reserve(total);
+            for (const auto& part : found) {
+                result.insert(result.end(), part.begin(), part.end());
+            }
+            return result;
+        }
+
+        ThreadPool& _pool;
+        std::size_t _n{0};
+        Csr _own_out{};
+        Csr _own_in{};
+        std::span<const std::size_t> _out_offsets{};
+        std::span<const Vertex> _out_targets{};
+        std::span<const std::size_t> _in_offsets{};
+        std::span<const Vertex> _in_targets{};
+        std::vector<std::atomic<Vertex>> _parent{};
+        std::vector<std::uint64_t> _bits{};  // frontier of a bottom-up step
+    };
+
+    /**
+     * @brief BFS layers from `sources`, as in NetworkX `bfs_layers(G, sources)`
+     *
+     * @param[in] pool Pool running the search
+     * @param[in] gra The graph (vertices `0 .. n-1`)
+     * @param[in] sources Start vertices (layer 0)
+     * @param[in] symmetric Whether every edge has its reverse (an undirected graph)
+     * @return Layers of vertices, see ParallelBfs::layers()
+     */
+    template <typename Graph, typename Vertex =
+                                  typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto bfs_layers(ThreadPool& pool, const Graph& gra, const std::vector<Vertex>& sources,
+                    bool symmetric = false) -> std::vector<std::vector<Vertex>> {
+        return ParallelBfs<Vertex>(pool, gra, symmetric).layers(sources);
+    }
+
+    /**
+     * @brief Edges of a BFS tree, as in NetworkX `bfs_edges(G, source)`
+     *
+     * @param[in] pool Pool running the search
+     * @param[in] gra The graph (vertices `0 .. n-1`)
+     * @param[in] source Start vertex
+     * @param[in] symmetric Whether every edge has its reverse (an undirected graph)
+     * @return `(parent, child)` pairs, layer by layer
+     */
+    template <typename Graph, typename Vertex =
+                                  typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto bfs_edges(ThreadPool& pool, const Graph& gra, Vertex source, bool symmetric = false)
+        -> std::vector<std::pair<Vertex, Vertex>> {
+        return ParallelBfs<Vertex>(pool, gra, symmetric).edges(source);
+    }
+
+}  // namespace py
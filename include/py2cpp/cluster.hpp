@@ -0,0 +1,388 @@
+/**
+ * @file cluster.hpp
+ * @brief Triangles, clustering coefficients and common neighbours
+ *
+ * Provides the NetworkX-style py::triangles(), py::clustering() and
+ * py::common_neighbors(), all built on intersections of sorted neighbour
+ * arrays. Two arrays of similar length are merged block by block, four
+ * vertices against four with SSE2 compares when the vertices are 32-bit;
+ * a short array is searched in a much longer one by galloping instead.
+ *
+ * Triangles are counted once each on the degree-ordered orientation of the
+ * graph, in which every edge points from the endpoint of smaller degree to
+ * the one of larger degree (ties broken by vertex). A triangle is then
+ * found from its lowest vertex only, and no vertex has more than
+ * `sqrt(2m)` out-neighbours, so a few hubs cannot dominate the work.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/pending/property.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+#if defined(__SSE2__)
+#    include <emmintrin.h>
+#endif
+
+namespace py {
+
+    namespace detail {
+
+        /// Use galloping when one array is this many times longer than the other
+        constexpr auto gallop_ratio = std::size_t{32};
+
+        // Merge two sorted arrays, calling emit(w) for every common w in order
+        template <typename Vertex, typename Emit>
+        void merge_intersect(std::span<const Vertex> a, std::span<const Vertex> b, Emit&& emit) {
+            auto i = std::size_t{0};
+            auto j = std::size_t{0};
+#if defined(__SSE2__)
+            if constexpr (sizeof(Vertex) == 4) {
+                // Compare a block of `a` with the four rotations of a block of `b`,
+                // then move on past the block with the smaller last vertex
+                while (i + 4 <= a.size() && j + 4 <= b.size()) {
+                    const auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&a[i]));
+                    auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b[j]));
+                    auto eq = _mm_cmpeq_epi32(va, vb);
+                    vb = _mm_shuffle_epi32(vb, 0x39);
+                    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+                    vb = _mm_shuffle_epi32(vb, 0x39);
+                    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+                    vb = _mm_shuffle_epi32(vb, 0x39);
+                    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+                    for (auto mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+                         mask != 0; mask &= mask - 1) {
+                        emit(a[i + static_cast<std::size_t>(std::countr_zero(mask))]);
+                    }
+                    const auto a_last = a[i + 3];
+                    const auto b_last = b[j + 3];
+                    if (a_last <= b_last) i += 4;
+                    if (b_last <= a_last) j += 4;
+                }
+            }
+#endif
+            while (i != a.size() && j != b.size()) {
+                if (a[i] < b[j]) {
+                    ++i;
+                } else if (b[j] < a[i]) {
+                    ++j;
+                } else {
+                    emit(a[i]);
+                    ++i;
+                    ++j;
+                }
+            }
+        }
+
+        // Look up every vertex of the short array `a` in the long array `b`
+        template <typename Vertex, typename Emit>
+        void gallop_intersect(std::span<const Vertex> a, std::span<const Vertex> b, Emit&& emit) {
+            auto lo = std::size_t{0};
+            for (const auto w : a) {
+                // Double the step until b[hi] >= w, then search the last step
+                auto hi = lo;
+                for (auto step = std::size_t{1}; hi < b.size() && b[hi] < w; step *= 2) {
+                    lo = hi + 1;
+                    hi += step;
+                }
+                hi = std::min(hi, b.size());
+                lo = static_cast<std::size_t>(
+                    std::lower_bound(b.data() + lo, b.data() + hi, w) - b.data());
+                if (lo == b.size()) return;
+                if (b[lo] == w) {
+                    emit(w);
+                    ++lo;
+                }
+            }
+        }
+
+        /**
+         * @brief Call `emit(w)` for every vertex `w` of both sorted arrays, in increasing order
+         *
+         * The arrays must be strictly increasing.
+         */
+        template <typename Vertex, typename Emit>
+        void intersect(std::span<const Vertex> a, std::span<const Vertex> b, Emit&& emit) {
+            if (b.size() < a.size()) std::swap(a, b);
+            if (a.size() * gallop_ratio < b.size()) {
+                gallop_intersect(a, b, emit);
+            } else {
+                merge_intersect(a, b, emit);
+            }
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Sorted neighbour arrays of a graph, for triangle and neighbourhood queries
+     *
+     * The graph is read as simple and undirected, as NetworkX's
+     * `G.to_undirected()`: an edge in either direction makes two vertices
+     * neighbours, and self-loops and parallel edges are dropped.
+     *
+     * @code
+     * auto index = py::NeighborIndex<>(pool, gra);
+     * auto coefficient = index.clustering();
+     * auto both = index.common_neighbors(0, 1);
+     * @endcode
+     *
+     * @tparam Vertex Unsigned integral vertex type
+     */
+    template <typename Vertex = std::uint32_t> class NeighborIndex {
+        static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+
+      public:
+        using Csr = CsrGraph<boost::no_property, Vertex>;
+
+        /**
+         * @brief Build the neighbour arrays of `gra`
+         *
+         * @param[in] pool Pool running the construction and the queries (must outlive this)
+         * @param[in] gra The graph; vertices must be `0 .. n-1`
+         */
+        template <typename Graph> NeighborIndex(ThreadPool& pool, const Graph& gra) : _pool{pool} {
+            auto own = Csr{};
+            const auto [offsets, targets] = detail::csr_arrays<Vertex>(gra, own);
+            const auto n = offsets.size() - 1;
+            auto pairs = std::vector<std::pair<Vertex, Vertex>>{};
+            pairs.reserve(2 * targets.size());
+            for (auto u = std::size_t{0}; u != n; ++u) {
+                for (auto i = offsets[u]; i != offsets[u + 1]; ++i) {
+                    const auto v = targets[i];
+                    if (static_cast<std::size_t>(v) == u) continue;
+                    pairs.emplace_back(static_cast<Vertex>(u), v);
+                    pairs.emplace_back(v, static_cast<Vertex>(u));
+                }
+            }
+            const auto both = Csr(pool, n, pairs);
+            pairs = {};
+
+            // Sort every row and drop the repeats
+            const auto rows = both.row_offsets();
+            auto sorted = std::vector<Vertex>(both.column_indices().begin(),
+                                              both.column_indices().end());
+            auto degree = std::vector<std::size_t>(n);
+            this->for_vertices(n, [&](std::size_t v) {
+                const auto first = sorted.begin() + static_cast<std::ptrdiff_t>(rows[v]);
+                const auto last = sorted.begin() + static_cast<std::ptrdiff_t>(rows[v + 1]);
+                std::sort(first, last);
+                degree[v] = static_cast<std::size_t>(std::unique(first, last) - first);
+            });
+            this->_adj = this->compact(rows, sorted, degree, [](Vertex, Vertex) { return true; });
+
+            // Keep the edges from the lower to the higher endpoint in (degree, vertex) order
+            const auto lower = [&degree](Vertex u, Vertex v) {
+                return degree[u] < degree[v] || (degree[u] == degree[v] && u < v);
+            };
+            const auto adj_rows = this->_adj.row_offsets();
+            const auto adj = this->_adj.column_indices();
+            auto up_degree = std::vector<std::size_t>(n);
+            this->for_vertices(n, [&](std::size_t u) {
+                auto count = std::size_t{0};
+                for (auto i = adj_rows[u]; i != adj_rows[u + 1]; ++i) {
+                    count += static_cast<std::size_t>(lower(static_cast<Vertex>(u), adj[i]));
+                }
+                up_degree[u] = count;
+            });
+            this->_up = this->compact(adj_rows, adj, up_degree, lower);
+        }
+
+        /**
+         * @brief Number of vertices
+         */
+        [[nodiscard]] auto num_vertices() const noexcept -> std::size_t {
+            return this->_adj.row_offsets().size() - 1;
+        }
+
+        /**
+         * @brief The neighbours of `v`, in increasing order
+         */
+        [[nodiscard]] auto neighbors(Vertex v) const -> std::span<const Vertex> {
+            this->check(v);
+            const auto rows = this->_adj.row_offsets();
+            return this->_adj.column_indices().subspan(rows[v], rows[v + 1] - rows[v]);
+        }
+
+        /**
+         * @brief Number of neighbours of `v`
+         */
+        [[nodiscard]] auto degree(Vertex v) const -> std::size_t {
+            return this->neighbors(v).size();
+        }
+
+        /**
+         * @brief The vertices adjacent to both `u` and `v`, in increasing order
+         *
+         * @throw std::out_of_range if `u` or `v` is not a vertex
+         */
+        [[nodiscard]] auto common_neighbors(Vertex u, Vertex v) const -> std::vector<Vertex> {
+            auto result = std::vector<Vertex>{};
+            detail::intersect(this->neighbors(u), this->neighbors(v),
+                              [&result](Vertex w) { result.push_back(w); });
+            return result;
+        }
+
+        /**
+         * @brief Number of triangles through every vertex, as in NetworkX `nx.triangles(G)`
+         */
+        [[nodiscard]] auto triangles() const -> std::vector<std::size_t> {
+            const auto n = this->num_vertices();
+            const auto rows = this->_up.row_offsets();
+            const auto up = this->_up.column_indices();
+            const auto out = [&](Vertex v) {
+                return up.subspan(rows[v], rows[v + 1] - rows[v]);
+            };
+            auto count = std::vector<std::size_t>(n);
+            const auto add = [&count](Vertex v, std::size_t k) {
+                std::atomic_ref<std::size_t>(count[v]).fetch_add(k, std::memory_order_relaxed);
+            };
+            // Every triangle u < v < w (in the orientation) is found once, from u
+            const auto chunks = std::min(16 * (this->_pool.size() + 1), n / 256 + 1);
+            parallel_for(this->_pool, n, chunks, [&](std::size_t, std::size_t lo, std::size_t hi) {
+                for (auto u = static_cast<Vertex>(lo); u != hi; ++u) {
+                    auto at_u = std::size_t{0};
+                    for (const auto v : out(u)) {
+                        auto at_v = std::size_t{0};
+                        detail::intersect(out(u), out(v), [&](Vertex w) {
+                            ++at_v;
+                            add(w, 1);
+                        });
+                        if (at_v != 0) add(v, at_v);
+                        at_u += at_v;
+                    }
+                    if (at_u != 0) add(u, at_u);
+                }
+            });
+            return count;
+        }
+
+        /**
+         * @brief Clustering coefficient of every vertex, as in NetworkX `nx.clustering(G)`
+         *
+         * The fraction of the pairs of neighbours of a vertex that are
+         * adjacent themselves, or 0 with fewer than two neighbours.
+         */
+        [[nodiscard]] auto clustering() const -> std::vector<double> {
+            const auto count = this->triangles();
+            auto result = std::vector<double>(count.size());
+            for (auto v = std::size_t{0}; v != count.size(); ++v) {
+                const auto d = static_cast<double>(this->degree(static_cast<Vertex>(v)));
+                result[v] = d < 2.0 ? 0.0 : 2.0 * static_cast<double>(count[v]) / (d * (d - 1.0));
+            }
+            return result;
+        }
+
+      private:
+        template <typename Body> void for_vertices(std::size_t n, Body&& body) const {
+            const auto chunks = std::min(4 * (this->_pool.size() + 1), n / 1024 + 1);
+            parallel_for(this->_pool, n, chunks, [&](std::size_t, std::size_t lo, std::size_t hi) {
+                for (auto v = lo; v != hi; ++v) body(v);
+            });
+        }
+
+        // The first `size[u]` entries of every row that satisfy keep(u, v)
+        template <typename Keep>
+        auto compact(std::span<const std::size_t> rows, std::span<const Vertex> targets,
+                     const std::vector<std::size_t>& size, Keep&& keep) const -> Csr {
+            const auto n = size.size();
+            auto offsets = std::vector<std::size_t>(n + 1);
+            for (auto v = std::size_t{0}; v != n; ++v) offsets[v + 1] = offsets[v] + size[v];
+            auto result = std::vector<Vertex>(offsets[n]);
+            this->for_vertices(n, [&](std::size_t u) {
+                auto pos = offsets[u];
+                for (auto i = rows[u]; pos != offsets[u + 1]; ++i) {
+                    if (keep(static_cast<Vertex>(u), targets[i])) result[pos++] = targets[i];
+                }
+            });
+            return Csr(std::move(offsets), std::move(result));
+        }
+
+        void check(Vertex v) const {
+            if (static_cast<std::size_t>(v) >= this->num_vertices()) {
+                throw std::out_of_range("vertex is not in the graph");
+            }
+        }
+
+        ThreadPool& _pool;
+        Csr _adj{};  // all the neighbours of every vertex
+        Csr _up{};   // the neighbours higher in (degree, vertex) order
+    };
+
+    /**
+     * @brief Number of triangles through every vertex, as in NetworkX `nx.triangles(G)`
+     *
+     * The graph is read as simple and undirected (see NeighborIndex).
+     *
+     * @param[in] pool Pool running the count
+     * @param[in] gra The graph; vertices must be `0 .. n-1`
+     * @return std::vector<std::size_t> The triangle count of every vertex
+     */
+    template <typename Graph,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto triangles(ThreadPool& pool, const Graph& gra) -> std::vector<std::size_t> {
+        return NeighborIndex<Vertex>(pool, gra).triangles();
+    }
+
+    /**
+     * @brief Clustering coefficient of every vertex, as in NetworkX `nx.clustering(G)`
+     *
+     * The graph is read as simple and undirected (see NeighborIndex).
+     *
+     * @param[in] pool Pool running the count
+     * @param[in] gra The graph; vertices must be `0 .. n-1`
+     * @return std::vector<double> The clustering coefficient of every vertex
+     */
+    template <typename Graph,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto clustering(ThreadPool& pool, const Graph& gra) -> std::vector<double> {
+        return NeighborIndex<Vertex>(pool, gra).clustering();
+    }
+
+    /**
+     * @brief The vertices adjacent to both `u` and `v`, as in NetworkX
+     *        `nx.common_neighbors(G, u, v)`
+     *
+     * Sorts the two adjacency lists only, so a single query costs
+     * `O(d log d)` for degree `d`; use NeighborIndex for many queries. For
+     * a directed graph these are the common successors. `u` and `v`
+     * themselves are never included.
+     *
+     * @return std::vector<Vertex> The common neighbours, in increasing order
+     */
+    template <typename Graph>
+    auto common_neighbors(const Graph& gra,
+                          typename boost::graph_traits<Graph>::vertex_descriptor u,
+                          typename boost::graph_traits<Graph>::vertex_descriptor v)
+        -> std::vector<typename boost::graph_traits<Graph>::vertex_descriptor> {
+        using Vertex = typename boost::graph_traits<Graph>::vertex_descriptor;
+        const auto sorted = [&](Vertex x) {
+            auto result = std::vector<Vertex>{};
+            for (auto [it, last] = adjacent_vertices(x, gra); it != last; ++it) {
+                if (*it != u && *it != v) result.push_back(*it);
+            }
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+            return result;
+        };
+        const auto a = sorted(u);
+        const auto b = sorted(v);
+        auto result = std::vector<Vertex>{};
+        detail::intersect(std::span<const Vertex>(a), std::span<const Vertex>(b),
+                          [&result](Vertex w) { result.push_back(w); });
+        return result;
+    }
+
+}  // namespace py
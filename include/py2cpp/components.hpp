@@ -0,0 +1,205 @@
+/**
+ * @file components.hpp
+ * @brief Parallel connected components
+ *
+ * Provides the NetworkX-style py::connected_components() and
+ * py::number_connected_components(), computed on a ThreadPool by a
+ * lock-free union-find with the Afforest sampling scheme (Sutton, Ben-Nun
+ * and Barak, 2018):
+ *
+ * 1. link every vertex to its first two neighbours and compress, which
+ *    already joins most of a large component;
+ * 2. find the most frequent label in a small random sample;
+ * 3. link the remaining edges, skipping the vertices of that component,
+ *    since all of their edges lead into it or are seen from the other end.
+ *
+ * A link hooks the larger of two roots below the smaller one with a
+ * compare-and-swap, so every vertex ends up labelled with the smallest
+ * vertex of its component.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+namespace py {
+
+    namespace detail {
+
+        /**
+         * @brief Lock-free union-find over a dense parent array
+         *
+         * Invariant: `parent[v] <= v`, so roots are the smallest vertex of
+         * their tree.
+         */
+        template <typename Vertex> class UnionFind {
+            std::span<Vertex> _parent;
+
+            auto load(Vertex v) const noexcept -> Vertex {
+                return std::atomic_ref<Vertex>(this->_parent[v]).load(std::memory_order_relaxed);
+            }
+
+          public:
+            explicit UnionFind(std::span<Vertex> parent) : _parent{parent} {}
+
+            /**
+             * @brief Join the trees of `u` and `v`
+             */
+            void link(Vertex u, Vertex v) noexcept {
+                auto p1 = this->load(u);
+                auto p2 = this->load(v);
+                while (p1 != p2) {
+                    const auto high = std::max(p1, p2);
+                    const auto low = std::min(p1, p2);
+                    auto p_high = this->load(high);
+                    if (p_high == low) break;  // joined by another thread
+                    if (p_high == high
+                        && std::atomic_ref<Vertex>(this->_parent[high])
+                               .compare_exchange_strong(p_high, low, std::memory_order_relaxed)) {
+                        break;
+                    }
+                    p1 = this->load(this->load(high));
+                    p2 = this->load(low);
+                }
+            }
+
+            /**
+             * @brief Point `v` at its root (halving the path on the way)
+             */
+            auto compress(Vertex v) noexcept -> Vertex {
+                auto ref = std::atomic_ref<Vertex>(this->_parent[v]);
+                while (this->load(ref.load(std::memory_order_relaxed))
+                       != ref.load(std::memory_order_relaxed)) {
+                    ref.store(this->load(ref.load(std::memory_order_relaxed)),
+                              std::memory_order_relaxed);
+                }
+                return ref.load(std::memory_order_relaxed);
+            }
+
+            auto find(Vertex v) const noexcept -> Vertex {
+                while (this->load(v) != v) v = this->load(v);
+                return v;
+            }
+        };
+
+    }  // namespace detail
+
+    /**
+     * @brief Component label of every vertex, computed in parallel
+     *
+     * The label of a vertex is the smallest vertex of its component, so
+     * `labels[v] == v` exactly for one vertex per component. An undirected
+     * BGL graph is converted with both directions of every edge; for a
+     * directed graph the components are the weakly connected ones, and
+     * `symmetric` tells that every edge is stored in both directions anyway
+     * (which lets the sampling step skip the largest component).
+     *
+     * @param[in] pool Pool running the computation
+     * @param[in] gra The graph; vertices must be `0 .. n-1`
+     * @param[in] symmetric Whether every edge `(u, v)` has a reverse edge `(v, u)`
+     * @return std::vector<Vertex> The dense label array
+     */
+    template <typename Graph,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto connected_components(ThreadPool& pool, const Graph& gra, bool symmetric = false)
+        -> std::vector<Vertex> {
+        static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+        auto own = CsrGraph<boost::no_property, Vertex>{};
+        auto offsets = std::span<const std::size_t>{};
+        auto targets = std::span<const Vertex>{};
+        if constexpr (requires {
+                          { gra.row_offsets() } -> std::same_as<std::span<const std::size_t>>;
+                          { gra.column_indices() } -> std::same_as<std::span<const Vertex>>;
+                      }) {
+            offsets = gra.row_offsets();
+            targets = gra.column_indices();
+        } else {
+            own = to_csr<Vertex>(gra);
+            offsets = own.row_offsets();
+            targets = own.column_indices();
+        }
+        symmetric = symmetric || boost::is_undirected_graph<Graph>::value;
+
+        const auto n = offsets.size() - 1;
+        auto labels = std::vector<Vertex>(n);
+        auto sets = detail::UnionFind<Vertex>(labels);
+        const auto chunks = std::min(4 * (pool.size() + 1), n / 1024 + 1);
+        const auto for_each_vertex = [&](auto&& body) {
+            parallel_for(pool, n, chunks, [&](std::size_t, std::size_t lo, std::size_t hi) {
+                for (auto v = lo; v != hi; ++v) {
+                    body(static_cast<Vertex>(v));
+                }
+            });
+        };
+        for_each_vertex([&](Vertex v) { labels[v] = v; });
+
+        // 1. Link along the first neighbours of every vertex
+        constexpr auto rounds = std::size_t{2};
+        for (auto r = std::size_t{0}; r != rounds; ++r) {
+            for_each_vertex([&](Vertex v) {
+                if (offsets[v] + r < offsets[v + 1]) sets.link(v, targets[offsets[v] + r]);
+            });
+            for_each_vertex([&](Vertex v) { sets.compress(v); });
+        }
+
+        // 2. The most frequent label of a sample, probably the largest component
+        auto skip = n;  // none
+        if (symmetric && n != 0) {
+            auto sample = std::vector<Vertex>(1024);
+            auto state = std::uint64_t{n};
+            for (auto& s : sample) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                s = sets.find(static_cast<Vertex>((state >> 33) % n));
+            }
+            std::sort(sample.begin(), sample.end());
+            auto best = std::size_t{0};
+            for (auto i = std::size_t{0}; i != sample.size();) {
+                auto j = i;
+                while (j != sample.size() && sample[j] == sample[i]) ++j;
+                if (j - i > best) {
+                    best = j - i;
+                    skip = sample[i];
+                }
+                i = j;
+            }
+        }
+
+        // 3. Link the remaining edges outside that component
+        for_each_vertex([&](Vertex v) {
+            if (static_cast<std::size_t>(sets.find(v)) == skip) return;
+            for (auto i = offsets[v] + rounds; i < offsets[v + 1]; ++i) {
+                sets.link(v, targets[i]);
+            }
+        });
+        for_each_vertex([&](Vertex v) { sets.compress(v); });
+        return labels;
+    }
+
+    /**
+     * @brief Number of connected components, as in NetworkX
+     *
+     * @see connected_components()
+     */
+    template <typename Graph,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto number_connected_components(ThreadPool& pool, const Graph& gra, bool symmetric = false)
+        -> std::size_t {
+        const auto labels = connected_components<Graph, Vertex>(pool, gra, symmetric);
+        auto count = std::size_t{0};
+        for (auto v = std::size_t{0}; v != labels.size(); ++v) {
+            count += static_cast<std::size_t>(labels[v] == v);
+        }
+        return count;
+    }
+
+}  // namespace py
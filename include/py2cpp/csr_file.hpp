@@ -0,0 +1,251 @@
+/**
+ * @file csr_file.hpp
+ * @brief Binary CsrGraph file format opened with mmap
+ *
+ * Provides save_csr(), which writes any BGL graph (a GrAdaptor in
+ * particular) as a CSR file, and open_csr(), which maps such a file into
+ * memory and returns a CsrGraph viewing the mapped arrays directly. Opening
+ * a graph therefore costs a few system calls instead of a parse, and
+ * processes opening the same file share its pages in the page cache.
+ *
+ * @code
+ * py::save_csr("roads.csr", G, boost::get(boost::edge_weight, G));
+ * auto H = py::GrAdaptor<py::CsrGraph<int>>(py::open_csr<int>("roads.csr"));
+ * @endcode
+ *
+ * File layout (all values in the byte order of the writer):
+ *
+ * | bytes                        | contents                              |
+ * |------------------------------|---------------------------------------|
+ * | 0 .. 63                      | CsrFileHeader                         |
+ * | 64 ..                        | row offsets, `n + 1` unsigned integers |
+ * | `targets_pos` ..             | column array, `m` vertices            |
+ * | `properties_pos` .. (if any) | edge properties, `m` values           |
+ *
+ * Every array starts at a multiple of 64 bytes. The arrays are stored
+ * exactly as CsrGraph holds them in memory, so a file can only be opened
+ * with the same offset, vertex and property types and on a machine with
+ * the same byte order; open_csr() checks all of these.
+ *
+ * POSIX only (mmap).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "mapped_file.hpp"
+
+namespace py {
+
+    /**
+     * @brief Header at the start of a CSR file
+     */
+    struct CsrFileHeader {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t byte_order;     ///< byte_order_mark as written by the writer
+        std::uint32_t offset_size;    ///< bytes per row offset
+        std::uint32_t vertex_size;    ///< bytes per column entry
+        std::uint32_t property_size;  ///< bytes per edge property (0 if none)
+        std::uint32_t reserved;
+        std::uint64_t num_vertices;
+        std::uint64_t num_edges;
+        std::uint64_t targets_pos;     ///< file position of the column array
+        std::uint64_t properties_pos;  ///< file position of the properties (0 if none)
+
+        static constexpr std::array<char, 8> file_magic{'P', 'Y', '2', 'C', 'P', 'P', 'G', 'R'};
+        static constexpr std::uint32_t current_version = 1;
+        static constexpr std::uint32_t byte_order_mark = 0x01020304;
+        static constexpr std::uint64_t alignment = 64;
+    };
+
+    static_assert(sizeof(CsrFileHeader) == CsrFileHeader::alignment);
+    static_assert(std::is_trivially_copyable_v<CsrFileHeader>);
+
+    namespace detail {
+
+        inline auto csr_align(std::uint64_t pos) -> std::uint64_t {
+            constexpr auto align = CsrFileHeader::alignment;
+            return (pos + align - 1) / align * align;
+        }
+
+        template <typename T>
+        void csr_write_array(std::ofstream& out, std::span<const T> array, std::uint64_t pos) {
+            static constexpr auto zeros = std::array<char, CsrFileHeader::alignment>{};
+            const auto here = static_cast<std::uint64_t>(out.tellp());
+            out.write(zeros.data(), static_cast<std::streamsize>(pos - here));
+            out.write(reinterpret_cast<const char*>(array.data()),
+                      static_cast<std::streamsize>(array.size_bytes()));
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Write a CsrGraph to a CSR file
+     *
+     * The file is written under a temporary name and then renamed, so that
+     * processes which have the old file mapped keep a consistent graph.
+     *
+     * @param[in] path File name
+     * @param[in] gra The graph
+     * @throw std::runtime_error if the file cannot be written
+     */
+    template <typename EdgeProperty, typename Vertex>
+    void save_csr(const std::string& path, const CsrGraph<EdgeProperty, Vertex>& gra) {
+        constexpr auto with_properties = CsrGraph<EdgeProperty, Vertex>::has_edge_properties;
+        if constexpr (with_properties) {
+            static_assert(std::is_trivially_copyable_v<EdgeProperty>,
+                          "edge properties are stored byte for byte");
+            static_assert(alignof(EdgeProperty) <= CsrFileHeader::alignment);
+        }
+        const auto offsets = gra.row_offsets();
+        const auto targets = gra.column_indices();
+        const auto properties = gra.edge_properties();
+
+        auto header = CsrFileHeader{};
+        header.magic = CsrFileHeader::file_magic;
+        header.version = CsrFileHeader::current_version;
+        header.byte_order = CsrFileHeader::byte_order_mark;
+        header.offset_size = sizeof(std::size_t);
+        header.vertex_size = sizeof(Vertex);
+        header.num_vertices = offsets.size() - 1;
+        header.num_edges = targets.size();
+        header.targets_pos = detail::csr_align(sizeof(CsrFileHeader) + offsets.size_bytes());
+        if (with_properties) {
+            header.property_size = sizeof(EdgeProperty);
+            header.properties_pos = detail::csr_align(header.targets_pos + targets.size_bytes());
+        }
+
+        const auto temp = path + ".tmp";
+        {
+            auto out = std::ofstream(temp, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            detail::csr_write_array(out, offsets, sizeof(CsrFileHeader));
+            detail::csr_write_array(out, targets, header.targets_pos);
+            if constexpr (with_properties) {
+                if (properties.size() == targets.size()) {
+                    detail::csr_write_array(out, properties, header.properties_pos);
+                } else {  // built without properties: store default values
+                    const auto defaults = std::vector<EdgeProperty>(targets.size());
+                    detail::csr_write_array(out, std::span<const EdgeProperty>{defaults},
+                                            header.properties_pos);
+                }
+            }
+            out.close();
+            if (!out) {
+                std::filesystem::remove(temp);
+                throw std::runtime_error(path + ": cannot write the CSR graph file");
+            }
+        }
+        std::filesystem::rename(temp, path);
+    }
+
+    /**
+     * @brief Write any BGL graph (e.g. a GrAdaptor) to a CSR file
+     *
+     * @tparam Vertex Vertex type stored in the file
+     * @param[in] path File name
+     * @param[in] gra The graph, converted with to_csr()
+     */
+    template <typename Vertex = std::uint32_t, typename Graph>
+    void save_csr(const std::string& path, const Graph& gra) {
+        save_csr(path, to_csr<Vertex>(gra));
+    }
+
+    /**
+     * @brief Write any BGL graph to a CSR file together with an edge property
+     *
+     * @tparam Vertex Vertex type stored in the file
+     * @param[in] path File name
+     * @param[in] gra The graph, converted with to_csr()
+     * @param[in] edge_map Edge property map stored as the edge properties
+     */
+    template <typename Vertex = std::uint32_t, typename Graph, typename EdgeMap>
+    void save_csr(const std::string& path, const Graph& gra, EdgeMap edge_map) {
+        save_csr(path, to_csr<Vertex>(gra, edge_map));
+    }
+
+    /**
+     * @brief Map a CSR file into memory and view it as a CsrGraph
+     *
+     * Nothing is read up front; pages are loaded on first access. The
+     * mapping is private, so writing edge properties through the graph
+     * never changes the file. The mapping lives until the last copy of the
+     * graph is destroyed. Opening a weighted file with
+     * `EdgeProperty = boost::no_property` ignores the weights.
+     *
+     * @tparam EdgeProperty Edge property type the file was written with
+     * @tparam Vertex Vertex type the file was written with
+     * @param[in] path File name
+     * @return CsrGraph<EdgeProperty, Vertex> A view of the mapped file
+     * @throw std::system_error if the file cannot be mapped
+     * @throw std::runtime_error if the file is not a matching CSR file
+     */
+    template <typename EdgeProperty = boost::no_property, typename Vertex = std::uint32_t>
+    auto open_csr(const std::string& path) -> CsrGraph<EdgeProperty, Vertex> {
+        constexpr auto with_properties = CsrGraph<EdgeProperty, Vertex>::has_edge_properties;
+        auto file = std::make_shared<MappedFile>(path);
+        if (file->size() < sizeof(CsrFileHeader)) {
+            throw std::runtime_error(path + ": not a CSR graph file");
+        }
+        auto header = CsrFileHeader{};
+        std::copy_n(file->data(), sizeof(header), reinterpret_cast<std::byte*>(&header));
+
+        const auto fail = [&path](const char* reason) {
+            throw std::runtime_error(path + ": " + reason);
+        };
+        if (header.magic != CsrFileHeader::file_magic) fail("not a CSR graph file");
+        if (header.byte_order != CsrFileHeader::byte_order_mark) {
+            fail("CSR graph file has a different byte order");
+        }
+        if (header.version != CsrFileHeader::current_version) {
+            fail("unsupported CSR graph file version");
+        }
+        if (header.offset_size != sizeof(std::size_t) || header.vertex_size != sizeof(Vertex)) {
+            fail("CSR graph file has a different offset or vertex type");
+        }
+        if (with_properties && header.property_size != sizeof(EdgeProperty)) {
+            fail("CSR graph file has a different edge property type");
+        }
+
+        const auto n = header.num_vertices;
+        const auto m = header.num_edges;
+        const auto fits = [&file](std::uint64_t pos, std::uint64_t count, std::uint64_t size) {
+            return pos % CsrFileHeader::alignment == 0 && pos <= file->size()
+                   && count <= (file->size() - pos) / size;
+        };
+        if (n == ~std::uint64_t{0} || !fits(sizeof(CsrFileHeader), n + 1, sizeof(std::size_t))
+            || !fits(header.targets_pos, m, sizeof(Vertex))
+            || (with_properties && !fits(header.properties_pos, m, sizeof(EdgeProperty)))) {
+            fail("CSR graph file is truncated");
+        }
+
+        auto* base = file->data();
+        const auto offsets = std::span<const std::size_t>{
+            reinterpret_cast<const std::size_t*>(base + sizeof(CsrFileHeader)),
+            static_cast<std::size_t>(n + 1)};
+        const auto targets
+            = std::span<const Vertex>{reinterpret_cast<const Vertex*>(base + header.targets_pos),
+                                      static_cast<std::size_t>(m)};
+        auto properties = std::span<EdgeProperty>{};
+        if constexpr (with_properties) {
+            properties = {reinterpret_cast<EdgeProperty*>(base + header.properties_pos),
+                          static_cast<std::size_t>(m)};
+        }
+        return {std::move(file), offsets, targets, properties};
+    }
+
+}  // namespace py
@@ -0,0 +1,675 @@
+/**
+ * @file csr_graph.hpp
+ * @brief Immutable compressed-sparse-row graph for the Boost Graph Library
+ *
+ * Provides CsrGraph, a read-only directed graph stored as two contiguous
+ * arrays (row offsets and column targets) with optional edge properties in
+ * a parallel array. It models the BGL VertexList, EdgeList, Incidence and
+ * Adjacency graph concepts, so it can be wrapped by GrAdaptor or passed to
+ * BGL algorithms, and to_csr() converts any BGL graph into it. Large edge
+ * lists can be turned into a CsrGraph with a parallel counting sort, and a
+ * CsrGraph can also be a view of arrays owned elsewhere (see csr_file.hpp).
+ */
+
+#pragma once
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+namespace py {
+
+    /**
+     * @brief Edge descriptor of a CsrGraph: source vertex and edge index
+     *
+     * @tparam Vertex Vertex descriptor type
+     */
+    template <typename Vertex> struct CsrEdge {
+        Vertex src;
+        std::size_t idx;  ///< position in the column array
+
+        friend bool operator==(const CsrEdge&, const CsrEdge&) = default;
+    };
+
+    /**
+     * @brief Readable property map from a CsrEdge to its edge index
+     *
+     * @tparam Vertex Vertex descriptor type
+     */
+    template <typename Vertex> struct CsrEdgeIndexMap {
+        using key_type = CsrEdge<Vertex>;
+        using value_type = std::size_t;
+        using reference = std::size_t;
+        using category = boost::readable_property_map_tag;
+
+        friend auto get(CsrEdgeIndexMap, const key_type& e) -> std::size_t { return e.idx; }
+    };
+
+    /**
+     * @brief Immutable directed graph in compressed sparse row format.
+     *
+     * The out-neighbours of vertex `v` are `targets[offsets[v]]` up to (not
+     * including) `targets[offsets[v + 1]]`, in the order the edges were
+     * given. Edge `i` carries `properties[i]` when EdgeProperty is not
+     * `boost::no_property`. Vertices are the integers `0 .. n-1`.
+     *
+     * Undirected graphs are represented by storing both directions of
+     * every edge (which is what to_csr() does for an undirected BGL graph).
+     *
+     * The arrays are either owned by the graph or borrowed from a storage
+     * object (such as a memory-mapped file) that the graph keeps alive.
+     * Copies of a borrowing graph share the storage.
+     *
+     * @tparam EdgeProperty Edge property type (`boost::no_property` for none)
+     * @tparam Vertex Unsigned integral vertex type (32 bits halve the memory
+     *                of the column array compared with std::size_t)
+     */
+    template <typename EdgeProperty = boost::no_property, typename Vertex = std::uint32_t>
+    class CsrGraph {
+        static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+
+      public:
+        using vertex_descriptor = Vertex;
+        using edge_descriptor = CsrEdge<Vertex>;
+        using vertices_size_type = std::size_t;
+        using edges_size_type = std::size_t;
+        using degree_size_type = std::size_t;
+        using edge_property_type = EdgeProperty;
+
+        using directed_category = boost::directed_tag;
+        using edge_parallel_category = boost::allow_parallel_edge_tag;
+        struct traversal_category : boost::incidence_graph_tag,
+                                    boost::adjacency_graph_tag,
+                                    boost::vertex_list_graph_tag,
+                                    boost::edge_list_graph_tag {};
+
+        using vertex_iterator = boost::counting_iterator<Vertex>;
+        using adjacency_iterator = const Vertex*;
+
+        static constexpr bool has_edge_properties
+            = !std::is_same_v<EdgeProperty, boost::no_property>;
+
+        /**
+         * @brief Iterator over the out-edges of one vertex
+         */
+        class out_edge_iterator
+            : public boost::iterator_facade<out_edge_iterator, edge_descriptor,
+                                            boost::random_access_traversal_tag, edge_descriptor> {
+            Vertex _src{};
+            std::size_t _idx{};
+
+            friend class boost::iterator_core_access;
+
+            auto dereference() const -> edge_descriptor { return {this->_src, this->_idx}; }
+            auto equal(const out_edge_iterator& other) const -> bool {
+                return this->_idx == other._idx;
+            }
+            void increment() { ++this->_idx; }
+            void decrement() { --this->_idx; }
+            void advance(std::ptrdiff_t n) {
+                this->_idx = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(this->_idx) + n);
+            }
+            auto distance_to(const out_edge_iterator& other) const -> std::ptrdiff_t {
+                return static_cast<std::ptrdiff_t>(other._idx)
+                       - static_cast<std::ptrdiff_t>(this->_idx);
+            }
+
+          public:
+            out_edge_iterator() = default;
+            out_edge_iterator(Vertex src, std::size_t idx) : _src{src}, _idx{idx} {}
+        };
+
+        /**
+         * @brief Iterator over all edges, row by row
+         */
+        class edge_iterator
+            : public boost::iterator_facade<edge_iterator, edge_descriptor,
+                                            boost::forward_traversal_tag, edge_descriptor> {
+            const std::size_t* _offsets{};
+            std::size_t _num_vertices{};
+            std::size_t _src{};
+            std::size_t _idx{};
+
+            friend class boost::iterator_core_access;
+
+            void skip_empty_rows() {
+                while (this->_src < this->_num_vertices
+                       && this->_offsets[this->_src + 1] <= this->_idx) {
+                    ++this->_src;
+                }
+            }
+
+            auto dereference() const -> edge_descriptor {
+                return {static_cast<Vertex>(this->_src), this->_idx};
+            }
+            auto equal(const edge_iterator& other) const -> bool {
+                return this->_idx == other._idx;
+            }
+            void increment() {
+                ++this->_idx;
+                this->skip_empty_rows();
+            }
+
+          public:
+            edge_iterator() = default;
+            edge_iterator(const std::size_t* offsets, std::size_t num_vertices, std::size_t src,
+                          std::size_t idx)
+                : _offsets{offsets}, _num_vertices{num_vertices}, _src{src}, _idx{idx} {
+                this->skip_empty_rows();
+            }
+        };
+
+        /**
+         * @brief Construct an empty graph
+         */
+        CsrGraph() : _offsets(1, 0) { this->bind(); }
+
+        /**
+         * @brief Construct from the raw CSR arrays
+         *
+         * @param[in] offsets Row offsets (`n + 1` non-decreasing entries, starting at 0)
+         * @param[in] targets Column array (one target per edge)
+         * @param[in] properties Edge properties (one per edge, or empty for none)
+         * @throw std::invalid_argument if the arrays are inconsistent
+         */
+        CsrGraph(std::vector<std::size_t> offsets, std::vector<Vertex> targets,
+                 std::vector<EdgeProperty> properties = {})
+            : _offsets(std::move(offsets)),
+              _targets(std::move(targets)),
+              _properties(std::move(properties)) {
+            this->bind();
+            this->validate();
+        }
+
+        /**
+         * @brief View CSR arrays owned by `storage`
+         *
+         * No data is copied. Only the sizes of the arrays are checked, so that
+         * opening a large graph does not touch every page; the contents are
+         * trusted.
+         *
+         * @param[in] storage Keeps the arrays alive for as long as the graph (or a copy) exists
+         * @param[in] offsets Row offsets (`n + 1` entries)
+         * @param[in] targets Column array
+         * @param[in] properties Edge properties (one per edge, or empty for none)
+         * @throw std::invalid_argument if the sizes are inconsistent
+         */
+        CsrGraph(std::shared_ptr<const void> storage, std::span<const std::size_t> offsets,
+                 std::span<const Vertex> targets, std::span<EdgeProperty> properties = {})
+            : _storage(std::move(storage)),
+              _row(offsets),
+              _col(targets),
+              _prop(properties) {
+            if (offsets.empty() || offsets.front() != 0 || offsets.back() != targets.size()) {
+                throw std::invalid_argument("CSR offsets do not match the column array");
+            }
+            check_vertex_count(offsets.size() - 1);
+            if (!properties.empty() && properties.size() != targets.size()) {
+                throw std::invalid_argument("need one edge property per edge");
+            }
+        }
+
+        CsrGraph(const CsrGraph& other)
+            : _offsets(other._offsets),
+              _targets(other._targets),
+              _properties(other._properties),
+              _storage(other._storage),
+              _row(other._row),
+              _col(other._col),
+              _prop(other._prop) {
+            if (!this->_storage) this->bind();
+        }
+
+        CsrGraph& operator=(const CsrGraph& other) {
+            if (this != &other) *this = CsrGraph(other);
+            return *this;
+        }
+
+        // Moving a std::vector keeps its buffer, so the views stay valid
+        CsrGraph(CsrGraph&&) noexcept = default;
+        CsrGraph& operator=(CsrGraph&&) noexcept = default;
+        ~CsrGraph() = default;
+
+        /**
+         * @brief Construct from an edge list with a counting sort
+         *
+         * The out-edges of each vertex keep the order of `edges`.
+         *
+         * @tparam EdgeRange Forward range of pair-like `(u, v)` values
+         * @param[in] num_vertices Number of vertices
+         * @param[in] edges Edge list
+         * @throw std::out_of_range if an endpoint is not below `num_vertices`
+         */
+        template <typename EdgeRange>
+        CsrGraph(std::size_t num_vertices, const EdgeRange& edges)
+            : CsrGraph(num_vertices, edges, std::vector<EdgeProperty>{}) {}
+
+        /**
+         * @brief Construct from an edge list and matching edge properties
+         *
+         * @tparam EdgeRange Forward range of pair-like `(u, v)` values
+         * @tparam PropertyRange Range of edge properties, in the order of `edges`
+         * @param[in] num_vertices Number of vertices
+         * @param[in] edges Edge list
+         * @param[in] properties Edge properties (or an empty range for none)
+         * @throw std::out_of_range if an endpoint is not below `num_vertices`
+         */
+        template <typename EdgeRange, typename PropertyRange>
+        CsrGraph(std::size_t num_vertices, const EdgeRange& edges,
+                 const PropertyRange& properties)
+            : _offsets(num_vertices + 1, 0) {
+            check_vertex_count(num_vertices);
+            for (const auto& [u, v] : edges) {
+                if (static_cast<std::size_t>(u) >= num_vertices
+                    || static_cast<std::size_t>(v) >= num_vertices) {
+                    throw std::out_of_range("edge endpoint is not a vertex of the graph");
+                }
+                ++this->_offsets[static_cast<std::size_t>(u) + 1];
+            }
+            for (auto v = std::size_t{0}; v != num_vertices; ++v) {
+                this->_offsets[v + 1] += this->_offsets[v];
+            }
+            const auto num_edges = this->_offsets.back();
+            this->_targets.resize(num_edges);
+            const auto with_properties = std::begin(properties) != std::end(properties);
+            if (with_properties) this->_properties.resize(num_edges);
+
+            auto next = std::vector<std::size_t>(this->_offsets.begin(), this->_offsets.end() - 1);
+            auto prop = std::begin(properties);
+            for (const auto& [u, v] : edges) {
+                const auto pos = next[static_cast<std::size_t>(u)]++;
+                this->_targets[pos] = static_cast<Vertex>(v);
+                if (with_properties) {
+                    this->_properties[pos] = *prop;
+                    ++prop;
+                }
+            }
+            this->bind();
+            this->validate();
+        }
+
+        /**
+         * @brief Construct from an edge list with a parallel counting sort
+         *
+         * Builds exactly the same graph as the sequential constructor. The
+         * edge list is cut into chunks; every chunk counts the out-degrees of
+         * its sources in a private histogram, the histograms are combined into
+         * the row offsets and per-chunk write cursors, and every chunk then
+         * scatters its edges straight into their final slots. The number of
+         * chunks is capped so that the histograms never take more memory than
+         * the edge list itself.
+         *
+         * @tparam EdgeRange Random-access sized range of pair-like `(u, v)` values
+         * @tparam PropertyRange Random-access sized range of edge properties
+         * @param[in] pool Pool running the chunks
+         * @param[in] num_vertices Number of vertices
+         * @param[in] edges Edge list
+         * @param[in] properties Edge properties in the order of `edges` (or empty for none)
+         * @throw std::out_of_range if an endpoint is not below `num_vertices`
+         * @throw std::invalid_argument if `properties` has the wrong size
+         */
+        template <typename EdgeRange, typename PropertyRange = std::vector<EdgeProperty>>
+        CsrGraph(ThreadPool& pool, std::size_t num_vertices, const EdgeRange& edges,
+                 const PropertyRange& properties = {})
+            : _offsets(num_vertices + 1, 0) {
+            check_vertex_count(num_vertices);
+            const auto n = num_vertices;
+            const auto m = static_cast<std::size_t>(std::ranges::size(edges));
+            const auto with_properties = std::ranges::size(properties) != 0;
+            if (with_properties && static_cast<std::size_t>(std::ranges::size(properties)) != m) {
+                throw std::invalid_argument("need one edge property per edge");
+            }
+            const auto edge_at = std::ranges::begin(edges);
+            const auto prop_at = std::ranges::begin(properties);
+
+            constexpr auto min_chunk = std::size_t{1} << 14;
+            const auto workers = pool.size() + 1;  // the caller runs a chunk too
+            const auto per_vertex = m / std::max(n, std::size_t{1});
+            const auto chunks
+                = std::max(std::size_t{1}, std::min({workers, m / min_chunk, per_vertex}));
+
+            // counts[c * n + u]: out-degree of u within chunk c, later its write cursor
+            auto counts = std::vector<std::size_t>(chunks * n);
+            parallel_for(pool, m, chunks, [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                auto* count = counts.data() + c * n;
+                for (auto i = lo; i != hi; ++i) {
+                    const auto& [u, v] = edge_at[static_cast<std::ptrdiff_t>(i)];
+                    if (static_cast<std::size_t>(u) >= n || static_cast<std::size_t>(v) >= n) {
+                        throw std::out_of_range("edge endpoint is not a vertex of the graph");
+                    }
+                    ++count[static_cast<std::size_t>(u)];
+                }
+            });
+            parallel_for(pool, n, workers, [&](std::size_t, std::size_t lo, std::size_t hi) {
+                for (auto v = lo; v != hi; ++v) {
+                    auto running = std::size_t{0};
+                    for (auto c = std::size_t{0}; c != chunks; ++c) {
+                        running += std::exchange(counts[c * n + v], running);
+                    }
+                    this->_offsets[v + 1] = running;
+                }
+            });
+            for (auto v = std::size_t{0}; v != n; ++v) {
+                this->_offsets[v + 1] += this->_offsets[v];
+            }
+
+            this->_targets.resize(m);
+            if (with_properties) this->_properties.resize(m);
+            parallel_for(pool, m, chunks, [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                auto* cursor = counts.data() + c * n;
+                for (auto i = lo; i != hi; ++i) {
+                    const auto& [u, v] = edge_at[static_cast<std::ptrdiff_t>(i)];
+                    const auto src = static_cast<std::size_t>(u);
+                    const auto pos = this->_offsets[src] + cursor[src]++;
+                    this->_targets[pos] = static_cast<Vertex>(v);
+                    if (with_properties) {
+                        this->_properties[pos] = prop_at[static_cast<std::ptrdiff_t>(i)];
+                    }
+                }
+            });
+            this->bind();
+        }
+
+        /**
+         * @brief The null vertex (never a valid vertex)
+         */
+        static auto null_vertex() noexcept -> Vertex { return std::numeric_limits<Vertex>::max(); }
+
+        /**
+         * @brief Row offsets array (`n + 1` entries)
+         */
+        [[nodiscard]] auto row_offsets() const noexcept -> std::span<const std::size_t> {
+            return this->_row;
+        }
+
+        /**
+         * @brief Column array: the target of every edge
+         */
+        [[nodiscard]] auto column_indices() const noexcept -> std::span<const Vertex> {
+            return this->_col;
+        }
+
+        /**
+         * @brief Edge properties, parallel to column_indices() (empty if none)
+         */
+        [[nodiscard]] auto edge_properties() const noexcept -> std::span<const EdgeProperty> {
+            return this->_prop;
+        }
+
+        /**
+         * @brief Whether the arrays are borrowed from a storage object
+         */
+        [[nodiscard]] auto is_view() const noexcept -> bool { return this->_storage != nullptr; }
+
+        /**
+         * @brief Index of an edge in the column array
+         */
+        static auto edge_index(const edge_descriptor& e) noexcept -> std::size_t { return e.idx; }
+
+        /**
+         * @brief Property of an edge (like a BGL bundled property)
+         */
+        auto operator[](const edge_descriptor& e) -> EdgeProperty& { return this->_prop[e.idx]; }
+        auto operator[](const edge_descriptor& e) const -> const EdgeProperty& {
+            return this->_prop[e.idx];
+        }
+
+        // ---- BGL interface (found by argument-dependent lookup) ----
+
+        friend auto num_vertices(const CsrGraph& gra) noexcept -> std::size_t {
+            return gra._row.size() - 1;
+        }
+
+        friend auto num_edges(const CsrGraph& gra) noexcept -> std::size_t {
+            return gra._col.size();
+        }
+
+        friend auto vertices(const CsrGraph& gra)
+            -> std::pair<vertex_iterator, vertex_iterator> {
+            return {vertex_iterator{Vertex{0}},
+                    vertex_iterator{static_cast<Vertex>(num_vertices(gra))}};
+        }
+
+        friend auto edges(const CsrGraph& gra) -> std::pair<edge_iterator, edge_iterator> {
+            const auto n = num_vertices(gra);
+            const auto* offsets = gra._row.data();
+            return {edge_iterator{offsets, n, 0, 0}, edge_iterator{offsets, n, n, num_edges(gra)}};
+        }
+
+        friend auto out_edges(Vertex v, const CsrGraph& gra)
+            -> std::pair<out_edge_iterator, out_edge_iterator> {
+            return {out_edge_iterator{v, gra._row[v]},
+                    out_edge_iterator{v, gra._row[std::size_t{v} + 1]}};
+        }
+
+        friend auto out_degree(Vertex v, const CsrGraph& gra) noexcept -> std::size_t {
+            return gra._row[std::size_t{v} + 1] - gra._row[v];
+        }
+
+        friend auto adjacent_vertices(Vertex v, const CsrGraph& gra)
+            -> std::pair<adjacency_iterator, adjacency_iterator> {
+            const auto* targets = gra._col.data();
+            return {targets + gra._row[v], targets + gra._row[std::size_t{v} + 1]};
+        }
+
+        friend auto source(const edge_descriptor& e, const CsrGraph&) noexcept -> Vertex {
+            return e.src;
+        }
+
+        friend auto target(const edge_descriptor& e, const CsrGraph& gra) noexcept -> Vertex {
+            return gra._col[e.idx];
+        }
+
+        /**
+         * @brief First edge from `u` to `v` (linear in the out-degree of `u`)
+         */
+        friend auto edge(Vertex u, Vertex v, const CsrGraph& gra)
+            -> std::pair<edge_descriptor, bool> {
+            for (auto idx = gra._row[u]; idx != gra._row[std::size_t{u} + 1]; ++idx) {
+                if (gra._col[idx] == v) return {edge_descriptor{u, idx}, true};
+            }
+            return {edge_descriptor{u, 0}, false};
+        }
+
+        friend auto get(boost::vertex_index_t, const CsrGraph&) noexcept {
+            return boost::typed_identity_property_map<Vertex>{};
+        }
+
+        friend auto get(boost::vertex_index_t, const CsrGraph&, Vertex v) noexcept -> Vertex {
+            return v;
+        }
+
+        friend auto get(boost::edge_index_t, const CsrGraph&) noexcept {
+            return CsrEdgeIndexMap<Vertex>{};
+        }
+
+        friend auto get(boost::edge_index_t, const CsrGraph&, const edge_descriptor& e) noexcept
+            -> std::size_t {
+            return e.idx;
+        }
+
+      private:
+        static void check_vertex_count(std::size_t num_vertices) {
+            if (num_vertices > std::size_t{std::numeric_limits<Vertex>::max()}) {
+                throw std::out_of_range("too many vertices for the CSR vertex type");
+            }
+        }
+
+        void bind() noexcept {
+            this->_row = this->_offsets;
+            this->_col = this->_targets;
+            this->_prop = this->_properties;
+        }
+
+        void validate() const {
+            if (this->_row.empty() || this->_row.front() != 0
+                || this->_row.back() != this->_col.size()) {
+                throw std::invalid_argument("CSR offsets do not match the column array");
+            }
+            const auto n = this->_row.size() - 1;
+            check_vertex_count(n);
+            for (auto v = std::size_t{0}; v != n; ++v) {
+                if (this->_row[v] > this->_row[v + 1]) {
+                    throw std::invalid_argument("CSR offsets must be non-decreasing");
+                }
+            }
+            for (const auto t : this->_col) {
+                if (std::size_t{t} >= n) {
+                    throw std::invalid_argument("CSR column index is not a vertex");
+                }
+            }
+            if (!this->_prop.empty() && this->_prop.size() != this->_col.size()) {
+                throw std::invalid_argument("need one edge property per edge");
+            }
+        }
+
+        // Owned arrays (empty for a view)
+        std::vector<std::size_t> _offsets{};
+        std::vector<Vertex> _targets{};
+        std::vector<EdgeProperty> _properties{};
+
+        // What the graph reads: the owned arrays, or memory kept alive by _storage
+        std::shared_ptr<const void> _storage{};
+        std::span<const std::size_t> _row{};
+        std::span<const Vertex> _col{};
+        std::span<EdgeProperty> _prop{};
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Fill CSR arrays from a BGL graph
+         *
+         * Calls `on_edge(pos, e)` for every edge `e` stored at position `pos`.
+         * The BGL functions are called unqualified so that argument-dependent
+         * lookup finds them in the graph's own namespace.
+         */
+        template <typename Vertex, typename Graph, typename OnEdge>
+        void csr_fill(const Graph& gra, std::vector<std::size_t>& offsets,
+                      std::vector<Vertex>& targets, OnEdge&& on_edge) {
+            const auto n = static_cast<std::size_t>(num_vertices(gra));
+            if (n > std::size_t{std::numeric_limits<Vertex>::max()}) {
+                throw std::out_of_range("too many vertices for the CSR vertex type");
+            }
+            const auto index = get(boost::vertex_index, gra);
+            offsets.assign(n + 1, 0);
+            for (auto [vi, vend] = vertices(gra); vi != vend; ++vi) {
+                offsets[static_cast<std::size_t>(get(index, *vi)) + 1]
+                    = static_cast<std::size_t>(out_degree(*vi, gra));
+            }
+            for (auto v = std::size_t{0}; v != n; ++v) {
+                offsets[v + 1] += offsets[v];
+            }
+            targets.resize(offsets.back());
+            for (auto [vi, vend] = vertices(gra); vi != vend; ++vi) {
+                auto pos = offsets[static_cast<std::size_t>(get(index, *vi))];
+                for (auto [ei, eend] = out_edges(*vi, gra); ei != eend; ++ei, ++pos) {
+                    targets[pos] = static_cast<Vertex>(get(index, target(*ei, gra)));
+                    on_edge(pos, *ei);
+                }
+            }
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Convert any BGL graph into a CsrGraph
+     *
+     * Vertices are numbered by the graph's `vertex_index` map and out-edges
+     * keep their BGL iteration order. An undirected graph yields both
+     * directions of every edge.
+     *
+     * @tparam Vertex Vertex type of the result
+     * @tparam Graph A BGL VertexListGraph and IncidenceGraph
+     * @param[in] gra The graph to convert
+     * @return CsrGraph<boost::no_property, Vertex>
+     */
+    template <typename Vertex = std::uint32_t, typename Graph>
+    auto to_csr(const Graph& gra) -> CsrGraph<boost::no_property, Vertex> {
+        auto offsets = std::vector<std::size_t>{};
+        auto targets = std::vector<Vertex>{};
+        detail::csr_fill(gra, offsets, targets, [](std::size_t, const auto&) {});
+        return {std::move(offsets), std::move(targets)};
+    }
+
+    /**
+     * @brief Convert any BGL graph into a CsrGraph, copying an edge property
+     *
+     * @code
+     * auto csr = py::to_csr(gra, boost::get(boost::edge_weight, gra));
+     * @endcode
+     *
+     * @tparam Vertex Vertex type of the result
+     * @tparam Graph A BGL VertexListGraph and IncidenceGraph
+     * @tparam EdgeMap Readable edge property map of `gra`
+     * @param[in] gra The graph to convert
+     * @param[in] edge_map Values stored as the edge properties
+     * @return CsrGraph<value type of EdgeMap, Vertex>
+     */
+    template <typename Vertex = std::uint32_t, typename Graph, typename EdgeMap>
+    auto to_csr(const Graph& gra, EdgeMap edge_map)
+        -> CsrGraph<typename boost::property_traits<EdgeMap>::value_type, Vertex> {
+        using Property = typename boost::property_traits<EdgeMap>::value_type;
+        auto offsets = std::vector<std::size_t>{};
+        auto targets = std::vector<Vertex>{};
+        auto properties = std::vector<Property>{};
+        detail::csr_fill(gra, offsets, targets, [&](std::size_t pos, const auto& e) {
+            if (properties.empty()) properties.resize(targets.size());
+            properties[pos] = get(edge_map, e);
+        });
+        return {std::move(offsets), std::move(targets), std::move(properties)};
+    }
+
+    namespace detail {
+
+        // The CSR arrays of `gra`: those of a CsrGraph in place, otherwise
+        // those of a converted copy kept in `own`
+        template <typename Vertex, typename Graph>
+        auto csr_arrays(const Graph& gra, CsrGraph<boost::no_property, Vertex>& own)
+            -> std::pair<std::span<const std::size_t>, std::span<const Vertex>> {
+            if constexpr (requires {
+                              { gra.row_offsets() } -> std::same_as<std::span<const std::size_t>>;
+                              { gra.column_indices() } -> std::same_as<std::span<const Vertex>>;
+                          }) {
+                return {gra.row_offsets(), gra.column_indices()};
+            } else {
+                own = to_csr<Vertex>(gra);
+                return {own.row_offsets(), own.column_indices()};
+            }
+        }
+
+    }  // namespace detail
+
+}  // namespace py
+
+namespace boost {
+
+    template <typename EdgeProperty, typename Vertex>
+    struct property_map<py::CsrGraph<EdgeProperty, Vertex>, vertex_index_t> {
+        using type = typed_identity_property_map<Vertex>;
+        using const_type = type;
+    };
+
+    template <typename EdgeProperty, typename Vertex>
+    struct property_map<py::CsrGraph<EdgeProperty, Vertex>, edge_index_t> {
+        using type = py::CsrEdgeIndexMap<Vertex>;
+        using const_type = type;
+    };
+
+}  // namespace boost
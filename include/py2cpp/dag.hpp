@@ -0,0 +1,270 @@
+/**
+ * @file dag.hpp
+ * @brief Parallel topological order and scheduling over directed acyclic graphs
+ *
+ * Provides the NetworkX-style py::topological_generations() and
+ * py::topological_sort(), and py::dag_foreach(), which calls a function on
+ * every vertex after it has been called on all the predecessors. All of
+ * them count the unfinished predecessors of every vertex with an atomic
+ * counter, Kahn style, on a ThreadPool.
+ *
+ * dag_foreach() has two schedules. DagSchedule::levels runs one
+ * generation at a time with a parallel_for per generation, which is
+ * simple and deterministic in its grouping. DagSchedule::dependencies
+ * starts a vertex as soon as its last predecessor is done, so a long
+ * chain does not wait at every level for the slowest vertex of the level;
+ * ready vertices are kept on per-job stacks and surplus work is split off
+ * as new jobs for idle workers to steal.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/pending/property.hpp>
+#include <cstddef>
+#include <exception>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+namespace py {
+
+    /**
+     * @brief How dag_foreach() orders the calls
+     */
+    enum class DagSchedule {
+        levels,       ///< one generation after the other
+        dependencies  ///< every vertex as soon as its predecessors are done
+    };
+
+    namespace detail {
+
+        // Number of in-edges of every vertex, counted in parallel
+        template <typename Vertex>
+        auto in_degrees(ThreadPool& pool, std::span<const std::size_t> offsets,
+                        std::span<const Vertex> targets) -> std::vector<std::size_t> {
+            const auto n = offsets.size() - 1;
+            auto degree = std::vector<std::size_t>(n);
+            const auto chunks = std::min(4 * (pool.size() + 1), n / 1024 + 1);
+            parallel_for(pool, n, chunks, [&](std::size_t, std::size_t lo, std::size_t hi) {
+                for (auto i = offsets[lo]; i != offsets[hi]; ++i) {
+                    std::atomic_ref<std::size_t>(degree[targets[i]])
+                        .fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+            return degree;
+        }
+
+        // Generations of the DAG given by CSR arrays; throws on a cycle
+        template <typename Vertex>
+        auto generations(ThreadPool& pool, std::span<const std::size_t> offsets,
+                         std::span<const Vertex> targets) -> std::vector<std::vector<Vertex>> {
+            const auto n = offsets.size() - 1;
+            auto waiting = in_degrees(pool, offsets, targets);
+            auto level = std::vector<Vertex>{};
+            for (auto v = std::size_t{0}; v != n; ++v) {
+                if (waiting[v] == 0) level.push_back(static_cast<Vertex>(v));
+            }
+            auto result = std::vector<std::vector<Vertex>>{};
+            auto done = std::size_t{0};
+            auto found = std::vector<std::vector<Vertex>>{};
+            while (!level.empty()) {
+                done += level.size();
+                // Each chunk collects the successors whose last predecessor it finishes
+                const auto chunks = std::min(4 * (pool.size() + 1), level.size() / 256 + 1);
+                found.assign(chunks, {});
+                parallel_for(pool, level.size(), chunks,
+                             [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                                 for (auto k = lo; k != hi; ++k) {
+                                     const auto u = level[k];
+                                     for (auto i = offsets[u]; i != offsets[u + 1]; ++i) {
+                                         const auto v = targets[i];
+                                         if (std::atomic_ref<std::size_t>(waiting[v]).fetch_sub(
+                                                 1, std::memory_order_relaxed)
+                                             == 1) {
+                                             found[c].push_back(v);
+                                         }
+                                     }
+                                 }
+                             });
+                result.push_back(std::move(level));
+                level = {};
+                for (const auto& part : found) level.insert(level.end(), part.begin(), part.end());
+                std::sort(level.begin(), level.end());
+            }
+            if (done != n) throw std::invalid_argument("graph contains a cycle");
+            return result;
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief The vertices grouped by generation, as in NetworkX `nx.topological_generations(G)`
+     *
+     * Generation 0 holds the vertices without in-edges; generation `k + 1`
+     * holds those whose predecessors are all in generations `0 .. k`, so a
+     * vertex's generation is the length of the longest path ending at it.
+     * Each generation is sorted.
+     *
+     * @param[in] pool Pool running the computation
+     * @param[in] gra The graph; vertices must be `0 .. n-1`
+     * @return std::vector<std::vector<Vertex>> The generations, in order
+     * @throw std::invalid_argument if the graph has a cycle
+     */
+    template <typename Graph,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto topological_generations(ThreadPool& pool, const Graph& gra)
+        -> std::vector<std::vector<Vertex>> {
+        static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+        auto own = CsrGraph<boost::no_property, Vertex>{};
+        const auto [offsets, targets] = detail::csr_arrays<Vertex>(gra, own);
+        return detail::generations(pool, offsets, targets);
+    }
+
+    /**
+     * @brief The vertices in a topological order, as in NetworkX `nx.topological_sort(G)`
+     *
+     * Every edge `(u, v)` has `u` before `v`. The order is that of
+     * topological_generations(), one generation after the other.
+     *
+     * @throw std::invalid_argument if the graph has a cycle
+     */
+    template <typename Graph,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto topological_sort(ThreadPool& pool, const Graph& gra) -> std::vector<Vertex> {
+        const auto levels = topological_generations<Graph, Vertex>(pool, gra);
+        auto result = std::vector<Vertex>{};
+        for (const auto& level : levels) result.insert(result.end(), level.begin(), level.end());
+        return result;
+    }
+
+    /**
+     * @brief Call `fn(v)` for every vertex `v`, after all the predecessors of `v`
+     *
+     * Calls run in parallel on the pool. Everything a call to `fn(u)`
+     * wrote is visible to the calls of the successors of `u`, so `fn` may
+     * read the results of the predecessors without further synchronization.
+     *
+     * @code
+     * py::dag_foreach(pool, G, [&](auto v) {
+     *     for (const auto& e : in_edges_of[v]) arrival[v] = std::max(arrival[v], ...);
+     * }, py::DagSchedule::dependencies);
+     * @endcode
+     *
+     * With DagSchedule::levels a cycle is reported before any call. With
+     * DagSchedule::dependencies the vertices not behind a cycle are
+     * visited before the cycle is reported. After `fn` throws, no further
+     * calls are started and the exception is rethrown.
+     *
+     * @param[in] pool Pool running the calls
+     * @param[in] gra The graph; vertices must be `0 .. n-1`
+     * @param[in] fn Callable `(Vertex)`
+     * @param[in] schedule Whether to wait for whole generations
+     * @throw std::invalid_argument if the graph has a cycle
+     */
+    template <typename Graph, typename Fn,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    void dag_foreach(ThreadPool& pool, const Graph& gra, Fn&& fn,
+                     DagSchedule schedule = DagSchedule::levels) {
+        static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+        auto own = CsrGraph<boost::no_property, Vertex>{};
+        const auto [offsets, targets] = detail::csr_arrays<Vertex>(gra, own);
+        if (schedule == DagSchedule::levels) {
+            for (const auto& level : detail::generations(pool, offsets, targets)) {
+                const auto chunks = std::min(4 * (pool.size() + 1), level.size() / 64 + 1);
+                parallel_for(pool, level.size(), chunks,
+                             [&](std::size_t, std::size_t lo, std::size_t hi) {
+                                 for (auto k = lo; k != hi; ++k) fn(level[k]);
+                             });
+            }
+            return;
+        }
+
+        const auto n = offsets.size() - 1;
+        auto waiting = detail::in_degrees(pool, offsets, targets);
+        auto remaining = std::atomic<std::size_t>{n};
+        auto active = std::atomic<std::size_t>{0};  // jobs submitted and not finished
+        auto failed = std::atomic<bool>{false};
+        auto exception = std::exception_ptr{};
+        constexpr auto grain = std::size_t{32};
+
+        // Run the ready vertices on a stack, handing half of a large stack to a new job
+        struct Runner {
+            std::span<const std::size_t> offsets;
+            std::span<const Vertex> targets;
+            std::vector<std::size_t>& waiting;
+            std::atomic<std::size_t>& remaining;
+            std::atomic<std::size_t>& active;
+            std::atomic<bool>& failed;
+            std::exception_ptr& exception;
+            ThreadPool& pool;
+            Fn& fn;
+
+            void spawn(std::vector<Vertex> ready) const {
+                this->active.fetch_add(1, std::memory_order_relaxed);
+                this->pool.submit([*this, ready = std::move(ready)]() mutable {
+                    this->run(std::move(ready));
+                    this->active.fetch_sub(1, std::memory_order_release);
+                });
+            }
+
+            void run(std::vector<Vertex> ready) const {
+                while (!ready.empty()) {
+                    if (ready.size() > grain) {
+                        const auto half = static_cast<std::ptrdiff_t>(ready.size() / 2);
+                        this->spawn(std::vector<Vertex>(ready.begin() + half, ready.end()));
+                        ready.erase(ready.begin() + half, ready.end());
+                    }
+                    const auto u = ready.back();
+                    ready.pop_back();
+                    if (!this->failed.load(std::memory_order_relaxed)) {
+                        try {
+                            this->fn(u);
+                        } catch (...) {
+                            if (!this->failed.exchange(true)) {
+                                this->exception = std::current_exception();
+                            }
+                        }
+                    }
+                    for (auto i = this->offsets[u]; i != this->offsets[u + 1]; ++i) {
+                        const auto v = this->targets[i];
+                        if (std::atomic_ref<std::size_t>(this->waiting[v]).fetch_sub(
+                                1, std::memory_order_acq_rel)
+                            == 1) {
+                            ready.push_back(v);
+                        }
+                    }
+                    this->remaining.fetch_sub(1, std::memory_order_release);
+                }
+            }
+        };
+        const auto runner
+            = Runner{offsets, targets, waiting, remaining, active, failed, exception, pool, fn};
+        auto sources = std::vector<Vertex>{};
+        for (auto v = std::size_t{0}; v != n; ++v) {
+            if (waiting[v] == 0) sources.push_back(static_cast<Vertex>(v));
+        }
+        for (auto lo = std::size_t{0}; lo < sources.size(); lo += grain) {
+            const auto hi = std::min(lo + grain, sources.size());
+            runner.spawn(std::vector<Vertex>(sources.begin() + static_cast<std::ptrdiff_t>(lo),
+                                             sources.begin() + static_cast<std::ptrdiff_t>(hi)));
+        }
+        // Help until all jobs are done; vertices left over then sit on or behind a cycle
+        while (active.load(std::memory_order_acquire) != 0) {
+            if (!pool.run_one()) std::this_thread::yield();
+        }
+        if (exception != nullptr) std::rethrow_exception(exception);
+        if (remaining.load(std::memory_order_acquire) != 0) {
+            throw std::invalid_argument("graph contains a cycle");
+        }
+    }
+
+}  // namespace py
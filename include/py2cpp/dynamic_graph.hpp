@@ -0,0 +1,674 @@
+/**
+ * @file dynamic_graph.hpp
+ * @brief Mutable directed graph served to readers as immutable CSR snapshots
+ *
+ * Provides DynamicGraph, which takes edge insertions and deletions at any
+ * time, and DynamicSnapshot, a consistent read-only view of it that models
+ * the same BGL traversal concepts as CsrGraph (so it can be wrapped by GrAdaptor).
+ *
+ * The graph is a sorted CSR base plus a log of the updates made since.
+ * A snapshot shares the base and adds a small patch: the merged rows of
+ * the vertices the log touches, so every row of a snapshot is one sorted
+ * contiguous array. When the log grows past a threshold the graph is
+ * compacted on a ThreadPool: the rows of a snapshot are flattened into a
+ * new base, which replaces the old one together with the part of the log
+ * it contains. Readers holding older snapshots keep their arrays alive,
+ * and writers only wait for the short swap at the end.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/pending/property.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+namespace py {
+
+    template <typename Vertex> class DynamicGraph;
+
+    namespace detail {
+
+        // An insertion or deletion of the edge (u, v)
+        template <typename Vertex> struct EdgeUpdate {
+            Vertex u;
+            Vertex v;
+            bool insert;
+        };
+
+        // Merged rows of the vertices touched by an update log
+        template <typename Vertex> struct RowPatch {
+            std::vector<Vertex> touched{};       // sorted
+            std::vector<std::size_t> offsets{};  // row of touched[i]: offsets[i] .. offsets[i+1]
+            std::vector<Vertex> targets{};
+        };
+
+    }  // namespace detail
+
+    /**
+     * @brief Immutable view of a DynamicGraph at one point in time.
+     *
+     * The out-neighbours of every vertex are sorted and contiguous, either
+     * in the shared CSR base or in the snapshot's own patch. An edge is
+     * identified by its position in the concatenation of the two column
+     * arrays. These positions are not dense, so the snapshot has no
+     * `edge_index` property map, and GrAdaptor edge attributes are not
+     * available on it; convert it with to_csr() for dense edge ids. Copies
+     * share the arrays.
+     *
+     * @tparam Vertex Unsigned integral vertex type
+     */
+    template <typename Vertex = std::uint32_t> class DynamicSnapshot {
+        static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+
+        using Csr = CsrGraph<boost::no_property, Vertex>;
+        using Patch = detail::RowPatch<Vertex>;
+
+        friend class DynamicGraph<Vertex>;
+
+      public:
+        using vertex_descriptor = Vertex;
+        using edge_descriptor = CsrEdge<Vertex>;
+        using vertices_size_type = std::size_t;
+        using edges_size_type = std::size_t;
+        using degree_size_type = std::size_t;
+
+        using directed_category = boost::directed_tag;
+        using edge_parallel_category = boost::disallow_parallel_edge_tag;
+        struct traversal_category : boost::incidence_graph_tag,
+                                    boost::adjacency_graph_tag,
+                                    boost::vertex_list_graph_tag,
+                                    boost::edge_list_graph_tag {};
+
+        using vertex_iterator = boost::counting_iterator<Vertex>;
+        using adjacency_iterator = const Vertex*;
+
+        /**
+         * @brief Iterator over the out-edges of one vertex
+         */
+        class out_edge_iterator
+            : public boost::iterator_facade<out_edge_iterator, edge_descriptor,
+                                            boost::random_access_traversal_tag, edge_descriptor> {
+            Vertex _src{};
+            std::size_t _idx{};
+
+            friend class boost::iterator_core_access;
+
+            auto dereference() const -> edge_descriptor { return {this->_src, this->_idx}; }
+            auto equal(const out_edge_iterator& other) const -> bool {
+                return this->_idx == other._idx;
+            }
+            void increment() { ++this->_idx; }
+            void decrement() { --this->_idx; }
+            void advance(std::ptrdiff_t n) {
+                this->_idx = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(this->_idx) + n);
+            }
+            auto distance_to(const out_edge_iterator& other) const -> std::ptrdiff_t {
+                return static_cast<std::ptrdiff_t>(other._idx)
+                       - static_cast<std::ptrdiff_t>(this->_idx);
+            }
+
+          public:
+            out_edge_iterator() = default;
+            out_edge_iterator(Vertex src, std::size_t idx) : _src{src}, _idx{idx} {}
+        };
+
+        /**
+         * @brief Iterator over all edges, row by row
+         */
+        class edge_iterator
+            : public boost::iterator_facade<edge_iterator, edge_descriptor,
+                                            boost::forward_traversal_tag, edge_descriptor> {
+            const DynamicSnapshot* _gra{};
+            std::size_t _src{};
+            std::size_t _idx{};
+            std::size_t _last{};  // end of the row of _src
+
+            friend class boost::iterator_core_access;
+
+            void skip_empty_rows() {
+                while (this->_idx == this->_last && this->_src != this->_gra->_n) {
+                    if (++this->_src == this->_gra->_n) {
+                        this->_idx = this->_last = 0;  // the end iterator
+                    } else {
+                        std::tie(this->_idx, this->_last) = this->_gra->row_range(this->_src);
+                    }
+                }
+            }
+
+            auto dereference() const -> edge_descriptor {
+                return {static_cast<Vertex>(this->_src), this->_idx};
+            }
+            auto equal(const edge_iterator& other) const -> bool {
+                return this->_src == other._src && this->_idx == other._idx;
+            }
+            void increment() {
+                ++this->_idx;
+                this->skip_empty_rows();
+            }
+
+          public:
+            edge_iterator() = default;
+            edge_iterator(const DynamicSnapshot* gra, std::size_t src) : _gra{gra}, _src{src} {
+                if (src != gra->_n) {
+                    std::tie(this->_idx, this->_last) = gra->row_range(src);
+                    this->skip_empty_rows();
+                }
+            }
+        };
+
+        /**
+         * @brief Construct an empty graph
+         */
+        DynamicSnapshot() : _base{std::make_shared<const Csr>()}, _patch{empty_patch()} {}
+
+        /**
+         * @brief The null vertex (never a valid vertex)
+         */
+        static auto null_vertex() noexcept -> Vertex { return std::numeric_limits<Vertex>::max(); }
+
+        /**
+         * @brief The out-neighbours of `v`, in increasing order
+         */
+        [[nodiscard]] auto neighbors(Vertex v) const -> std::span<const Vertex> {
+            const auto [lo, hi] = this->row_range(v);
+            return {this->target_at(lo), hi - lo};
+        }
+
+        /**
+         * @brief Whether the edge `(u, v)` exists (logarithmic in the out-degree of `u`)
+         */
+        [[nodiscard]] auto has_edge(Vertex u, Vertex v) const -> bool {
+            const auto row = this->neighbors(u);
+            return std::binary_search(row.begin(), row.end(), v);
+        }
+
+        /**
+         * @brief Number of updates merged on top of the CSR base
+         */
+        [[nodiscard]] auto pending_updates() const noexcept -> std::size_t {
+            return this->_pending;
+        }
+
+        /**
+         * @brief Copy into a CsrGraph with sorted rows
+         *
+         * @param[in] pool Pool copying the rows
+         */
+        [[nodiscard]] auto to_csr(ThreadPool& pool) const -> Csr {
+            const auto n = this->_n;
+            auto offsets = std::vector<std::size_t>(n + 1);
+            for (auto v = std::size_t{0}; v != n; ++v) {
+                const auto [lo, hi] = this->row_range(v);
+                offsets[v + 1] = offsets[v] + (hi - lo);
+            }
+            auto targets = std::vector<Vertex>(offsets[n]);
+            const auto chunks = std::min(4 * (pool.size() + 1), n / 1024 + 1);
+            parallel_for(pool, n, chunks, [&](std::size_t, std::size_t lo, std::size_t hi) {
+                for (auto v = lo; v != hi; ++v) {
+                    const auto row = this->neighbors(static_cast<Vertex>(v));
+                    std::copy(row.begin(), row.end(), targets.begin() + offsets[v]);
+                }
+            });
+            return Csr(std::move(offsets), std::move(targets));
+        }
+
+        // ---- BGL interface (found by argument-dependent lookup) ----
+
+        friend auto num_vertices(const DynamicSnapshot& gra) noexcept -> std::size_t {
+            return gra._n;
+        }
+
+        friend auto num_edges(const DynamicSnapshot& gra) noexcept -> std::size_t {
+            return gra._m;
+        }
+
+        friend auto vertices(const DynamicSnapshot& gra)
+            -> std::pair<vertex_iterator, vertex_iterator> {
+            return {vertex_iterator{Vertex{0}}, vertex_iterator{static_cast<Vertex>(gra._n)}};
+        }
+
+        friend auto edges(const DynamicSnapshot& gra) -> std::pair<edge_iterator, edge_iterator> {
+            return {edge_iterator{&gra, 0}, edge_iterator{&gra, gra._n}};
+        }
+
+        friend auto out_edges(Vertex v, const DynamicSnapshot& gra)
+            -> std::pair<out_edge_iterator, out_edge_iterator> {
+            const auto [lo, hi] = gra.row_range(v);
+            return {out_edge_iterator{v, lo}, out_edge_iterator{v, hi}};
+        }
+
+        friend auto out_degree(Vertex v, const DynamicSnapshot& gra) -> std::size_t {
+            const auto [lo, hi] = gra.row_range(v);
+            return hi - lo;
+        }
+
+        friend auto adjacent_vertices(Vertex v, const DynamicSnapshot& gra)
+            -> std::pair<adjacency_iterator, adjacency_iterator> {
+            const auto row = gra.neighbors(v);
+            return {row.data(), row.data() + row.size()};
+        }
+
+        friend auto source(const edge_descriptor& e, const DynamicSnapshot&) noexcept -> Vertex {
+            return e.src;
+        }
+
+        friend auto target(const edge_descriptor& e, const DynamicSnapshot& gra) -> Vertex {
+            return *gra.target_at(e.idx);
+        }
+
+        friend auto edge(Vertex u, Vertex v, const DynamicSnapshot& gra)
+            -> std::pair<edge_descriptor, bool> {
+            const auto [lo, hi] = gra.row_range(u);
+            const auto row = gra.neighbors(u);
+            const auto it = std::lower_bound(row.begin(), row.end(), v);
+            const auto idx = lo + static_cast<std::size_t>(it - row.begin());
+            return {edge_descriptor{u, idx}, it != row.end() && *it == v};
+        }
+
+        friend auto get(boost::vertex_index_t, const DynamicSnapshot&) noexcept {
+            return boost::typed_identity_property_map<Vertex>{};
+        }
+
+        friend auto get(boost::vertex_index_t, const DynamicSnapshot&, Vertex v) noexcept
+            -> Vertex {
+            return v;
+        }
+
+      private:
+        DynamicSnapshot(std::shared_ptr<const Csr> base, std::shared_ptr<const Patch> patch,
+                        std::size_t n, std::size_t pending)
+            : _base{std::move(base)},
+              _patch{std::move(patch)},
+              _n{n},
+              _pending{pending} {
+            // The base edges, with the rows of the touched vertices replaced
+            const auto rows = this->_base->row_offsets();
+            this->_m = num_edges(*this->_base);
+            for (auto i = std::size_t{0}; i != this->_patch->touched.size(); ++i) {
+                const auto v = std::size_t{this->_patch->touched[i]};
+                this->_m += this->_patch->offsets[i + 1] - this->_patch->offsets[i];
+                if (v + 1 < rows.size()) this->_m -= rows[v + 1] - rows[v];
+            }
+        }
+
+        static auto empty_patch() -> std::shared_ptr<const Patch> {
+            return std::make_shared<const Patch>(Patch{{}, {0}, {}});
+        }
+
+        // Positions of the out-edges of `v` among the base and then the patch targets
+        auto row_range(std::size_t v) const -> std::pair<std::size_t, std::size_t> {
+            if (v >= this->_n) throw std::out_of_range("vertex is not in the graph");
+            const auto& touched = this->_patch->touched;
+            const auto it = std::lower_bound(touched.begin(), touched.end(), v);
+            if (it != touched.end() && std::size_t{*it} == v) {
+                const auto i = static_cast<std::size_t>(it - touched.begin());
+                const auto shift = num_edges(*this->_base);
+                return {shift + this->_patch->offsets[i], shift + this->_patch->offsets[i + 1]};
+            }
+            if (v >= num_vertices(*this->_base)) return {0, 0};
+            const auto rows = this->_base->row_offsets();
+            return {rows[v], rows[v + 1]};
+        }
+
+        auto target_at(std::size_t idx) const -> const Vertex* {
+            const auto base = this->_base->column_indices();
+            return idx < base.size() ? base.data() + idx
+                                     : this->_patch->targets.data() + (idx - base.size());
+        }
+
+        std::shared_ptr<const Csr> _base;  // sorted rows, no repeated edges
+        std::shared_ptr<const Patch> _patch;
+        std::size_t _n{};
+        std::size_t _m{};
+        std::size_t _pending{};
+    };
+
+    /**
+     * @brief Directed graph without parallel edges that changes while it is read.
+     *
+     * Writers call add_edge() / remove_edge() / add_node() from any thread;
+     * readers call snapshot() and work on the returned immutable view, which
+     * later updates never change. Adding an edge that exists, or removing
+     * one that does not, has no effect. Self-loops are allowed.
+     *
+     * @code
+     * auto gra = py::DynamicGraph<>(pool, 1000);
+     * gra.add_edge(0, 1);
+     * const auto snap = gra.snapshot();  // a BGL graph
+     * gra.remove_edge(0, 1);             // snap still has the edge
+     * @endcode
+     *
+     * Updates are buffered in a log. Once `compaction_threshold` updates
+     * are buffered, a compaction is started on the pool, which folds the
+     * log into a new CSR base; snapshot() merges only the updates since.
+     * Writers that get four times the threshold ahead of a running
+     * compaction wait for it, so the log (and the cost of a snapshot) stays
+     * bounded.
+     *
+     * @tparam Vertex Unsigned integral vertex type
+     */
+    template <typename Vertex = std::uint32_t> class DynamicGraph {
+        static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+
+        using Csr = CsrGraph<boost::no_property, Vertex>;
+        using Patch = detail::RowPatch<Vertex>;
+        using Update = detail::EdgeUpdate<Vertex>;
+
+        /// Writers wait for a running compaction at this many times the threshold
+        static constexpr auto stall_factor = std::size_t{4};
+
+      public:
+        using Snapshot = DynamicSnapshot<Vertex>;
+
+        /// Number of buffered updates that starts a background compaction (0 for never)
+        std::size_t compaction_threshold{std::size_t{1} << 16};
+
+        /**
+         * @brief Construct a graph with `num_vertices` vertices and no edges
+         *
+         * @param[in] pool Pool running the compactions (must outlive this object)
+         * @param[in] num_vertices Number of vertices
+         */
+        DynamicGraph(ThreadPool& pool, std::size_t num_vertices)
+            : _pool{pool}, _base{std::make_shared<const Csr>()}, _n{num_vertices} {
+            if (num_vertices > std::size_t{std::numeric_limits<Vertex>::max()}) {
+                throw std::out_of_range("too many vertices for the vertex type");
+            }
+        }
+
+        /**
+         * @brief Construct a graph from an edge list
+         *
+         * @tparam EdgeRange Range of pair-like `(u, v)` values
+         * @throw std::out_of_range if an endpoint is not below `num_vertices`
+         */
+        template <typename EdgeRange>
+        DynamicGraph(ThreadPool& pool, std::size_t num_vertices, const EdgeRange& edges)
+            : DynamicGraph(pool, num_vertices) {
+            this->add_edges_from(edges);
+            this->compact();
+        }
+
+        DynamicGraph(const DynamicGraph&) = delete;
+        DynamicGraph& operator=(const DynamicGraph&) = delete;
+
+        ~DynamicGraph() { this->join(); }
+
+        /**
+         * @brief Append a vertex without edges
+         *
+         * @return Vertex The new vertex
+         */
+        auto add_node() -> Vertex {
+            auto lock = std::lock_guard{this->_mutex};
+            if (this->_n == std::size_t{std::numeric_limits<Vertex>::max()}) {
+                throw std::out_of_range("too many vertices for the vertex type");
+            }
+            ++this->_version;
+            return static_cast<Vertex>(this->_n++);
+        }
+
+        /**
+         * @brief Insert the edge `(u, v)`
+         *
+         * @throw std::out_of_range if `u` or `v` is not a vertex
+         */
+        void add_edge(Vertex u, Vertex v) { this->update(Update{u, v, true}); }
+
+        /**
+         * @brief Delete the edge `(u, v)`
+         *
+         * @throw std::out_of_range if `u` or `v` is not a vertex
+         */
+        void remove_edge(Vertex u, Vertex v) { this->update(Update{u, v, false}); }
+
+        /**
+         * @brief Insert every edge of a range of pair-like `(u, v)` values
+         */
+        template <typename EdgeRange> void add_edges_from(const EdgeRange& edges) {
+            this->update_all(edges, true);
+        }
+
+        /**
+         * @brief Delete every edge of a range of pair-like `(u, v)` values
+         */
+        template <typename EdgeRange> void remove_edges_from(const EdgeRange& edges) {
+            this->update_all(edges, false);
+        }
+
+        /**
+         * @brief Number of vertices
+         */
+        [[nodiscard]] auto number_of_nodes() const -> std::size_t {
+            auto lock = std::lock_guard{this->_mutex};
+            return this->_n;
+        }
+
+        /**
+         * @brief Number of updates not yet folded into the CSR base
+         */
+        [[nodiscard]] auto pending_updates() const -> std::size_t {
+            auto lock = std::lock_guard{this->_mutex};
+            return this->_log.size();
+        }
+
+        /**
+         * @brief Consistent read-only view of the current graph
+         *
+         * Repeated calls without updates in between return the same view.
+         * The cost is linear in the buffered updates and in the degrees of
+         * the vertices they touch.
+         */
+        [[nodiscard]] auto snapshot() const -> Snapshot { return this->take_snapshot().first; }
+
+        /**
+         * @brief Start folding the buffered updates into a new CSR base on the pool
+         *
+         * Does nothing if a compaction is already running. Updates and
+         * snapshots may continue meanwhile.
+         */
+        void compact_async() {
+            {
+                auto lock = std::lock_guard{this->_mutex};
+                if (this->_log.empty() || this->_compacting.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                this->_compacting.store(true, std::memory_order_relaxed);
+            }
+            this->_pool.submit([this] { this->run_compaction(); });
+        }
+
+        /**
+         * @brief Wait until no compaction is running
+         *
+         * @throw The exception of a failed background compaction, if any
+         */
+        void wait() {
+            this->join();
+            auto lock = std::lock_guard{this->_mutex};
+            if (this->_error != nullptr) std::rethrow_exception(std::exchange(this->_error, {}));
+        }
+
+        /**
+         * @brief Fold all buffered updates into a new CSR base before returning
+         */
+        void compact() {
+            for (;;) {
+                this->wait();
+                auto lock = std::lock_guard{this->_mutex};
+                if (this->_log.empty()) return;
+                if (!this->_compacting.load(std::memory_order_relaxed)) {
+                    this->_compacting.store(true, std::memory_order_relaxed);
+                    break;
+                }
+            }
+            this->run_compaction();
+            this->wait();
+        }
+
+      private:
+        auto check(std::size_t v) const -> Vertex {
+            if (v >= this->_n) throw std::out_of_range("vertex is not in the graph");
+            return static_cast<Vertex>(v);
+        }
+
+        // Append to the log; the caller holds the lock
+        void push(const Update& update) {
+            this->_log.push_back(update);
+            ++this->_version;
+        }
+
+        void update(const Update& update) {
+            auto lock = std::unique_lock{this->_mutex};
+            this->check(update.u);
+            this->check(update.v);
+            this->push(update);
+            this->maybe_compact(lock);
+        }
+
+        template <typename EdgeRange> void update_all(const EdgeRange& edges, bool insert) {
+            auto lock = std::unique_lock{this->_mutex};
+            for (const auto& [u, v] : edges) {
+                this->check(static_cast<std::size_t>(u));
+                this->check(static_cast<std::size_t>(v));
+            }
+            for (const auto& [u, v] : edges) {
+                this->push(Update{static_cast<Vertex>(u), static_cast<Vertex>(v), insert});
+            }
+            this->maybe_compact(lock);
+        }
+
+        // Start a compaction once enough updates are buffered. Writers that
+        // outrun a running compaction by far wait for it, which bounds the log.
+        void maybe_compact(std::unique_lock<std::mutex>& lock) {
+            const auto threshold = this->compaction_threshold;
+            if (threshold == 0 || this->_log.size() < threshold) return;
+            const auto running = this->_compacting.load(std::memory_order_relaxed);
+            if (running && this->_log.size() < stall_factor * threshold) return;
+            lock.unlock();
+            if (running) this->join();
+            this->compact_async();
+        }
+
+        // The current snapshot and the number of log entries it covers
+        auto take_snapshot() const -> std::pair<Snapshot, std::size_t> {
+            auto lock = std::unique_lock{this->_mutex};
+            if (this->_cache_version == this->_version) {
+                return {this->_cache, this->_log.size()};
+            }
+            const auto version = this->_version;
+            auto base = this->_base;
+            auto log = this->_log;
+            const auto n = this->_n;
+            lock.unlock();
+
+            auto patch = merge_log(*base, log);
+            auto result = Snapshot(std::move(base), std::move(patch), n, log.size());
+
+            lock.lock();
+            if (this->_version == version) {
+                this->_cache = result;
+                this->_cache_version = version;
+            }
+            return {std::move(result), log.size()};
+        }
+
+        // Merged rows of `base` and the last update of every edge in `log`
+        static auto merge_log(const Csr& base, std::vector<Update>& log)
+            -> std::shared_ptr<const Patch> {
+            std::stable_sort(log.begin(), log.end(), [](const Update& a, const Update& b) {
+                return a.u < b.u || (a.u == b.u && a.v < b.v);
+            });
+            auto patch = Patch{{}, {0}, {}};
+            for (auto i = std::size_t{0}; i != log.size();) {
+                const auto u = log[i].u;
+                auto j = i;
+                while (j != log.size() && log[j].u == u) ++j;
+                auto row = std::span<const Vertex>{};
+                if (std::size_t{u} < num_vertices(base)) {
+                    const auto [first, last] = adjacent_vertices(u, base);
+                    row = {first, last};
+                }
+                // Merge the sorted row with the updates of u, the last one of each edge winning
+                auto k = std::size_t{0};
+                while (i != j) {
+                    const auto v = log[i].v;
+                    while (i + 1 != j && log[i + 1].v == v) ++i;
+                    for (; k != row.size() && row[k] < v; ++k) patch.targets.push_back(row[k]);
+                    if (k != row.size() && row[k] == v) ++k;
+                    if (log[i].insert) patch.targets.push_back(v);
+                    ++i;
+                }
+                patch.targets.insert(patch.targets.end(), row.begin() + k, row.end());
+                patch.touched.push_back(u);
+                patch.offsets.push_back(patch.targets.size());
+            }
+            return std::make_shared<const Patch>(std::move(patch));
+        }
+
+        void run_compaction() noexcept {
+            try {
+                const auto [snap, covered] = this->take_snapshot();
+                auto base = std::make_shared<const Csr>(snap.to_csr(this->_pool));
+                auto lock = std::lock_guard{this->_mutex};
+                this->_log.erase(this->_log.begin(),
+                                 this->_log.begin() + static_cast<std::ptrdiff_t>(covered));
+                this->_base = std::move(base);
+                ++this->_version;
+            } catch (...) {
+                auto lock = std::lock_guard{this->_mutex};
+                this->_error = std::current_exception();
+            }
+            this->_compacting.store(false, std::memory_order_release);
+        }
+
+        // Wait for a running compaction, helping the pool meanwhile
+        void join() noexcept {
+            while (this->_compacting.load(std::memory_order_acquire)) {
+                if (!this->_pool.run_one()) std::this_thread::yield();
+            }
+        }
+
+        ThreadPool& _pool;
+        mutable std::mutex _mutex{};
+        std::shared_ptr<const Csr> _base;
+        std::vector<Update> _log{};  // updates since _base, oldest first
+        std::size_t _n;
+        std::size_t _version{0};  // count of changes, for the snapshot cache
+        mutable Snapshot _cache{};
+        mutable std::size_t _cache_version{static_cast<std::size_t>(-1)};
+        std::atomic<bool> _compacting{false};
+        std::exception_ptr _error{};
+    };
+
+}  // namespace py
+
+namespace boost {
+
+    template <typename Vertex> struct property_map<py::DynamicSnapshot<Vertex>, vertex_index_t> {
+        using type = typed_identity_property_map<Vertex>;
+        using const_type = type;
+    };
+
+}  // namespace boost
@@ -0,0 +1,351 @@
+/**
+ * @file edgelist.hpp
+ * @brief Parallel reader for NetworkX edge-list files
+ *
+ * Provides read_edgelist(), which loads the text written by NetworkX's
+ * `write_edgelist` and `write_weighted_edgelist` into a CsrGraph. The file
+ * is memory-mapped and cut into chunks at line boundaries; the chunks are
+ * parsed with std::from_chars on a ThreadPool and the edges go straight
+ * into the parallel CsrGraph constructor.
+ *
+ * @code
+ * py::ThreadPool pool;
+ * auto result = py::read_edgelist<double>(pool, "roads.edgelist");
+ * auto G = py::GrAdaptor<py::CsrGraph<double>>(std::move(result.graph));
+ * std::cout << result.stats.megabytes_per_second() << " MB/s\n";
+ * @endcode
+ *
+ * POSIX only (mmap).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "mapped_file.hpp"
+#include "thread_pool.hpp"
+
+namespace py {
+
+    /**
+     * @brief How read_edgelist() turns node labels and lines into a graph
+     */
+    struct EdgeListOptions {
+        /// Number the distinct labels 0 .. n-1 in increasing order; otherwise
+        /// the labels themselves are the vertices (and must not be negative)
+        bool relabel{true};
+        /// Store every line as one edge; otherwise as both directions
+        bool directed{true};
+    };
+
+    /**
+     * @brief What read_edgelist() did and how fast
+     */
+    struct EdgeListStats {
+        std::size_t bytes{0};  ///< size of the file
+        std::size_t edges{0};  ///< number of edge lines
+        double seconds{0.0};   ///< wall time, including the CSR construction
+
+        /**
+         * @brief Parsing throughput in megabytes (10^6 bytes) per second
+         */
+        [[nodiscard]] auto megabytes_per_second() const noexcept -> double {
+            return this->seconds > 0.0 ? static_cast<double>(this->bytes) / 1e6 / this->seconds
+                                       : 0.0;
+        }
+    };
+
+    /**
+     * @brief Result of read_edgelist()
+     *
+     * @tparam Weight Edge weight type (`boost::no_property` for none)
+     * @tparam Vertex Vertex type of the graph
+     */
+    template <typename Weight, typename Vertex> struct EdgeListGraph {
+        CsrGraph<Weight, Vertex> graph;
+        std::vector<std::int64_t> labels;  ///< label of every vertex (empty unless relabelled)
+        EdgeListStats stats;
+    };
+
+    namespace detail {
+
+        template <typename Weight> struct EdgeListChunk {
+            std::vector<std::pair<std::int64_t, std::int64_t>> edges{};
+            std::vector<Weight> weights{};
+            std::vector<std::int64_t> labels{};  // sorted distinct labels of the chunk
+            std::size_t offset{0};               // first output slot of the chunk
+            std::int64_t low{std::numeric_limits<std::int64_t>::max()};
+            std::int64_t high{std::numeric_limits<std::int64_t>::min()};
+        };
+
+        inline auto edgelist_blank(const char* first, const char* last) noexcept -> const char* {
+            while (first != last && (*first == ' ' || *first == '\t' || *first == '\r')) {
+                ++first;
+            }
+            return first;
+        }
+
+        // Start of the first line at or after `pos`
+        inline auto edgelist_line_start(std::string_view text, std::size_t pos) noexcept
+            -> std::size_t {
+            if (pos == 0 || pos >= text.size()) return std::min(pos, text.size());
+            const auto newline = text.find('\n', pos - 1);
+            return newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+
+        // Weight of a line: a plain number or the "weight" entry of a data
+        // dictionary such as {'weight': 2.5}; 1 when there is none
+        inline auto edgelist_weight(const char* first, const char* last, bool& ok) -> double {
+            auto value = 1.0;
+            if (first == last) return value;
+            if (*first == '{') {
+                const auto data = std::string_view{first, static_cast<std::size_t>(last - first)};
+                const auto key = data.find("weight");
+                if (key == std::string_view::npos) return value;
+                const auto colon = data.find(':', key);
+                if (colon == std::string_view::npos) {
+                    ok = false;
+                    return value;
+                }
+                first = edgelist_blank(first + colon + 1, last);
+            }
+            const auto [ptr, ec] = std::from_chars(first, last, value);
+            ok = ec == std::errc{};
+            return value;
+        }
+
+        template <typename Weight>
+        void edgelist_parse(std::string_view text, std::size_t lo, std::size_t hi,
+                            EdgeListChunk<Weight>& chunk, const std::string& path) {
+            constexpr auto weighted = !std::is_same_v<Weight, boost::no_property>;
+            const auto* base = text.data();
+            const auto* cur = base + lo;
+            const auto* end = base + hi;
+            while (cur != end) {
+                const auto* eol = static_cast<const char*>(
+                    std::memchr(cur, '\n', static_cast<std::size_t>(end - cur)));
+                if (eol == nullptr) eol = end;
+                const auto* stop = std::find(cur, eol, '#');
+                const auto* ptr = edgelist_blank(cur, stop);
+                if (ptr != stop) {
+                    auto u = std::int64_t{};
+                    auto v = std::int64_t{};
+                    auto res = std::from_chars(ptr, stop, u);
+                    auto ok = res.ec == std::errc{};
+                    if (ok) {
+                        ptr = edgelist_blank(res.ptr, stop);
+                        res = std::from_chars(ptr, stop, v);
+                        ok = res.ec == std::errc{};
+                    }
+                    if constexpr (weighted) {
+                        if (ok) {
+                            const auto w = edgelist_weight(edgelist_blank(res.ptr, stop), stop, ok);
+                            chunk.weights.push_back(static_cast<Weight>(w));
+                        }
+                    }
+                    if (!ok) {
+                        throw std::runtime_error(path + ": malformed edge at byte "
+                                                 + std::to_string(cur - base));
+                    }
+                    chunk.edges.emplace_back(u, v);
+                    chunk.low = std::min({chunk.low, u, v});
+                    chunk.high = std::max({chunk.high, u, v});
+                }
+                cur = eol == end ? end : eol + 1;
+            }
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Read a NetworkX edge list into a CsrGraph using all workers
+     *
+     * Every non-empty line holds two integer node labels, optionally
+     * followed by a weight: a plain number (`write_weighted_edgelist`) or a
+     * data dictionary with a `'weight'` entry (`write_edgelist`). Lines
+     * without a weight get weight 1. Text after `#` is a comment. Edges
+     * keep the order of the file.
+     *
+     * With `options.relabel` (the default) the distinct labels are
+     * numbered `0 .. n-1` in increasing order and `labels[v]` is the label
+     * of vertex `v`; labels that already are `0 .. n-1` map to themselves.
+     *
+     * @tparam Weight Arithmetic weight type, or `boost::no_property` to ignore weights
+     * @tparam Vertex Vertex type of the graph
+     * @param[in] pool Pool doing the parsing
+     * @param[in] path File name
+     * @param[in] options Labelling and direction
+     * @return EdgeListGraph<Weight, Vertex>
+     * @throw std::system_error if the file cannot be mapped
+     * @throw std::runtime_error if a line is malformed
+     * @throw std::out_of_range if a label does not fit the vertex type
+     */
+    template <typename Weight = boost::no_property, typename Vertex = std::uint32_t>
+    auto read_edgelist(ThreadPool& pool, const std::string& path, EdgeListOptions options = {})
+        -> EdgeListGraph<Weight, Vertex> {
+        constexpr auto weighted = !std::is_same_v<Weight, boost::no_property>;
+        static_assert(!weighted || std::is_arithmetic_v<Weight>, "weights must be numbers");
+        using Chunk = detail::EdgeListChunk<Weight>;
+        const auto start = std::chrono::steady_clock::now();
+
+        const auto file = MappedFile{path};
+        file.advise_sequential();
+        const auto text = std::string_view{file.chars().data(), file.size()};
+
+        // Parse
+        constexpr auto min_chunk = std::size_t{1} << 16;
+        const auto workers = pool.size() + 1;
+        const auto num_chunks
+            = std::max(std::size_t{1}, std::min(4 * workers, text.size() / min_chunk));
+        auto chunks = std::vector<Chunk>(num_chunks);
+        parallel_for(pool, text.size(), num_chunks,
+                     [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                         detail::edgelist_parse(text, detail::edgelist_line_start(text, lo),
+                                                detail::edgelist_line_start(text, hi), chunks[c],
+                                                path);
+                     });
+
+        auto m = std::size_t{0};
+        for (auto& chunk : chunks) {
+            chunk.offset = m;
+            m += chunk.edges.size();
+        }
+
+        const auto for_each_chunk = [&](auto&& body) {
+            parallel_for(pool, num_chunks, num_chunks,
+                         [&](std::size_t c, std::size_t, std::size_t) { body(chunks[c]); });
+        };
+        auto low = std::numeric_limits<std::int64_t>::max();
+        auto high = std::numeric_limits<std::int64_t>::min();
+        for (const auto& chunk : chunks) {
+            low = std::min(low, chunk.low);
+            high = std::max(high, chunk.high);
+        }
+
+        // Label the vertices. Labels from a range not much wider than the
+        // edge count are numbered through a table indexed by label, other
+        // labels by sorting and merging the distinct labels of every chunk.
+        auto labels = std::vector<std::int64_t>{};
+        auto table = std::vector<std::atomic<Vertex>>{};
+        auto n = std::size_t{0};
+        const auto width
+            = m == 0 ? 0 : static_cast<std::uint64_t>(high) - static_cast<std::uint64_t>(low);
+        const auto dense = options.relabel && m != 0 && width / 4 < m;
+        if (dense) {
+            table = std::vector<std::atomic<Vertex>>(static_cast<std::size_t>(width) + 1);
+            for_each_chunk([&](const Chunk& chunk) {
+                for (const auto& [u, v] : chunk.edges) {
+                    table[static_cast<std::size_t>(u - low)].store(1, std::memory_order_relaxed);
+                    table[static_cast<std::size_t>(v - low)].store(1, std::memory_order_relaxed);
+                }
+            });
+            for (auto i = std::size_t{0}; i != table.size(); ++i) {
+                if (table[i].load(std::memory_order_relaxed) != 0) {
+                    labels.push_back(low + static_cast<std::int64_t>(i));
+                }
+            }
+            n = labels.size();
+            if (n <= std::size_t{std::numeric_limits<Vertex>::max()}) {
+                for (auto id = std::size_t{0}; id != n; ++id) {
+                    table[static_cast<std::size_t>(labels[id] - low)].store(
+                        static_cast<Vertex>(id), std::memory_order_relaxed);
+                }
+            }
+        } else if (options.relabel) {
+            for_each_chunk([](Chunk& chunk) {
+                chunk.labels.reserve(2 * chunk.edges.size());
+                for (const auto& [u, v] : chunk.edges) {
+                    chunk.labels.push_back(u);
+                    chunk.labels.push_back(v);
+                }
+                std::sort(chunk.labels.begin(), chunk.labels.end());
+                chunk.labels.erase(std::unique(chunk.labels.begin(), chunk.labels.end()),
+                                   chunk.labels.end());
+            });
+            auto parts = std::vector<std::vector<std::int64_t>>{};
+            parts.reserve(num_chunks);
+            for (auto& chunk : chunks) {
+                parts.push_back(std::move(chunk.labels));
+            }
+            while (parts.size() > 1) {  // merge pairwise, one level per round
+                auto merged = std::vector<std::vector<std::int64_t>>((parts.size() + 1) / 2);
+                parallel_for(pool, merged.size(), merged.size(),
+                             [&](std::size_t i, std::size_t, std::size_t) {
+                                 if (2 * i + 1 == parts.size()) {
+                                     merged[i] = std::move(parts[2 * i]);
+                                     return;
+                                 }
+                                 const auto& a = parts[2 * i];
+                                 const auto& b = parts[2 * i + 1];
+                                 merged[i].reserve(a.size() + b.size());
+                                 std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                                                std::back_inserter(merged[i]));
+                             });
+                parts = std::move(merged);
+            }
+            labels = std::move(parts.front());
+            n = labels.size();
+        } else if (m != 0) {
+            if (low < 0) throw std::out_of_range(path + ": negative node label");
+            n = static_cast<std::size_t>(high) + 1;
+        }
+        if (n > std::size_t{std::numeric_limits<Vertex>::max()}) {
+            throw std::out_of_range(path + ": too many vertices for the vertex type");
+        }
+
+        // Collect the edges in file order
+        const auto copies = options.directed ? std::size_t{1} : std::size_t{2};
+        auto edges = std::vector<std::pair<Vertex, Vertex>>(copies * m);
+        auto weights = std::vector<Weight>{};
+        if constexpr (weighted) weights.resize(copies * m);
+        const auto vertex = [&](std::int64_t label) {
+            if (!options.relabel) return static_cast<Vertex>(label);
+            if (dense) {
+                return table[static_cast<std::size_t>(label - low)].load(std::memory_order_relaxed);
+            }
+            const auto it = std::lower_bound(labels.begin(), labels.end(), label);
+            return static_cast<Vertex>(it - labels.begin());
+        };
+        for_each_chunk([&](Chunk& chunk) {
+            auto pos = copies * chunk.offset;
+            for (auto i = std::size_t{0}; i != chunk.edges.size(); ++i) {
+                const auto u = vertex(chunk.edges[i].first);
+                const auto v = vertex(chunk.edges[i].second);
+                edges[pos] = {u, v};
+                if constexpr (weighted) weights[pos] = chunk.weights[i];
+                ++pos;
+                if (!options.directed) {
+                    edges[pos] = {v, u};
+                    if constexpr (weighted) weights[pos] = chunk.weights[i];
+                    ++pos;
+                }
+            }
+            chunk = Chunk{};
+        });
+
+        auto result = EdgeListGraph<Weight, Vertex>{
+            CsrGraph<Weight, Vertex>(pool, n, edges, weights), std::move(labels), {}};
+        result.stats.bytes = text.size();
+        result.stats.edges = m;
+        result.stats.seconds
+            = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+}  // namespace py
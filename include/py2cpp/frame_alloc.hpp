@@ -0,0 +1,267 @@
+/**
+ * @file frame_alloc.hpp
+ * @brief Recycling allocator for C++20 coroutine frames
+ *
+ * Provides a thread-local size-class FramePool and a FrameAllocated base
+ * for promise types, so that short-lived coroutine frames are recycled
+ * instead of going through the global heap on every call. Promise types
+ * deriving from FrameAllocated also accept a user allocator (for example a
+ * std::pmr::polymorphic_allocator over an arena) passed with
+ * std::allocator_arg as the leading coroutine argument.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace py {
+
+    /**
+     * @brief Thread-local size-class free-list pool for coroutine frames.
+     *
+     * Frames are grouped into size classes of `granularity` bytes. Freed
+     * blocks are kept on a per-class free list (up to `max_cached` blocks per
+     * class) and handed out again on the next allocation of the same class.
+     * Blocks larger than the largest class go straight to the global heap.
+     *
+     * Every cached block comes from the global `operator new`, so a frame
+     * allocated on one thread may safely be released into another thread's
+     * pool.
+     */
+    class FramePool {
+      public:
+        static constexpr std::size_t granularity = 64;
+        static constexpr std::size_t num_classes = 16;
+        static constexpr std::size_t max_cached = 256;
+
+        FramePool() noexcept = default;
+        ~FramePool() { this->release(); }
+
+        FramePool(const FramePool&) = delete;
+        FramePool& operator=(const FramePool&) = delete;
+
+        /**
+         * @brief The pool of the calling thread
+         *
+         * @return FramePool& Thread-local pool instance
+         */
+        static auto local() noexcept -> FramePool& {
+            thread_local FramePool pool;
+            return pool;
+        }
+
+        /**
+         * @brief Allocate a block of at least `size` bytes
+         *
+         * @param[in] size Number of bytes requested (must be non-zero)
+         * @return void* Block aligned to the default new alignment
+         */
+        [[nodiscard]] auto allocate(std::size_t size) -> void* {
+            const auto idx = size_class(size);
+            if (idx >= num_classes) {
+                return ::operator new(size);
+            }
+            auto& bin = this->_bins[idx];
+            if (bin.head != nullptr) {
+                auto* blk = bin.head;
+                bin.head = blk->next;
+                --bin.count;
+                blk->~Block();
+                return blk;
+            }
+            return ::operator new(class_size(idx));
+        }
+
+        /**
+         * @brief Return a block previously obtained from allocate()
+         *
+         * @param[in] ptr Block to release
+         * @param[in] size The size passed to allocate()
+         */
+        void deallocate(void* ptr, std::size_t size) noexcept {
+            const auto idx = size_class(size);
+            if (idx >= num_classes) {
+                ::operator delete(ptr, size);
+                return;
+            }
+            auto& bin = this->_bins[idx];
+            if (bin.count == max_cached) {
+                ::operator delete(ptr, class_size(idx));
+                return;
+            }
+            bin.head = ::new (ptr) Block{bin.head};
+            ++bin.count;
+        }
+
+        /**
+         * @brief Number of blocks currently held on the free lists
+         *
+         * @return std::size_t Total cached blocks over all size classes
+         */
+        [[nodiscard]] auto cached_blocks() const noexcept -> std::size_t {
+            auto total = std::size_t{0};
+            for (const auto& bin : this->_bins) {
+                total += bin.count;
+            }
+            return total;
+        }
+
+        /**
+         * @brief Give all cached blocks back to the global heap
+         */
+        void release() noexcept {
+            for (auto idx = std::size_t{0}; idx != num_classes; ++idx) {
+                auto& bin = this->_bins[idx];
+                while (bin.head != nullptr) {
+                    auto* blk = bin.head;
+                    bin.head = blk->next;
+                    blk->~Block();
+                    ::operator delete(static_cast<void*>(blk), class_size(idx));
+                }
+                bin.count = 0;
+            }
+        }
+
+      private:
+        struct Block {
+            Block* next;
+        };
+
+        struct Bin {
+            Block* head = nullptr;
+            std::size_t count = 0;
+        };
+
+        static constexpr auto size_class(std::size_t size) noexcept -> std::size_t {
+            return (size - 1) / granularity;
+        }
+
+        static constexpr auto class_size(std::size_t idx) noexcept -> std::size_t {
+            return (idx + 1) * granularity;
+        }
+
+        std::array<Bin, num_classes> _bins{};
+    };
+
+    /**
+     * @brief Allocator-aware frame allocation for coroutine promise types.
+     *
+     * Deriving a promise type from FrameAllocated gives its coroutine frames
+     * the following allocation policy:
+     *
+     * - By default frames come from the calling thread's FramePool.
+     * - If the coroutine's first parameter is `std::allocator_arg_t`
+     *   (or the second, for member functions), the frame is allocated from
+     *   the allocator that follows it. A copy of the allocator is stored
+     *   behind the frame so it can be released on destruction.
+     *
+     * The deallocation routine is recorded in a small trailer behind each
+     * frame, so both kinds of frame can be released through the same
+     * `operator delete`.
+     *
+     * GCC pairs the templated allocator-aware `operator new` with that
+     * `operator delete` and may report a spurious -Wmismatched-new-delete at
+     * the end of an allocator-aware coroutine, or, once the deallocation is
+     * inlined, at a replaced global `operator delete`. This can happen at any
+     * optimization level. The diagnostic is issued in user code, so it has
+     * to be silenced around those definitions rather than here.
+     */
+    class FrameAllocated {
+      public:
+        static auto operator new(std::size_t size) -> void* {
+            void* ptr = FramePool::local().allocate(pool_size(size));
+            store_deallocator(ptr, size, &pool_deallocate);
+            return ptr;
+        }
+
+        template <typename Alloc, typename... Args>
+        static auto operator new(std::size_t size, std::allocator_arg_t, const Alloc& alloc,
+                                 const Args&...) -> void* {
+            return allocate_with(alloc, size);
+        }
+
+        template <typename This, typename Alloc, typename... Args>
+        static auto operator new(std::size_t size, const This&, std::allocator_arg_t,
+                                 const Alloc& alloc, const Args&...) -> void* {
+            return allocate_with(alloc, size);
+        }
+
+        static void operator delete(void* ptr, std::size_t size) noexcept {
+            Deallocator fn = nullptr;
+            std::memcpy(&fn, static_cast<std::byte*>(ptr) + trailer_offset(size), sizeof(fn));
+            fn(ptr, size);
+        }
+
+      private:
+        using Deallocator = void (*)(void*, std::size_t) noexcept;
+
+        struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) AlignedBlock {
+            std::byte bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+        };
+
+        static constexpr auto align_up(std::size_t n, std::size_t align) noexcept -> std::size_t {
+            return (n + align - 1) & ~(align - 1);
+        }
+
+        static constexpr auto trailer_offset(std::size_t size) noexcept -> std::size_t {
+            return align_up(size, alignof(Deallocator));
+        }
+
+        static constexpr auto pool_size(std::size_t size) noexcept -> std::size_t {
+            return trailer_offset(size) + sizeof(Deallocator);
+        }
+
+        template <typename BlockAlloc>
+        static constexpr auto alloc_offset(std::size_t size) noexcept -> std::size_t {
+            return align_up(pool_size(size), alignof(BlockAlloc));
+        }
+
+        template <typename BlockAlloc>
+        static constexpr auto num_blocks(std::size_t size) noexcept -> std::size_t {
+            const auto total = alloc_offset<BlockAlloc>(size) + sizeof(BlockAlloc);
+            return (total + sizeof(AlignedBlock) - 1) / sizeof(AlignedBlock);
+        }
+
+        static void store_deallocator(void* ptr, std::size_t size, Deallocator fn) noexcept {
+            std::memcpy(static_cast<std::byte*>(ptr) + trailer_offset(size), &fn, sizeof(fn));
+        }
+
+        static void pool_deallocate(void* ptr, std::size_t size) noexcept {
+            FramePool::local().deallocate(ptr, pool_size(size));
+        }
+
+        template <typename Alloc> static auto allocate_with(const Alloc& alloc, std::size_t size)
+            -> void* {
+            using BlockAlloc =
+                typename std::allocator_traits<Alloc>::template rebind_alloc<AlignedBlock>;
+            using Traits = std::allocator_traits<BlockAlloc>;
+            static_assert(alignof(BlockAlloc) <= alignof(AlignedBlock),
+                          "over-aligned frame allocators are not supported");
+
+            auto balloc = BlockAlloc(alloc);
+            void* ptr = std::to_address(Traits::allocate(balloc, num_blocks<BlockAlloc>(size)));
+            void* slot = static_cast<std::byte*>(ptr) + alloc_offset<BlockAlloc>(size);
+            ::new (slot) BlockAlloc(std::move(balloc));
+            store_deallocator(ptr, size, &alloc_deallocate<BlockAlloc>);
+            return ptr;
+        }
+
+        template <typename BlockAlloc>
+        static void alloc_deallocate(void* ptr, std::size_t size) noexcept {
+            using Traits = std::allocator_traits<BlockAlloc>;
+            void* slot = static_cast<std::byte*>(ptr) + alloc_offset<BlockAlloc>(size);
+            auto* stored = std::launder(static_cast<BlockAlloc*>(slot));
+            auto balloc = BlockAlloc(std::move(*stored));
+            stored->~BlockAlloc();
+            Traits::deallocate(balloc, static_cast<AlignedBlock*>(ptr),
+                               num_blocks<BlockAlloc>(size));
+        }
+    };
+
+}  // namespace py
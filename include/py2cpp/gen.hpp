@@ -11,9 +11,12 @@
 #include <coroutine>
 #include <exception>
 #include <iterator>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
+#include "frame_alloc.hpp"
+
 namespace py {
 
     /**
@@ -23,33 +26,77 @@ namespace py {
      * Used with co_yield inside a coroutine function.
      *
      * Supports both value types (Generator<int>) and reference types
-     * (Generator<Container&>), using pointer storage to avoid copies.
+     * (Generator<Container&>). Yielded lvalues are passed by pointer to avoid
+     * copies. For value types, a yielded rvalue is moved into storage inside
+     * the promise, so `co_yield std::move(big)` costs one move and the
+     * consumer may in turn move out of `*it`; this also works for move-only
+     * types.
+     *
+     * An exception escaping the coroutine body is rethrown to the consumer
+     * from begin() or operator++ of the iterator.
+     *
+     * Coroutine frames are recycled through the thread-local FramePool. To
+     * allocate the frame from a custom allocator or arena instead, declare
+     * the coroutine with `std::allocator_arg_t` followed by the allocator as
+     * its leading parameters:
+     *
+     * @code
+     * py::Generator<int> iota(std::allocator_arg_t, std::pmr::polymorphic_allocator<> a, int n);
+     * @endcode
      *
      * @tparam T Value type to yield
      */
     template <typename T> class Generator {
       public:
-        struct promise_type {
+        struct promise_type : FrameAllocated {
             using value_type = std::remove_reference_t<T>;
             using reference_type = std::conditional_t<std::is_reference_v<T>, T, T&>;
             using pointer_type = value_type*;
 
+            static constexpr bool owns_rvalues
+                = !std::is_reference_v<T> && std::is_move_constructible_v<value_type>;
+
+            struct no_storage {};
+            using storage_type
+                = std::conditional_t<owns_rvalues, std::optional<value_type>, no_storage>;
+
             pointer_type m_value{};
+            [[no_unique_address]] storage_type m_storage{};
+            std::exception_ptr m_exception{};
 
             auto yield_value(std::remove_reference_t<T>& value) noexcept {
                 m_value = std::addressof(value);
                 return std::suspend_always{};
             }
 
-            auto yield_value(std::remove_reference_t<T>&& value) noexcept {
-                m_value = std::addressof(value);
+            auto yield_value(std::remove_reference_t<T>&& value) noexcept(
+                !owns_rvalues || std::is_nothrow_move_constructible_v<value_type>) {
+                if constexpr (owns_rvalues) {
+                    m_value = std::addressof(m_storage.emplace(std::move(value)));
+                } else {
+                    m_value = std::addressof(value);
+                }
                 return std::suspend_always{};
             }
 
             auto initial_suspend() noexcept { return std::suspend_always{}; }
             auto final_suspend() noexcept { return std::suspend_always{}; }
             void return_void() noexcept {}
-            void unhandled_exception() noexcept { std::terminate(); }
+            void unhandled_exception() noexcept { m_exception = std::current_exception(); }
+
+            [[nodiscard]] auto owns_value() const noexcept -> bool {
+                if constexpr (owns_rvalues) {
+                    return m_storage.has_value() && m_value == std::addressof(*m_storage);
+                } else {
+                    return false;
+                }
+            }
+
+            void throw_if_exception() {
+                if (m_exception != nullptr) {
+                    std::rethrow_exception(std::exchange(m_exception, nullptr));
+                }
+            }
 
             auto get_return_object() noexcept {
                 return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
@@ -95,7 +142,9 @@ namespace py {
 
             iterator& operator++() {
                 coro_.resume();
-                if (coro_.done()) coro_ = {};
+                if (coro_.done()) {
+                    std::exchange(coro_, {}).promise().throw_if_exception();
+                }
                 return *this;
             }
             void operator++(int) { ++*this; }
@@ -106,6 +155,18 @@ namespace py {
 
             pointer operator->() const noexcept { return std::addressof(operator*()); }
 
+            /**
+             * @brief Whether the current value was yielded as an rvalue
+             *
+             * Such a value lives in the promise and may be moved out of
+             * `*it`; a yielded lvalue still belongs to the coroutine.
+             *
+             * @return true if the generator owns the current value
+             */
+            [[nodiscard]] auto owns_value() const noexcept -> bool {
+                return coro_.promise().owns_value();
+            }
+
             bool operator==(const iterator& other) const noexcept { return coro_ == other.coro_; }
             bool operator!=(const iterator& other) const noexcept { return !(*this == other); }
         };
@@ -113,7 +174,10 @@ namespace py {
         iterator begin() {
             if (!coro_) return iterator{};
             coro_.resume();
-            if (coro_.done()) return iterator{};
+            if (coro_.done()) {
+                coro_.promise().throw_if_exception();
+                return iterator{};
+            }
             return iterator{coro_};
         }
 
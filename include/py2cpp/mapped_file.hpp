@@ -0,0 +1,96 @@
+/**
+ * @file mapped_file.hpp
+ * @brief Whole-file memory mapping
+ *
+ * Provides MappedFile, the mmap wrapper behind open_csr() and
+ * read_edgelist().
+ *
+ * POSIX only (mmap).
+ */
+
+#pragma once
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#    error "py2cpp/mapped_file.hpp requires POSIX (mmap)"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <system_error>
+
+namespace py {
+
+    /**
+     * @brief A private, copy-on-write mapping of a whole file
+     *
+     * The pages are writable, but writes stay in this process and never
+     * reach the file. An empty file maps to an empty range.
+     */
+    class MappedFile {
+        void* _addr{MAP_FAILED};
+        std::size_t _size{0};
+
+      public:
+        /**
+         * @brief Map the file `path`
+         *
+         * @param[in] path File name
+         * @throw std::system_error if the file cannot be opened or mapped
+         */
+        explicit MappedFile(const std::string& path) {
+            const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) throw std::system_error(errno, std::generic_category(), path);
+            struct stat info {};
+            if (::fstat(fd, &info) != 0) {
+                const auto error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), path);
+            }
+            this->_size = static_cast<std::size_t>(info.st_size);
+            if (this->_size == 0) {
+                ::close(fd);
+                return;
+            }
+            this->_addr = ::mmap(nullptr, this->_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            const auto error = errno;
+            ::close(fd);
+            if (this->_addr == MAP_FAILED) {
+                throw std::system_error(error, std::generic_category(), path);
+            }
+        }
+
+        ~MappedFile() {
+            if (this->_addr != MAP_FAILED) ::munmap(this->_addr, this->_size);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Ask the kernel to read the file ahead sequentially
+         */
+        void advise_sequential() const noexcept {
+            if (this->_addr != MAP_FAILED) ::madvise(this->_addr, this->_size, MADV_SEQUENTIAL);
+        }
+
+        [[nodiscard]] auto data() const noexcept -> std::byte* {
+            return this->_addr == MAP_FAILED ? nullptr : static_cast<std::byte*>(this->_addr);
+        }
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return this->_size; }
+
+        /**
+         * @brief The file contents as characters
+         */
+        [[nodiscard]] auto chars() const noexcept -> std::span<const char> {
+            return {reinterpret_cast<const char*>(this->data()), this->_size};
+        }
+    };
+
+}  // namespace py
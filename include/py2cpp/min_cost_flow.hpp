@@ -0,0 +1,703 @@
+/**
+ * @file min_cost_flow.hpp
+ * @brief Minimum-cost flow by the primal network simplex method
+ *
+ * Provides MinCostFlowSolver and the NetworkX-style py::network_simplex()
+ * and py::min_cost_flow(). The solver keeps a spanning tree of basic
+ * edges, every other edge sitting at its lower bound (no flow) or its
+ * upper bound (its capacity), and one potential per vertex that makes the
+ * reduced cost `cost - pi[source] + pi[target]` of every tree edge zero.
+ * Each pivot brings in a non-tree edge whose reduced cost can lower the
+ * total, pushes flow around the cycle it closes in the tree, and drops an
+ * edge of that cycle that reaches a bound.
+ *
+ * The start is the NetworkX one: an artificial root joined to every vertex
+ * by an edge of prohibitive cost carrying the vertex's demand. Entering
+ * edges are found by block search: the edges are scanned in blocks of
+ * about `sqrt(m)`, and the most negative reduced cost of the first block
+ * with one enters. Among the blocking edges of a cycle the last one met
+ * from the apex leaves, which keeps the tree strongly feasible and rules
+ * out cycling.
+ *
+ * The tree, flows and potentials stay in the solver, so the next run()
+ * after a small change starts from the last tree. After new costs it
+ * still carries a feasible flow, and primal pivots go on from it. After
+ * new demands or capacities its potentials are still optimal, and dual
+ * pivots (the dual network simplex) move the flow back within bounds.
+ * Costs only need `+`, `-`, `<` and a zero `Cost{}`, and fun::Fraction
+ * costs stay exact.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "nx2bgl.hpp"
+
+namespace py {
+
+    /**
+     * @brief Reusable minimum-cost flow solver over a fixed graph
+     *
+     * Edges are named by id as in NegCycleFinder: the `edge_index` of the
+     * graph when its edges store one, otherwise their position in a CSR
+     * copy of the graph. Demands are indexed by vertex; as in NetworkX a
+     * negative demand is a supply.
+     *
+     * @tparam Cost Edge cost type, such as `std::int64_t` or fun::Fraction
+     * @tparam Vertex Unsigned integral vertex type
+     */
+    template <typename Cost = std::int64_t, typename Vertex = std::uint32_t>
+    class MinCostFlowSolver {
+        static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+
+        static constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+        // Where an edge is: in the tree or at one of its bounds
+        enum State : signed char { upper = -1, tree = 0, lower = 1 };
+
+      public:
+        using Flow = std::int64_t;
+
+        /// Capacity of an edge without an upper bound
+        static constexpr auto infinite = std::numeric_limits<Flow>::max();
+
+        /**
+         * @brief Prepare solving over `gra` (vertices `0 .. n-1`)
+         */
+        template <typename Graph> explicit MinCostFlowSolver(const Graph& gra) {
+            this->build(gra);
+        }
+
+        [[nodiscard]] auto num_vertices() const noexcept -> std::size_t { return this->_n; }
+
+        /**
+         * @brief Number of edge ids (one more than the largest)
+         */
+        [[nodiscard]] auto num_edge_ids() const noexcept -> std::size_t {
+            return this->_by_id.size();
+        }
+
+        /**
+         * @brief Flow on every edge after the last run(), indexed by edge id
+         */
+        [[nodiscard]] auto flow() const noexcept -> std::span<const Flow> { return this->_by_id; }
+
+        /**
+         * @brief Number of pivots of the last run()
+         */
+        [[nodiscard]] auto pivots() const noexcept -> std::size_t { return this->_pivots; }
+
+        /**
+         * @brief Whether the last run() started from the tree of the one before
+         */
+        [[nodiscard]] auto warm_started() const noexcept -> bool { return this->_warm; }
+
+        /**
+         * @brief Find a flow of minimum cost meeting the demands
+         *
+         * The costs and flows must keep their sums well inside the range of
+         * `Cost`: the artificial edges cost one more than the total of
+         * `|cost|`.
+         *
+         * @param[in] demand Demand of every vertex; negative for a supply
+         * @param[in] capacity Capacity of every edge (non-negative, or
+         *            `infinite`), indexed by edge id
+         * @param[in] cost Cost per unit of flow of every edge, indexed by edge id
+         * @return Cost The total cost of the flow, which flow() then holds
+         * @throw std::invalid_argument if an array is too short, a capacity
+         *        is negative, the demands do not add up to zero, no flow
+         *        meets them, or a cycle of negative cost has infinite
+         *        capacity
+         */
+        auto run(std::span<const Flow> demand, std::span<const Flow> capacity,
+                 std::span<const Cost> cost) -> Cost {
+            const auto n = this->_n;
+            const auto m = this->_m;
+            if (demand.size() < n || capacity.size() < this->num_edge_ids()
+                || cost.size() < this->num_edge_ids()) {
+                throw std::invalid_argument("need one demand per vertex and one capacity "
+                                            "and cost per edge id");
+            }
+            auto balance = Flow{0};
+            for (auto v = std::size_t{0}; v != n; ++v) balance += demand[v];
+            if (balance != 0) throw std::invalid_argument("total demand is not zero");
+            auto big = Cost(Flow{1});
+            for (auto e = std::size_t{0}; e != m; ++e) {
+                const auto id = this->_ids[e];
+                if (capacity[id] < 0) throw std::invalid_argument("negative capacity");
+                this->_cap[e] = capacity[id];
+                this->_cost[e] = cost[id];
+                big = big + (cost[id] < Cost{} ? -cost[id] : cost[id]);
+            }
+            for (auto v = std::size_t{0}; v != n; ++v) this->_cost[m + v] = big;
+
+            this->_pivots = 0;
+            this->_warm = this->_started && this->restart(demand);
+            if (!this->_warm) {
+                this->start(demand);
+                this->update_all_potentials();
+            }
+            this->_started = true;
+            this->solve();
+
+            for (auto v = std::size_t{0}; v != n; ++v) {
+                if (this->_flow[m + v] != 0) {
+                    throw std::invalid_argument("no flow satisfies the demands");
+                }
+            }
+            auto total = Cost{};
+            std::fill(this->_by_id.begin(), this->_by_id.end(), Flow{0});
+            for (auto e = std::size_t{0}; e != m; ++e) {
+                this->_by_id[this->_ids[e]] = this->_flow[e];
+                if (this->_flow[e] != 0) total = total + this->_cost[e] * this->_flow[e];
+            }
+            return total;
+        }
+
+      private:
+        template <typename Graph> void build(const Graph& gra) {
+            auto offsets = std::vector<std::size_t>{};
+            auto targets = std::vector<Vertex>{};
+            detail::csr_fill(gra, offsets, targets, [&](std::size_t pos, const auto& e) {
+                if constexpr (detail::stores_edge_index<Graph>::value) {
+                    if (this->_ids.empty()) this->_ids.resize(targets.size());
+                    this->_ids[pos] = detail::bgl_edge_index(e, gra);
+                }
+            });
+            this->_n = offsets.size() - 1;
+            this->_m = targets.size();
+            if (this->_ids.empty()) {
+                this->_ids.resize(this->_m);
+                for (auto pos = std::size_t{0}; pos != this->_m; ++pos) this->_ids[pos] = pos;
+            }
+            auto num_ids = std::size_t{0};
+            for (const auto id : this->_ids) num_ids = std::max(num_ids, id + 1);
+            this->_by_id.assign(num_ids, Flow{0});
+
+            // Edges `0 .. m-1` are those of the graph, `m + v` the artificial one of `v`
+            const auto edges = this->_m + this->_n;
+            this->_source.resize(edges);
+            this->_target.resize(edges);
+            for (auto u = std::size_t{0}; u != this->_n; ++u) {
+                for (auto pos = offsets[u]; pos != offsets[u + 1]; ++pos) {
+                    this->_source[pos] = static_cast<Vertex>(u);
+                    this->_target[pos] = targets[pos];
+                }
+            }
+            this->_cost.resize(edges);
+            this->_cap.assign(edges, infinite);
+            this->_flow.resize(edges);
+            this->_state.resize(edges);
+            const auto nodes = this->_n + 1;
+            this->_pi.resize(nodes);
+            this->_parent.resize(nodes);
+            this->_pred.resize(nodes);
+            this->_size.resize(nodes);
+            this->_next.resize(nodes);
+            this->_prev.resize(nodes);
+            this->_last.resize(nodes);
+            this->_excess.resize(nodes);
+            this->_mark.assign(nodes, 0);
+            this->_incident_offsets.assign(nodes + 1, 0);
+            const auto end_of = [&](std::size_t e, bool second) {
+                if (e >= this->_m) return second ? this->_n : e - this->_m;
+                return std::size_t{second ? this->_target[e] : this->_source[e]};
+            };
+            for (auto e = std::size_t{0}; e != edges; ++e) {
+                ++this->_incident_offsets[end_of(e, false) + 1];
+                ++this->_incident_offsets[end_of(e, true) + 1];
+            }
+            for (auto v = std::size_t{0}; v != nodes; ++v) {
+                this->_incident_offsets[v + 1] += this->_incident_offsets[v];
+            }
+            this->_incident.resize(2 * edges);
+            auto fill = std::vector<std::size_t>(this->_incident_offsets.begin(),
+                                                 this->_incident_offsets.end() - 1);
+            for (auto e = std::size_t{0}; e != edges; ++e) {
+                this->_incident[fill[end_of(e, false)]++] = e;
+                this->_incident[fill[end_of(e, true)]++] = e;
+            }
+        }
+
+        // Cold start: every vertex hangs off the root `n` by its artificial edge
+        void start(std::span<const Flow> demand) {
+            const auto n = this->_n;
+            const auto m = this->_m;
+            const auto root = n;
+            std::fill_n(this->_state.begin(), m, lower);
+            std::fill_n(this->_flow.begin(), m, Flow{0});
+            for (auto v = std::size_t{0}; v != n; ++v) {
+                const auto e = m + v;
+                if (demand[v] > 0) {
+                    this->_source[e] = static_cast<Vertex>(root);
+                    this->_target[e] = static_cast<Vertex>(v);
+                    this->_flow[e] = demand[v];
+                } else {
+                    this->_source[e] = static_cast<Vertex>(v);
+                    this->_target[e] = static_cast<Vertex>(root);
+                    this->_flow[e] = -demand[v];
+                }
+                this->_state[e] = tree;
+                this->_parent[v] = root;
+                this->_pred[v] = e;
+                this->_size[v] = 1;
+                this->_next[v] = v + 1;  // the root after the last vertex
+                this->_prev[v] = v == 0 ? root : v - 1;
+                this->_last[v] = v;
+            }
+            this->_parent[root] = none;
+            this->_pred[root] = none;
+            this->_size[root] = n + 1;
+            this->_next[root] = 0;
+            this->_prev[root] = n == 0 ? root : n - 1;
+            this->_last[root] = n == 0 ? root : n - 1;
+        }
+
+        // Warm start from the last tree. With its flow for the new data still
+        // strongly feasible (every tree edge can pass more flow towards the
+        // root) the primal pivots go on from it; otherwise, if no edge can
+        // enter under the new costs, dual pivots repair the flow
+        auto restart(std::span<const Flow> demand) -> bool {
+            const auto n = this->_n;
+            const auto root = n;
+            for (auto v = std::size_t{0}; v != n; ++v) this->_excess[v] = -demand[v];
+            this->_excess[root] = 0;
+            for (auto e = std::size_t{0}; e != this->_source.size(); ++e) {
+                if (this->_state[e] == tree) continue;
+                if (this->_state[e] == upper && this->_cap[e] == infinite) return false;
+                this->_flow[e] = this->_state[e] == upper ? this->_cap[e] : 0;
+                this->_excess[this->_source[e]] -= this->_flow[e];
+                this->_excess[this->_target[e]] += this->_flow[e];
+            }
+            // Children before parents: the thread backwards
+            auto strong = true;
+            for (auto v = this->_prev[root]; v != root; v = this->_prev[v]) {
+                const auto e = this->_pred[v];
+                const auto up = this->_source[e] == v;
+                const auto f = up ? this->_excess[v] : -this->_excess[v];
+                strong = strong && this->overflow(e, f) == 0 && (up ? f != this->_cap[e] : f != 0);
+                this->_flow[e] = f;
+                this->_excess[this->_parent[v]] += this->_excess[v];
+            }
+            this->update_all_potentials();
+            if (strong) return true;
+            for (auto e = std::size_t{0}; e != this->_m; ++e) {
+                if (this->reduced_cost(e) < Cost{}) return false;
+            }
+            return this->repair();
+        }
+
+        // Potentials from the root down the thread, for new costs
+        void update_all_potentials() {
+            const auto root = this->_n;
+            this->_pi[root] = Cost{};
+            for (auto v = this->_next[root]; v != root; v = this->_next[v]) {
+                const auto e = this->_pred[v];
+                const auto& p = this->_pi[this->_parent[v]];
+                this->_pi[v] = this->_target[e] == v ? p - this->_cost[e] : p + this->_cost[e];
+            }
+        }
+
+        // Reduced cost in the direction the edge can move from its bound
+        [[nodiscard]] auto reduced_cost(std::size_t e) const -> Cost {
+            if (this->_state[e] == tree) return Cost{};
+            const auto c
+                = this->_cost[e] - this->_pi[this->_source[e]] + this->_pi[this->_target[e]];
+            return this->_state[e] == lower ? c : -c;
+        }
+
+        // Flow that can still be pushed along `e` when leaving `from`
+        [[nodiscard]] auto residual(std::size_t e, std::size_t from) const -> Flow {
+            if (this->_source[e] != from) return this->_flow[e];
+            return this->_cap[e] == infinite ? infinite : this->_cap[e] - this->_flow[e];
+        }
+
+        // Block search over the edges of the graph, pivoting until none can enter
+        void solve() {
+            const auto m = this->_m;
+            if (m == 0) return;
+            const auto block = std::max(
+                std::size_t{1},
+                static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(m)))));
+            const auto num_blocks = (m + block - 1) / block;
+            auto idle = std::size_t{0};
+            while (idle < num_blocks) {
+                auto entering = none;
+                auto best = Cost{};
+                for (auto k = std::size_t{0}; k != block; ++k) {
+                    const auto e = this->_cursor;
+                    this->_cursor = e + 1 == m ? 0 : e + 1;
+                    const auto c = this->reduced_cost(e);
+                    if (c < best) {
+                        best = c;
+                        entering = e;
+                    }
+                }
+                if (entering == none) {
+                    ++idle;
+                } else {
+                    idle = 0;
+                    this->pivot(entering);
+                    ++this->_pivots;
+                }
+            }
+        }
+
+        // Primal pivot on the entering edge i
+        void pivot(std::size_t i) {
+            auto p = std::size_t{this->_source[i]};
+            auto q = std::size_t{this->_target[i]};
+            if (this->_state[i] == upper) std::swap(p, q);
+            if (p == q) {  // a loop only moves between its bounds
+                if (this->_state[i] == lower && this->_cap[i] == infinite) {
+                    throw std::invalid_argument("negative cycle of infinite capacity");
+                }
+                this->_flow[i] = this->_state[i] == lower ? this->_cap[i] : 0;
+                this->_state[i] = this->_state[i] == lower ? upper : lower;
+                return;
+            }
+            const auto at_i = this->trace_cycle(i, p, q);
+            const auto& cycle = this->_cycle;
+
+            // The last blocking edge leaves
+            auto at_j = cycle.size() - 1;
+            auto delta = this->residual(cycle[at_j].first, cycle[at_j].second);
+            for (auto k = at_j; k-- != 0;) {
+                const auto r = this->residual(cycle[k].first, cycle[k].second);
+                if (r < delta) {
+                    delta = r;
+                    at_j = k;
+                }
+            }
+            if (delta == infinite) {
+                throw std::invalid_argument("negative cycle of infinite capacity");
+            }
+            this->augment(delta);
+            const auto [j, s] = cycle[at_j];
+            if (i == j) {
+                this->_state[i] = this->_state[i] == lower ? upper : lower;
+                return;
+            }
+            this->_state[i] = tree;
+            this->_state[j] = this->_source[j] == s ? upper : lower;
+            if (at_i > at_j) std::swap(p, q);  // q is now below j
+            this->exchange(i, j, p, q);
+        }
+
+        // How far the flow `f` on `e` is out of its bounds
+        [[nodiscard]] auto overflow(std::size_t e, Flow f) const -> Flow {
+            if (f < 0) return -f;
+            return this->_cap[e] != infinite && f > this->_cap[e] ? f - this->_cap[e] : 0;
+        }
+
+        // Dual pivots: while a tree edge is out of its bounds, set it to the
+        // bound and let in the graph edge across its cut of least reduced
+        // cost, which keeps every reduced cost non-negative; false if none
+        // can enter
+        auto repair() -> bool {
+            const auto n = this->_n;
+            for (;;) {
+                auto t = none;
+                auto worst = Flow{0};
+                for (auto v = std::size_t{0}; v != n; ++v) {
+                    const auto e = this->_pred[v];
+                    if (const auto over = this->overflow(e, this->_flow[e]); over > worst) {
+                        worst = over;
+                        t = v;
+                    }
+                }
+                if (t == none) return true;
+                const auto j = this->_pred[t];
+                const auto to_lower = this->_flow[j] < 0;
+                // Whether the flow out of the subtree of t has to grow
+                const auto grow = (this->_source[j] == t) == to_lower;
+
+                // Scan the cut from the smaller side
+                const auto inside = 2 * this->_size[t] <= n + 1;
+                auto& side = this->_side;
+                side.clear();
+                if (inside) {
+                    for (auto x = t;; x = this->_next[x]) {
+                        side.push_back(x);
+                        if (x == this->_last[t]) break;
+                    }
+                } else {
+                    for (auto x = n;;) {
+                        side.push_back(x);
+                        x = x == this->_prev[t] ? this->_next[this->_last[t]] : this->_next[x];
+                        if (x == n) break;
+                    }
+                }
+                for (const auto x : side) this->_mark[x] = 1;
+                auto entering = none;
+                auto best = Cost{};
+                for (const auto x : side) {
+                    for (auto k = this->_incident_offsets[x]; k != this->_incident_offsets[x + 1];
+                         ++k) {
+                        const auto e = this->_incident[k];
+                        const auto y = this->_source[e] == x ? this->_target[e] : this->_source[e];
+                        if (this->_state[e] == tree || e >= this->_m || this->_mark[y] != 0) {
+                            continue;  // artificial edges only ever leave the tree
+                        }
+                        // Flow along e moves from `_source` to `_target` when at the lower bound
+                        const auto into_x = (this->_target[e] == x) == (this->_state[e] == lower);
+                        if (into_x != (inside == grow)) continue;
+                        const auto c = this->reduced_cost(e);
+                        if (entering == none || c < best) {
+                            best = c;
+                            entering = e;
+                        }
+                    }
+                }
+                for (const auto x : side) this->_mark[x] = 0;
+                if (entering == none) return false;
+
+                auto p = std::size_t{this->_source[entering]};
+                auto q = std::size_t{this->_target[entering]};
+                if (this->_state[entering] == upper) std::swap(p, q);
+                this->trace_cycle(entering, p, q);
+                this->augment(worst);
+                this->_state[j] = to_lower ? lower : upper;
+                this->_state[entering] = tree;
+                if (!grow) std::swap(p, q);  // q is now below j
+                this->exchange(entering, j, p, q);
+                ++this->_pivots;
+            }
+        }
+
+        // The cycle from the apex down to p, along i to q and up to the apex,
+        // as (edge, vertex the edge is traversed from) pairs; returns the
+        // position of i
+        auto trace_cycle(std::size_t i, std::size_t p, std::size_t q) -> std::size_t {
+            const auto w = this->apex(p, q);
+            auto& cycle = this->_cycle;
+            cycle.clear();
+            for (auto x = p; x != w; x = this->_parent[x]) {
+                cycle.emplace_back(this->_pred[x], this->_parent[x]);
+            }
+            std::reverse(cycle.begin(), cycle.end());
+            const auto at_i = cycle.size();
+            cycle.emplace_back(i, p);
+            for (auto x = q; x != w; x = this->_parent[x]) cycle.emplace_back(this->_pred[x], x);
+            return at_i;
+        }
+
+        // Push `delta` units around the traced cycle
+        void augment(Flow delta) {
+            if (delta == 0) return;
+            for (const auto& [e, from] : this->_cycle) {
+                this->_flow[e] += this->_source[e] == from ? delta : -delta;
+            }
+        }
+
+        // Replace the tree edge j by i, where q is the end of i cut off with j
+        void exchange(std::size_t i, std::size_t j, std::size_t p, std::size_t q) {
+            auto s = std::size_t{this->_source[j]};
+            auto t = std::size_t{this->_target[j]};
+            if (this->_parent[t] != s) std::swap(s, t);
+            this->remove_edge(s, t);
+            this->make_root(q);
+            this->add_edge(i, p, q);
+            this->update_potentials(i, p, q);
+        }
+
+        // Lowest common ancestor of p and q, climbing by subtree size
+        [[nodiscard]] auto apex(std::size_t p, std::size_t q) const -> std::size_t {
+            while (p != q) {
+                if (this->_size[p] < this->_size[q]) {
+                    p = this->_parent[p];
+                } else if (this->_size[q] < this->_size[p]) {
+                    q = this->_parent[q];
+                } else {
+                    p = this->_parent[p];
+                    q = this->_parent[q];
+                }
+            }
+            return p;
+        }
+
+        // Cut the subtree of t from its parent s
+        void remove_edge(std::size_t s, std::size_t t) {
+            const auto cut = this->_size[t];
+            const auto prev_t = this->_prev[t];
+            const auto last_t = this->_last[t];
+            const auto next_last_t = this->_next[last_t];
+            this->_parent[t] = none;
+            this->_pred[t] = none;
+            this->_next[prev_t] = next_last_t;
+            this->_prev[next_last_t] = prev_t;
+            this->_next[last_t] = t;
+            this->_prev[t] = last_t;
+            for (; s != none; s = this->_parent[s]) {
+                this->_size[s] -= cut;
+                if (this->_last[s] == last_t) this->_last[s] = prev_t;
+            }
+        }
+
+        // Re-hang the tree holding q from q, reversing the path to its old root
+        void make_root(std::size_t q) {
+            auto& path = this->_path;
+            path.clear();
+            for (; q != none; q = this->_parent[q]) path.push_back(q);
+            for (auto k = path.size() - 1; k != 0; --k) {
+                const auto p = path[k];
+                q = path[k - 1];
+                const auto size_p = this->_size[p];
+                auto last_p = this->_last[p];
+                const auto prev_q = this->_prev[q];
+                const auto last_q = this->_last[q];
+                const auto next_last_q = this->_next[last_q];
+                this->_parent[p] = q;
+                this->_parent[q] = none;
+                this->_pred[p] = this->_pred[q];
+                this->_pred[q] = none;
+                this->_size[p] = size_p - this->_size[q];
+                this->_size[q] = size_p;
+                this->_next[prev_q] = next_last_q;
+                this->_prev[next_last_q] = prev_q;
+                this->_next[last_q] = q;
+                this->_prev[q] = last_q;
+                if (last_p == last_q) {
+                    this->_last[p] = prev_q;
+                    last_p = prev_q;
+                }
+                this->_prev[p] = last_q;
+                this->_next[last_q] = p;
+                this->_next[last_p] = q;
+                this->_prev[q] = last_p;
+                this->_last[q] = last_p;
+            }
+        }
+
+        // Hang the tree rooted at q below p by the edge i
+        void add_edge(std::size_t i, std::size_t p, std::size_t q) {
+            const auto last_p = this->_last[p];
+            const auto next_last_p = this->_next[last_p];
+            const auto size_q = this->_size[q];
+            const auto last_q = this->_last[q];
+            this->_parent[q] = p;
+            this->_pred[q] = i;
+            this->_next[last_p] = q;
+            this->_prev[q] = last_p;
+            this->_prev[next_last_p] = last_q;
+            this->_next[last_q] = next_last_p;
+            for (; p != none; p = this->_parent[p]) {
+                this->_size[p] += size_q;
+                if (this->_last[p] == last_p) this->_last[p] = last_q;
+            }
+        }
+
+        // Shift the potentials of the subtree of q so that the edge i to p costs nothing
+        void update_potentials(std::size_t i, std::size_t p, std::size_t q) {
+            const auto expected = this->_target[i] == q ? this->_pi[p] - this->_cost[i]
+                                                        : this->_pi[p] + this->_cost[i];
+            const auto d = expected - this->_pi[q];
+            const auto last = this->_last[q];
+            for (auto x = q;; x = this->_next[x]) {
+                this->_pi[x] = this->_pi[x] + d;
+                if (x == last) break;
+            }
+        }
+
+        std::size_t _n{0};
+        std::size_t _m{0};
+        std::vector<std::size_t> _ids{};  // edge id of every graph edge
+        std::vector<Flow> _by_id{};
+        std::vector<Vertex> _source{};
+        std::vector<Vertex> _target{};
+        std::vector<Cost> _cost{};
+        std::vector<Flow> _cap{};
+        std::vector<Flow> _flow{};
+        std::vector<State> _state{};
+        std::vector<Cost> _pi{};
+        // The spanning tree: parent, edge to it and subtree size of every
+        // vertex, and the preorder thread with the last vertex of every subtree
+        std::vector<std::size_t> _parent{};
+        std::vector<std::size_t> _pred{};
+        std::vector<std::size_t> _size{};
+        std::vector<std::size_t> _next{};
+        std::vector<std::size_t> _prev{};
+        std::vector<std::size_t> _last{};
+        std::vector<Flow> _excess{};
+        std::vector<std::pair<std::size_t, std::size_t>> _cycle{};
+        std::vector<std::size_t> _path{};
+        std::vector<std::size_t> _side{};
+        std::vector<char> _mark{};
+        // Edges at every vertex, the root included
+        std::vector<std::size_t> _incident_offsets{};
+        std::vector<std::size_t> _incident{};
+        std::size_t _cursor{0};
+        std::size_t _pivots{0};
+        bool _started{false};
+        bool _warm{false};
+    };
+
+    /**
+     * @brief Minimum-cost flow, as in NetworkX `nx.network_simplex(G)`
+     *
+     * Reads the node attribute `demand` and the edge attributes `capacity`
+     * and `weight`. As in NetworkX a missing demand is zero, a missing
+     * capacity is infinite and a missing weight is zero.
+     *
+     * @code
+     * auto [cost, flow] = py::network_simplex<std::int64_t>(G);
+     * @endcode
+     *
+     * @tparam Cost Type of the `weight` column
+     * @return std::pair The total cost and the flow of every edge, by edge id
+     * @throw std::invalid_argument as MinCostFlowSolver::run(), or if a
+     *        column has another type
+     */
+    template <typename Cost, typename Graph>
+    auto network_simplex(const GrAdaptor<Graph>& gra, std::string_view demand = "demand",
+                         std::string_view capacity = "capacity", std::string_view weight = "weight")
+        -> std::pair<Cost, std::vector<std::int64_t>> {
+        using Solver = MinCostFlowSolver<Cost, typename GrAdaptor<Graph>::Vertex>;
+        using Flow = typename Solver::Flow;
+        auto solver = Solver(gra);
+        const auto n = solver.num_vertices();
+        const auto ids = solver.num_edge_ids();
+        const auto column = [](const AttributeTable& table, std::string_view name,
+                               std::size_t size, auto fill) {
+            using T = decltype(fill);
+            auto values = std::vector<T>(size, fill);
+            if (table.contains(name)) {
+                const auto stored = table.column<T>(name);
+                std::copy_n(stored.begin(), std::min(size, stored.size()), values.begin());
+            }
+            return values;
+        };
+        const auto demands = column(gra.node_data(), demand, n, Flow{0});
+        const auto capacities = column(gra.edge_data(), capacity, ids, Solver::infinite);
+        const auto costs = column(gra.edge_data(), weight, ids, Cost{});
+        auto total = solver.run(demands, capacities, costs);
+        const auto flow = solver.flow();
+        return {std::move(total), std::vector<Flow>(flow.begin(), flow.end())};
+    }
+
+    /**
+     * @brief Flow of minimum cost, as in NetworkX `nx.min_cost_flow(G)`
+     *
+     * @return std::vector<std::int64_t> The flow of every edge, by edge id
+     * @see network_simplex()
+     */
+    template <typename Cost, typename Graph>
+    auto min_cost_flow(const GrAdaptor<Graph>& gra, std::string_view demand = "demand",
+                       std::string_view capacity = "capacity", std::string_view weight = "weight")
+        -> std::vector<std::int64_t> {
+        return network_simplex<Cost>(gra, demand, capacity, weight).second;
+    }
+
+}  // namespace py
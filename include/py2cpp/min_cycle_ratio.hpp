@@ -0,0 +1,282 @@
+/**
+ * @file min_cycle_ratio.hpp
+ * @brief Exact minimum cycle ratio by parametric negative-cycle search
+ *
+ * Provides MinCycleRatioSolver, which finds a cycle C minimising
+ * `cost(C) / time(C)` with the result as a fun::Fraction<std::int64_t>.
+ * For a candidate ratio r, a cycle has a smaller ratio exactly when it is
+ * negative under the weights `cost - r * time`. The solver starts with an
+ * r above every cycle ratio and repeatedly asks a NegCycleFinder (Howard's
+ * policy iteration) for negative cycles, lowering r to the best ratio among
+ * them, until there is none: then r is the minimum.
+ *
+ * With `r = p / q` every weight `cost - r * time` has the denominator q,
+ * so the searches run on the integers `q * cost - p * time` instead of on
+ * fractions. They are kept in 128-bit integers, which cannot overflow for
+ * costs and times below 2^31 in magnitude on graphs of up to 2^20
+ * vertices; run() checks both limits. Compilers without `__int128` (MSVC)
+ * use the portable detail::WideInt instead. The graph, the finder and the
+ * weight and distance arrays are set up once and reused by every step and
+ * every call to run().
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fractions.hpp"
+#include "neg_cycle.hpp"
+#include "thread_pool.hpp"
+
+namespace py {
+
+    namespace detail {
+
+        /**
+         * @brief Two's complement 128-bit integer with `+`, `-` and comparisons
+         *
+         * Portable stand-in for `__int128`, enough for the parametric weights
+         * of MinCycleRatioSolver and the distances of NegCycleFinder.
+         */
+        struct WideInt {
+            std::uint64_t lo{0};
+            std::int64_t hi{0};
+
+            constexpr WideInt() noexcept = default;
+            constexpr WideInt(std::int64_t value) noexcept
+                : lo{static_cast<std::uint64_t>(value)}, hi{value < 0 ? -1 : 0} {}
+
+            /**
+             * @brief The exact product `a * b`
+             */
+            static constexpr auto product(std::int64_t a, std::int64_t b) noexcept -> WideInt {
+                constexpr auto low = std::uint64_t{0xffffffff};
+                const auto ua = a < 0 ? 0 - static_cast<std::uint64_t>(a)
+                                      : static_cast<std::uint64_t>(a);
+                const auto ub = b < 0 ? 0 - static_cast<std::uint64_t>(b)
+                                      : static_cast<std::uint64_t>(b);
+                const auto p00 = (ua & low) * (ub & low);
+                const auto p01 = (ua & low) * (ub >> 32);
+                const auto p10 = (ua >> 32) * (ub & low);
+                const auto p11 = (ua >> 32) * (ub >> 32);
+                const auto mid = (p00 >> 32) + (p01 & low) + (p10 & low);
+                auto result = WideInt{};
+                result.lo = (p00 & low) | (mid << 32);
+                result.hi
+                    = static_cast<std::int64_t>(p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32));
+                return (a < 0) != (b < 0) ? -result : result;
+            }
+
+            constexpr auto operator-() const noexcept -> WideInt {
+                auto result = WideInt{};
+                result.lo = ~this->lo + 1;
+                const auto carry = static_cast<std::uint64_t>(result.lo == 0);
+                result.hi
+                    = static_cast<std::int64_t>(~static_cast<std::uint64_t>(this->hi) + carry);
+                return result;
+            }
+
+            constexpr auto operator+=(const WideInt& other) noexcept -> WideInt& {
+                const auto lo_sum = this->lo + other.lo;
+                const auto carry = static_cast<std::uint64_t>(lo_sum < this->lo);
+                this->hi = static_cast<std::int64_t>(
+                    static_cast<std::uint64_t>(this->hi) + static_cast<std::uint64_t>(other.hi)
+                    + carry);
+                this->lo = lo_sum;
+                return *this;
+            }
+
+            friend constexpr auto operator+(WideInt lhs, const WideInt& rhs) noexcept -> WideInt {
+                return lhs += rhs;
+            }
+            friend constexpr auto operator-(WideInt lhs, const WideInt& rhs) noexcept -> WideInt {
+                return lhs += -rhs;
+            }
+            friend constexpr auto operator==(const WideInt& lhs, const WideInt& rhs) noexcept
+                -> bool {
+                return lhs.hi == rhs.hi && lhs.lo == rhs.lo;
+            }
+            friend constexpr auto operator<(const WideInt& lhs, const WideInt& rhs) noexcept
+                -> bool {
+                return lhs.hi != rhs.hi ? lhs.hi < rhs.hi : lhs.lo < rhs.lo;
+            }
+        };
+
+#if defined(__SIZEOF_INT128__)
+        __extension__ using Int128 = __int128;
+#else
+        using Int128 = WideInt;
+#endif
+
+        /// The exact product `a * b` as an `Int` (Int128 or WideInt)
+        template <typename Int>
+        constexpr auto wide_product(std::int64_t a, std::int64_t b) noexcept -> Int {
+            if constexpr (std::is_same_v<Int, WideInt>) {
+                return WideInt::product(a, b);
+            } else {
+                return static_cast<Int>(a) * b;
+            }
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Reusable minimum-cycle-ratio solver over a fixed graph
+     *
+     * Edges are named by id as in NegCycleFinder, so GrAdaptor edge
+     * attribute columns can be passed as the costs and times.
+     *
+     * @tparam Vertex Unsigned integral vertex type
+     * @tparam Int 128-bit integer type for the weights and distances
+     */
+    template <typename Vertex = std::uint32_t, typename Int = detail::Int128>
+    class MinCycleRatioSolver {
+
+      public:
+        using Ratio = fun::Fraction<std::int64_t>;
+        using Cycle = std::vector<std::size_t>;
+
+        /// A cycle of minimum ratio
+        struct Result {
+            Ratio ratio;  ///< cost(cycle) / time(cycle), in lowest terms
+            Cycle cycle;  ///< Edge ids along the cycle
+        };
+
+        /// Largest magnitude of a cost or time
+        static constexpr auto max_value = std::int64_t{std::numeric_limits<std::int32_t>::max()};
+
+        /// Largest number of vertices
+        static constexpr auto max_vertices = std::size_t{1} << 20;
+
+        /**
+         * @brief Prepare solving over `gra` (vertices `0 .. n-1`)
+         */
+        template <typename Graph> explicit MinCycleRatioSolver(const Graph& gra) : _finder{gra} {
+            this->allocate();
+        }
+
+        /**
+         * @brief Prepare solving over `gra`, relaxing on `pool`
+         */
+        template <typename Graph> MinCycleRatioSolver(ThreadPool& pool, const Graph& gra)
+            : _finder{pool, gra} {
+            this->allocate();
+        }
+
+        /**
+         * @brief Number of parametric steps of the last run()
+         */
+        [[nodiscard]] auto iterations() const noexcept -> std::size_t { return this->_iterations; }
+
+        /**
+         * @brief Find a cycle of minimum `cost / time`
+         *
+         * Every cycle must have a positive total time (a circuit loop
+         * through at least one register, say); single edges may take no
+         * time.
+         *
+         * @param[in] cost Cost of every edge, indexed by edge id
+         * @param[in] time Time of every edge (non-negative), indexed by edge id
+         * @return std::optional<Result> The minimum ratio and a cycle
+         *         attaining it, or std::nullopt if the graph has no cycle
+         * @throw std::invalid_argument if an array is too short, a time is
+         *        negative or a cycle found takes no time
+         * @throw std::out_of_range if a cost or time exceeds max_value, or
+         *        the graph has more than max_vertices vertices
+         */
+        auto run(std::span<const std::int64_t> cost, std::span<const std::int64_t> time)
+            -> std::optional<Result> {
+            const auto m = this->_finder.num_edge_ids();
+            if (this->_finder.num_vertices() > max_vertices) {
+                throw std::out_of_range("too many vertices for exact cycle ratios");
+            }
+            if (cost.size() < m || time.size() < m) {
+                throw std::invalid_argument("need one cost and one time per edge id");
+            }
+            // Above every cycle ratio, as a cycle takes at least 1 time unit and
+            // has at most n edges
+            const auto max_cost
+                = static_cast<std::int64_t>(this->_finder.num_vertices()) * max_value;
+            auto bound = std::int64_t{0};
+            for (auto id = std::size_t{0}; id != m; ++id) {
+                if (cost[id] < -max_value || cost[id] > max_value || time[id] > max_value) {
+                    throw std::out_of_range("cost or time too large");
+                }
+                if (time[id] < 0) throw std::invalid_argument("negative time");
+                if (cost[id] > 0) bound = std::min(bound + cost[id], max_cost);
+            }
+            ++bound;
+            auto best = std::optional<Result>{};
+            auto p = bound;
+            auto q = std::int64_t{1};
+            this->_iterations = 0;
+            for (;;) {
+                ++this->_iterations;
+                for (auto id = std::size_t{0}; id != m; ++id) {
+                    this->_weight[id] = detail::wide_product<Int>(q, cost[id])
+                                        - detail::wide_product<Int>(p, time[id]);
+                }
+                std::fill(this->_dist.begin(), this->_dist.end(), Int{0});
+                auto cycles = this->_finder.howard(this->_dist, this->_weight);
+                if (cycles.empty()) break;
+                // Every cycle found is below p / q; move to the best of them
+                for (auto& cycle : cycles) {
+                    auto total_cost = std::int64_t{0};
+                    auto total_time = std::int64_t{0};
+                    for (const auto id : cycle) {
+                        total_cost += cost[id];
+                        total_time += time[id];
+                    }
+                    if (total_time == 0) throw std::invalid_argument("cycle of zero time");
+                    // total_cost / total_time < p / q
+                    if (detail::wide_product<Int>(total_cost, q)
+                        < detail::wide_product<Int>(p, total_time)) {
+                        const auto ratio = Ratio(total_cost, total_time);
+                        p = ratio.num();
+                        q = ratio.den();
+                        best = Result{ratio, std::move(cycle)};
+                    }
+                }
+            }
+            return best;
+        }
+
+      private:
+        void allocate() {
+            this->_weight.assign(this->_finder.num_edge_ids(), Int{0});
+            this->_dist.assign(this->_finder.num_vertices(), Int{0});
+        }
+
+        NegCycleFinder<Int, Vertex> _finder;
+        std::vector<Int> _weight{};
+        std::vector<Int> _dist{};
+        std::size_t _iterations{0};
+    };
+
+    /**
+     * @brief Minimum cycle ratio of `gra`
+     *
+     * @code
+     * auto result = py::min_cycle_ratio(G, G.edge_data().column<std::int64_t>("cost"),
+     *                                   G.edge_data().column<std::int64_t>("time"));
+     * @endcode
+     *
+     * @see MinCycleRatioSolver::run()
+     */
+    template <typename Graph>
+    auto min_cycle_ratio(const Graph& gra, std::span<const std::int64_t> cost,
+                         std::span<const std::int64_t> time)
+        -> std::optional<typename MinCycleRatioSolver<>::Result> {
+        return MinCycleRatioSolver<>(gra).run(cost, time);
+    }
+
+}  // namespace py
@@ -0,0 +1,325 @@
+/**
+ * @file neg_cycle.hpp
+ * @brief Negative-cycle detection by Howard's policy iteration
+ *
+ * Provides NegCycleFinder. Every vertex keeps a policy, the in-edge that
+ * last lowered its distance; the policy edges form a graph in which every
+ * vertex has at most one predecessor. Each round relaxes the out-edges of
+ * the vertices whose distance dropped in the round before (Bellman-Ford)
+ * and then looks for cycles among the policy edges. A cycle of negative
+ * weight is reported; when a round lowers no distance there is no negative
+ * cycle and the distances are a feasible potential:
+ * `dist[v] <= dist[u] + w(u, v)` for every edge.
+ *
+ * The distances are passed in by the caller and updated in place, so a
+ * search after a small weight change starts from the previous potential
+ * (a warm start); given the changed edges, its first round relaxes only
+ * those. Weights only need `+`, `<` and a zero `Weight{}`, so
+ * fun::Fraction weights stay exact.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "nx2bgl.hpp"
+#include "thread_pool.hpp"
+
+namespace py {
+
+    /**
+     * @brief Reusable negative-cycle finder over a fixed graph
+     *
+     * Edges are named by id: the `edge_index` of the graph when its edges
+     * store one (CsrGraph, or a GrAdaptor over an adjacency_list with an
+     * `edge_index_t` property), otherwise their position in a CSR copy of
+     * the graph. Weights are looked up by id, so a GrAdaptor edge
+     * attribute column can be passed as it is.
+     *
+     * Given a ThreadPool, each round relaxes the vertices in parallel: every
+     * vertex takes the minimum over its in-edges of the distances of the
+     * previous round (Jacobi rather than Gauss-Seidel order, so no two
+     * threads write one distance).
+     *
+     * @tparam Weight Edge weight type
+     * @tparam Vertex Unsigned integral vertex type
+     */
+    template <typename Weight, typename Vertex = std::uint32_t> class NegCycleFinder {
+        static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+
+      public:
+        /// Edge ids along a cycle, each edge followed by the one leaving its target
+        using Cycle = std::vector<std::size_t>;
+
+        /**
+         * @brief Prepare searches over `gra` (vertices `0 .. n-1`)
+         */
+        template <typename Graph> explicit NegCycleFinder(const Graph& gra) { this->build(gra); }
+
+        /**
+         * @brief Prepare searches over `gra` that relax on `pool`
+         *
+         * @param[in] pool Pool running the relaxations (must outlive this object)
+         * @param[in] gra The graph
+         */
+        template <typename Graph> NegCycleFinder(ThreadPool& pool, const Graph& gra)
+            : _pool{&pool} {
+            this->build(gra);
+            this->transpose();
+        }
+
+        [[nodiscard]] auto num_vertices() const noexcept -> std::size_t { return this->_n; }
+
+        /**
+         * @brief Number of edge ids (one more than the largest)
+         */
+        [[nodiscard]] auto num_edge_ids() const noexcept -> std::size_t { return this->_num_ids; }
+
+        /**
+         * @brief Source vertex of the edge `id`
+         */
+        [[nodiscard]] auto source(std::size_t id) const -> Vertex {
+            return this->_ends.at(id).first;
+        }
+
+        /**
+         * @brief Target vertex of the edge `id`
+         */
+        [[nodiscard]] auto target(std::size_t id) const -> Vertex {
+            return this->_ends.at(id).second;
+        }
+
+        /**
+         * @brief Find negative cycles by Howard's policy iteration
+         *
+         * Starting from `dist` (all zero for a cold start, which finds a
+         * negative cycle anywhere in the graph), rounds of relaxation run
+         * until the policy graph has a negative cycle or no distance drops.
+         *
+         * @param[in,out] dist Distance of every vertex, kept for the next call
+         * @param[in] weight Weight of every edge, indexed by edge id
+         * @return std::vector<Cycle> The negative cycles of the policy graph
+         *         of the last round (empty if there is none, in which case
+         *         `dist` is a feasible potential)
+         * @throw std::invalid_argument if `dist` or `weight` is too short
+         */
+        auto howard(std::span<Weight> dist, std::span<const Weight> weight) -> std::vector<Cycle> {
+            this->check(dist, weight);
+            std::fill(this->_active.begin(), this->_active.end(), char{1});
+            return this->iterate(dist, weight);
+        }
+
+        /**
+         * @brief Find negative cycles after some weights changed
+         *
+         * `dist` must be the feasible potential left by a previous call that
+         * found no cycle. Only the edges `changed` can violate it, so the
+         * first round relaxes just their sources instead of every edge.
+         *
+         * @param[in,out] dist Distance of every vertex, kept for the next call
+         * @param[in] weight Weight of every edge, indexed by edge id
+         * @param[in] changed Ids of the edges whose weight changed since then
+         * @return std::vector<Cycle> As for howard(dist, weight)
+         */
+        auto howard(std::span<Weight> dist, std::span<const Weight> weight,
+                    std::span<const std::size_t> changed) -> std::vector<Cycle> {
+            this->check(dist, weight);
+            std::fill(this->_active.begin(), this->_active.end(), char{0});
+            for (const auto id : changed) {
+                this->_active[this->source(id)] = 1;
+            }
+            return this->iterate(dist, weight);
+        }
+
+      private:
+        static constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+        void check(std::span<Weight> dist, std::span<const Weight> weight) const {
+            if (dist.size() != this->_n) {
+                throw std::invalid_argument("need one distance per vertex");
+            }
+            if (weight.size() < this->_num_ids) {
+                throw std::invalid_argument("need one weight per edge id");
+            }
+        }
+
+        auto iterate(std::span<Weight> dist, std::span<const Weight> weight)
+            -> std::vector<Cycle> {
+            std::fill(this->_pred.begin(), this->_pred.end(), none);
+            auto cycles = std::vector<Cycle>{};
+            while (cycles.empty() && this->relax(dist, weight)) {
+                cycles = this->find_cycles(weight);
+            }
+            return cycles;
+        }
+
+        template <typename Graph> void build(const Graph& gra) {
+            auto offsets = std::vector<std::size_t>{};
+            auto targets = std::vector<Vertex>{};
+            detail::csr_fill(gra, offsets, targets, [&](std::size_t pos, const auto& e) {
+                if constexpr (detail::stores_edge_index<Graph>::value) {
+                    if (this->_ids.empty()) this->_ids.resize(targets.size());
+                    this->_ids[pos] = detail::bgl_edge_index(e, gra);
+                }
+            });
+            this->_n = offsets.size() - 1;
+            if (this->_ids.empty()) {
+                this->_ids.resize(targets.size());
+                for (auto pos = std::size_t{0}; pos != targets.size(); ++pos) {
+                    this->_ids[pos] = pos;
+                }
+            }
+            this->_num_ids = 0;
+            for (const auto id : this->_ids) {
+                this->_num_ids = std::max(this->_num_ids, id + 1);
+            }
+            this->_ends.assign(this->_num_ids, {});
+            for (auto u = std::size_t{0}; u != this->_n; ++u) {
+                for (auto pos = offsets[u]; pos != offsets[u + 1]; ++pos) {
+                    this->_ends[this->_ids[pos]] = {static_cast<Vertex>(u), targets[pos]};
+                }
+            }
+            this->_out = CsrGraph<boost::no_property, Vertex>(std::move(offsets),
+                                                               std::move(targets));
+            this->_pred.assign(this->_n, none);
+            this->_active.assign(this->_n, 0);
+        }
+
+        // In-edges of every vertex, with the edge id as the property
+        void transpose() {
+            const auto offsets = this->_out.row_offsets();
+            const auto targets = this->_out.column_indices();
+            auto reversed = std::vector<std::pair<Vertex, Vertex>>(targets.size());
+            for (auto u = std::size_t{0}; u != this->_n; ++u) {
+                for (auto pos = offsets[u]; pos != offsets[u + 1]; ++pos) {
+                    reversed[pos] = {targets[pos], static_cast<Vertex>(u)};
+                }
+            }
+            this->_in = CsrGraph<std::size_t, Vertex>(*this->_pool, this->_n, reversed,
+                                                      this->_ids);
+            this->_next.resize(this->_n);
+            this->_next_pred.resize(this->_n);
+            this->_dropped.resize(this->_n);
+        }
+
+        // One round of Bellman-Ford over the out-edges of the active vertices
+        // (those whose distance dropped in the previous round); whether any
+        // distance dropped
+        auto relax(std::span<Weight> dist, std::span<const Weight> weight) -> bool {
+            auto& active = this->_active;
+            if (this->_pool == nullptr) {
+                const auto offsets = this->_out.row_offsets();
+                const auto targets = this->_out.column_indices();
+                auto changed = false;
+                for (auto u = std::size_t{0}; u != this->_n; ++u) {
+                    if (std::exchange(active[u], char{0}) == 0) continue;
+                    for (auto pos = offsets[u]; pos != offsets[u + 1]; ++pos) {
+                        const auto id = this->_ids[pos];
+                        const auto v = static_cast<std::size_t>(targets[pos]);
+                        auto d = dist[u] + weight[id];
+                        if (d < dist[v]) {
+                            dist[v] = std::move(d);
+                            this->_pred[v] = id;
+                            active[v] = 1;  // in this round if v > u, else in the next
+                            changed = true;
+                        }
+                    }
+                }
+                return changed;
+            }
+            const auto offsets = this->_in.row_offsets();
+            const auto sources = this->_in.column_indices();
+            const auto ids = this->_in.edge_properties();
+            auto& dropped = this->_dropped;
+            auto changed = std::atomic<bool>{false};
+            const auto chunks = std::min(4 * (this->_pool->size() + 1), this->_n / 1024 + 1);
+            parallel_for(*this->_pool, this->_n, chunks,
+                         [&](std::size_t, std::size_t lo, std::size_t hi) {
+                             auto any = false;
+                             for (auto v = lo; v != hi; ++v) {
+                                 auto improved = false;
+                                 for (auto pos = offsets[v]; pos != offsets[v + 1]; ++pos) {
+                                     const auto u = static_cast<std::size_t>(sources[pos]);
+                                     if (active[u] == 0) continue;
+                                     auto d = dist[u] + weight[ids[pos]];
+                                     if (improved ? d < this->_next[v] : d < dist[v]) {
+                                         this->_next[v] = std::move(d);
+                                         this->_next_pred[v] = ids[pos];
+                                         improved = true;
+                                     }
+                                 }
+                                 dropped[v] = static_cast<char>(improved);
+                                 any = any || improved;
+                             }
+                             if (any) changed.store(true, std::memory_order_relaxed);
+                         });
+            parallel_for(*this->_pool, this->_n, chunks,
+                         [&](std::size_t, std::size_t lo, std::size_t hi) {
+                             for (auto v = lo; v != hi; ++v) {
+                                 if (dropped[v] == 0) continue;
+                                 dist[v] = std::move(this->_next[v]);
+                                 this->_pred[v] = this->_next_pred[v];
+                             }
+                         });
+            std::swap(active, dropped);
+            return changed.load();
+        }
+
+        // Negative cycles of the policy graph, each found once
+        auto find_cycles(std::span<const Weight> weight) -> std::vector<Cycle> {
+            auto cycles = std::vector<Cycle>{};
+            // 0: unvisited; otherwise 1 + the start of the walk that reached the vertex
+            auto& visited = this->_visited;
+            visited.assign(this->_n, 0);
+            for (auto start = std::size_t{0}; start != this->_n; ++start) {
+                auto v = start;
+                while (visited[v] == 0) {
+                    visited[v] = start + 1;
+                    if (this->_pred[v] == none) break;
+                    v = this->_ends[this->_pred[v]].first;
+                }
+                if (visited[v] != start + 1 || this->_pred[v] == none) continue;
+                // `v` lies on a cycle first reached by this walk
+                auto cycle = Cycle{};
+                auto total = Weight{};
+                auto u = v;
+                do {
+                    const auto id = this->_pred[u];
+                    cycle.push_back(id);
+                    total = total + weight[id];
+                    u = this->_ends[id].first;
+                } while (u != v);
+                if (total < Weight{}) {
+                    std::reverse(cycle.begin(), cycle.end());
+                    cycles.push_back(std::move(cycle));
+                }
+            }
+            return cycles;
+        }
+
+        ThreadPool* _pool{nullptr};
+        std::size_t _n{0};
+        std::size_t _num_ids{0};
+        CsrGraph<boost::no_property, Vertex> _out{};
+        CsrGraph<std::size_t, Vertex> _in{};             // in-edges, only with a pool
+        std::vector<std::size_t> _ids{};                 // edge id of every CSR position
+        std::vector<std::pair<Vertex, Vertex>> _ends{};  // endpoints of every edge id
+        std::vector<std::size_t> _pred{};                // policy: in-edge id, or none
+        std::vector<std::size_t> _visited{};
+        std::vector<char> _active{};  // distance dropped since the vertex was last relaxed
+        std::vector<Weight> _next{};  // parallel rounds: new distances,
+        std::vector<std::size_t> _next_pred{};  // their policy edges
+        std::vector<char> _dropped{};           // and whether there is one
+    };
+
+}  // namespace py
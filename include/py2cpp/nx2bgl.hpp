@@ -2,19 +2,90 @@
  * @file nx2bgl.hpp
  * @brief Boost Graph Library adapters for XNetwork integration
  *
- * Provides VertexView, EdgeView, AtlasView, and GrAdaptor classes
+ * Provides VertexView, EdgeView, AtlasView, AdjacencyView and GrAdaptor classes
  * that bridge XNetwork graph concepts with the Boost Graph Library.
+ * Any graph modelling the BGL concepts can be wrapped, including
+ * boost::adjacency_list and py::CsrGraph (csr_graph.hpp).
  */
 
 #pragma once
 
+#include <algorithm>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/graph_utility.hpp>
+#include <boost/pending/property.hpp>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "attributes.hpp"
 
 namespace py {
 
+    namespace detail {
+
+        // The BGL free functions are called unqualified so that argument-dependent
+        // lookup also finds those of graphs outside namespace boost (py::CsrGraph).
+        // These wrappers exist because member names such as GrAdaptor::source hide
+        // the free functions inside the adaptor.
+
+        template <typename Graph> auto bgl_vertices(const Graph& gra) { return vertices(gra); }
+
+        template <typename Graph> auto bgl_edges(const Graph& gra) { return edges(gra); }
+
+        template <typename Vertex, typename Graph>
+        auto bgl_out_edges(const Vertex& v, const Graph& gra) {
+            return out_edges(v, gra);
+        }
+
+        template <typename Vertex, typename Graph>
+        auto bgl_adjacent_vertices(const Vertex& v, const Graph& gra) {
+            return adjacent_vertices(v, gra);
+        }
+
+        template <typename Graph> auto bgl_num_vertices(const Graph& gra) {
+            return num_vertices(gra);
+        }
+
+        template <typename Graph> auto bgl_num_edges(const Graph& gra) { return num_edges(gra); }
+
+        template <typename Edge, typename Graph> auto bgl_source(const Edge& e, const Graph& gra) {
+            return source(e, gra);
+        }
+
+        template <typename Edge, typename Graph> auto bgl_target(const Edge& e, const Graph& gra) {
+            return target(e, gra);
+        }
+
+        template <typename Vertex, typename Graph>
+        auto bgl_edge(const Vertex& u, const Vertex& v, const Graph& gra) {
+            return edge(u, v, gra);
+        }
+
+        template <typename Edge, typename Graph>
+        auto bgl_edge_index(const Edge& e, const Graph& gra) -> std::size_t {
+            return static_cast<std::size_t>(get(boost::edge_index, gra, e));
+        }
+
+        // Whether the edges of Graph store an edge_index_t property (which
+        // GrAdaptor then numbers as edges are added)
+        template <typename Graph, typename = void> struct stores_edge_index : std::false_type {};
+
+        template <typename Graph>
+        struct stores_edge_index<Graph, std::void_t<typename Graph::edge_property_type>>
+            : std::bool_constant<boost::lookup_one_property<typename Graph::edge_property_type,
+                                                            boost::edge_index_t>::found> {};
+
+    }  // namespace detail
+
     /**
      * @brief Vertex view for Boost Graph Library graphs
      *
@@ -44,7 +115,7 @@ namespace py {
         [[nodiscard]] auto begin() const {
             // auto [v_iter, v_end] = boost::vertices(*this);
             // return v_iter;
-            return boost::vertices(*this).first;
+            return detail::bgl_vertices(*this).first;
         }
 
         /**
@@ -57,7 +128,7 @@ namespace py {
         [[nodiscard]] auto end() const {
             // auto [v_iter, v_end] = boost::vertices(*this);
             // return v_end;
-            return boost::vertices(*this).second;
+            return detail::bgl_vertices(*this).second;
         }
 
         /**
@@ -70,7 +141,7 @@ namespace py {
         [[nodiscard]] auto cbegin() const {
             // auto [v_iter, v_end] = boost::vertices(*this);
             // return v_iter;
-            return boost::vertices(*this).first;
+            return detail::bgl_vertices(*this).first;
         }
 
         /**
@@ -83,7 +154,7 @@ namespace py {
         [[nodiscard]] auto cend() const {
             // auto [v_iter, v_end] = boost::vertices(*this);
             // return v_end;
-            return boost::vertices(*this).second;
+            return detail::bgl_vertices(*this).second;
         }
     };
 
@@ -119,7 +190,7 @@ namespace py {
         [[nodiscard]] auto begin() const {
             // auto [e_iter, e_end] = boost::edges(_gra);
             // return e_iter;
-            return boost::edges(this->gra).first;
+            return detail::bgl_edges(this->gra).first;
         }
 
         /**
@@ -132,7 +203,7 @@ namespace py {
         [[nodiscard]] auto end() const {
             // auto [e_iter, e_end] = boost::edges(_gra);
             // return e_end;
-            return boost::edges(this->gra).second;
+            return detail::bgl_edges(this->gra).second;
         }
 
         /**
@@ -145,7 +216,7 @@ namespace py {
         [[nodiscard]] auto cbegin() const {
             // auto [e_iter, e_end] = boost::edges(_gra);
             // return e_iter;
-            return boost::edges(this->gra).first;
+            return detail::bgl_edges(this->gra).first;
         }
 
         /**
@@ -158,7 +229,7 @@ namespace py {
         [[nodiscard]] auto cend() const {
             // auto [e_iter, e_end] = boost::edges(_gra);
             // return e_end;
-            return boost::edges(this->gra).second;
+            return detail::bgl_edges(this->gra).second;
         }
     };
 
@@ -198,7 +269,7 @@ namespace py {
         auto begin() const {
             // auto [e_iter, e_end] = boost::out_edges(_v, _gra);
             // return e_iter;
-            return boost::out_edges(this->_v, this->gra).first;
+            return detail::bgl_out_edges(this->_v, this->gra).first;
         }
 
         /**
@@ -211,7 +282,7 @@ namespace py {
         auto end() const {
             // auto [e_iter, e_end] = boost::out_edges(_v, _gra);
             // return e_end;
-            return boost::out_edges(this->_v, this->gra).second;
+            return detail::bgl_out_edges(this->_v, this->gra).second;
         }
 
         /**
@@ -224,7 +295,7 @@ namespace py {
         auto cbegin() const {
             // auto [e_iter, e_end] = boost::out_edges(_v, _gra);
             // return e_iter;
-            return boost::out_edges(this->_v, this->gra).first;
+            return detail::bgl_out_edges(this->_v, this->gra).first;
         }
 
         /**
@@ -237,10 +308,39 @@ namespace py {
         auto cend() const {
             // auto [e_iter, e_end] = boost::out_edges(_v, _gra);
             // return e_end;
-            return boost::out_edges(this->_v, this->gra).second;
+            return detail::bgl_out_edges(this->_v, this->gra).second;
         }
     };
 
+    /**
+     * @brief Adjacent vertices of one vertex in a Boost Graph Library graph
+     *
+     * Iterates the vertex ids reached by the out-edges of a vertex, using the
+     * graph's own `adjacent_vertices`, so no edge descriptors are formed.
+     *
+     * @tparam Vertex The vertex descriptor type
+     * @tparam Graph The Boost Graph Library graph type
+     */
+    template <typename Vertex, typename Graph> class AdjacencyView {
+      private:
+        Vertex _v;
+        const Graph& gra;
+
+      public:
+        /**
+         * @brief Construct a new Adjacency View object
+         *
+         * @param[in] v The vertex whose neighbours are viewed
+         * @param[in] gra Reference to the graph containing the vertex
+         */
+        AdjacencyView(Vertex v, const Graph& gra) : _v{v}, gra{gra} {}
+
+        auto begin() const { return detail::bgl_adjacent_vertices(this->_v, this->gra).first; }
+        auto end() const { return detail::bgl_adjacent_vertices(this->_v, this->gra).second; }
+        auto cbegin() const { return this->begin(); }
+        auto cend() const { return this->end(); }
+    };
+
     /**
      * @brief Graph adapter for Boost Graph Library integration
      *
@@ -269,10 +369,21 @@ namespace py {
          * @brief Construct a new graph adaptor object
          *
          * Creates a graph adaptor by moving an existing graph into this wrapper.
+         * If the edges store an `edge_index_t` property whose values are not
+         * already the ids `0 .. m-1` (e.g. a graph built from an edge list,
+         * where they are all 0), the edges are numbered in edges() order.
          *
          * @param[in] gra The graph to wrap (moved into this GrAdaptor)
          */
-        explicit GrAdaptor(_Graph&& gra) noexcept : VertexView<_Graph>{std::forward<_Graph>(gra)} {}
+        explicit GrAdaptor(_Graph&& gra)
+            : VertexView<_Graph>{std::forward<_Graph>(gra)},
+              _num_edges{static_cast<std::size_t>(detail::bgl_num_edges(*this))},
+              _node_data{static_cast<std::size_t>(detail::bgl_num_vertices(*this))},
+              _edge_data{_num_edges} {
+            if constexpr (detail::stores_edge_index<_Graph>::value) {
+                this->number_existing_edges();
+            }
+        }
 
         // GrAdaptor(const GrAdaptor&) = delete;            // don't copy
         // GrAdaptor& operator=(const GrAdaptor&) = delete; // don't assign
@@ -283,14 +394,14 @@ namespace py {
          *
          * @return Number of vertices
          */
-        [[nodiscard]] auto number_of_nodes() const { return boost::num_vertices(*this); }
+        [[nodiscard]] auto number_of_nodes() const { return detail::bgl_num_vertices(*this); }
 
         /**
          * @brief Get the number of edges in the graph
          *
          * @return Number of edges
          */
-        [[nodiscard]] auto number_of_edges() const { return boost::num_edges(*this); }
+        [[nodiscard]] auto number_of_edges() const { return detail::bgl_num_edges(*this); }
 
         /**
          * @brief Get an edge view for the graph
@@ -313,6 +424,29 @@ namespace py {
             return AtlasView<Vertex, _Graph>(v, *this);
         }
 
+        /**
+         * @brief Get the vertex ids adjacent to a vertex
+         *
+         * Unlike neighbors(), which yields edge descriptors, this yields the
+         * target vertices directly. Graphs storing their adjacency
+         * contiguously (such as CsrGraph) give a `std::span<const Vertex>`,
+         * which inner loops can index, vectorize and prefetch; other graphs
+         * give an AdjacencyView over BGL's `adjacent_vertices`.
+         *
+         * @param[in] v The vertex
+         * @return std::span<const Vertex> or AdjacencyView<Vertex, _Graph>
+         */
+        [[nodiscard]] auto adjacent_nodes(Vertex v) const {
+            using Iter = typename boost::graph_traits<_Graph>::adjacency_iterator;
+            if constexpr (std::contiguous_iterator<Iter>) {
+                const auto [first, last] = detail::bgl_adjacent_vertices(v, *this);
+                return std::span<const Vertex>{std::to_address(first),
+                                               static_cast<std::size_t>(last - first)};
+            } else {
+                return AdjacencyView<Vertex, _Graph>(v, *this);
+            }
+        }
+
         /**
          * @brief Add an edge between two vertices
          *
@@ -321,7 +455,75 @@ namespace py {
          * @return auto Edge descriptor of the newly added edge
          */
         auto add_edge(int u, int v) {
-            return boost::add_edge(static_cast<Vertex>(u), static_cast<Vertex>(v), *this);
+            auto result = boost::add_edge(static_cast<Vertex>(u), static_cast<Vertex>(v), *this);
+            this->number_edge(result);
+            this->grow_tables();
+            return result;
+        }
+
+        /**
+         * @brief Add nodes, as in NetworkX `G.add_nodes_from(nodes)`
+         *
+         * Vertices of a vecS graph are the integers `0 .. n-1`, so adding node
+         * `v` adds every missing vertex up to and including `v`.
+         *
+         * @tparam NodeRange Range of non-negative integers
+         * @param[in] nodes Nodes to add
+         * @throw std::out_of_range for a negative node
+         */
+        template <typename NodeRange> void add_nodes_from(const NodeRange& nodes) {
+            auto needed = static_cast<std::size_t>(this->number_of_nodes());
+            for (const auto& v : nodes) {
+                needed = std::max(needed, to_index(v) + 1);
+            }
+            this->grow_to(needed);
+            this->grow_tables();
+        }
+
+        /**
+         * @brief Add edges in bulk, as in NetworkX `G.add_edges_from(edges)`
+         *
+         * Elements are `(u, v)` pairs, or `(u, v, property)` triples for graphs
+         * with an edge property. A first pass finds the number of vertices and
+         * the out-degree each vertex gains; all missing vertices are then added
+         * at once and, when the out-edge containers support it (e.g. vecS), each
+         * one is reserved to its exact final size before the edges are inserted.
+         *
+         * @tparam EdgeRange Forward range of pair-like or triple-like values
+         * @param[in] edges Edges to add
+         * @throw std::out_of_range for a negative endpoint
+         */
+        template <typename EdgeRange> void add_edges_from(const EdgeRange& edges) {
+            auto needed = static_cast<std::size_t>(this->number_of_nodes());
+            auto degree = std::vector<std::size_t>{};
+            for (const auto& e : edges) {
+                const auto u = to_index(std::get<0>(e));
+                const auto v = to_index(std::get<1>(e));
+                needed = std::max({needed, u + 1, v + 1});
+                if (u >= degree.size()) degree.resize(std::max(u + 1, 2 * degree.size()));
+                ++degree[u];
+            }
+            this->grow_to(needed);
+            if constexpr (requires(_Graph& gra, Vertex v) { gra.out_edge_list(v).reserve(0); }) {
+                for (auto u = std::size_t{0}; u != degree.size(); ++u) {
+                    if (degree[u] == 0) continue;
+                    auto& out = this->out_edge_list(static_cast<Vertex>(u));
+                    out.reserve(out.size() + degree[u]);
+                }
+            }
+            for (const auto& e : edges) {
+                const auto u = static_cast<Vertex>(std::get<0>(e));
+                const auto v = static_cast<Vertex>(std::get<1>(e));
+                const auto result = [&] {
+                    if constexpr (std::tuple_size_v<std::remove_cvref_t<decltype(e)>> >= 3) {
+                        return boost::add_edge(u, v, std::get<2>(e), *this);
+                    } else {
+                        return boost::add_edge(u, v, *this);
+                    }
+                }();
+                this->number_edge(result);
+            }
+            this->grow_tables();
         }
 
         /**
@@ -343,7 +545,7 @@ namespace py {
          * @return Vertex Source vertex of the edge
          */
         template <typename Edge> auto source(const Edge& e) const -> Vertex {
-            return boost::source(e, *this);
+            return detail::bgl_source(e, *this);
         }
 
         /**
@@ -356,7 +558,7 @@ namespace py {
          * @return Vertex Target vertex of the edge
          */
         template <typename Edge> auto target(const Edge& e) const -> Vertex {
-            return boost::target(e, *this);
+            return detail::bgl_target(e, *this);
         }
 
         /**
@@ -367,10 +569,125 @@ namespace py {
          * @return std::pair<Vertex, Vertex> Pair of (source, target) vertices
          */
         template <typename Edge> [[nodiscard]] auto end_points(const Edge& e) const {
-            auto s = boost::source(e, *this);
-            auto t = boost::target(e, *this);
+            auto s = detail::bgl_source(e, *this);
+            auto t = detail::bgl_target(e, *this);
             return std::make_pair(s, t);
         }
+
+        /**
+         * @brief Node attribute table, as in NetworkX `G.nodes`
+         *
+         * Columns are indexed by vertex id. They are grown when add_edge(),
+         * add_nodes_from() or add_edges_from() adds nodes, so accessing
+         * them costs no more than a vector lookup.
+         *
+         * @code
+         * G.node_data().add_column<double>("weight", 1.0);
+         * std::span<double> weight = G.node_data().column<double>("weight");
+         * @endcode
+         */
+        auto node_data() -> AttributeTable& { return this->_node_data; }
+        auto node_data() const -> const AttributeTable& { return this->_node_data; }
+
+        /**
+         * @brief Edge attribute table, indexed by edge id
+         *
+         * Edge ids come from the graph's `edge_index` property: CsrGraph
+         * provides them, and for an adjacency_list with an `edge_index_t`
+         * edge property GrAdaptor numbers the edges it adds. Like the node
+         * columns, the edge columns grow as edges are added through the
+         * adaptor.
+         */
+        auto edge_data() -> AttributeTable& { return this->_edge_data; }
+        auto edge_data() const -> const AttributeTable& { return this->_edge_data; }
+
+        /**
+         * @brief Id of an edge in the edge attribute columns
+         */
+        template <typename Edge> [[nodiscard]] auto edge_id(const Edge& e) const -> std::size_t {
+            return detail::bgl_edge_index(e, *this);
+        }
+
+        /**
+         * @brief Node attribute, as in NetworkX `G.nodes[v][name]`
+         *
+         * @throw std::out_of_range if there is no such column
+         * @throw std::invalid_argument if the column has another type
+         */
+        template <typename T> auto node_attr(Vertex v, std::string_view name) -> T& {
+            return this->node_data().template at<T>(static_cast<std::size_t>(v), name);
+        }
+
+        /**
+         * @brief Edge attribute of edge `e`
+         */
+        template <typename T, typename Edge> auto edge_attr(const Edge& e, std::string_view name)
+            -> T& {
+            return this->edge_data().template at<T>(this->edge_id(e), name);
+        }
+
+        /**
+         * @brief Edge attribute of the edge `(u, v)`, as in NetworkX `G[u][v][name]`
+         *
+         * @throw std::out_of_range if there is no edge from `u` to `v`
+         */
+        template <typename T> auto edge_attr(Vertex u, Vertex v, std::string_view name) -> T& {
+            const auto [e, found] = detail::bgl_edge(u, v, *this);
+            if (!found) throw std::out_of_range("no such edge");
+            return this->edge_attr<T>(e, name);
+        }
+
+      private:
+        // num_edges() of a directed adjacency_list visits every vertex, so the
+        // edges added through this adaptor are counted in _num_edges instead
+        template <typename Result> void number_edge(const Result& result) {
+            if (!result.second) return;
+            if constexpr (detail::stores_edge_index<_Graph>::value) {
+                boost::put(boost::edge_index, *this, result.first, this->_num_edges);
+            }
+            ++this->_num_edges;
+        }
+
+        // Give the edges of a wrapped graph the ids 0 .. m-1 unless they have them
+        void number_existing_edges() {
+            auto seen = std::vector<char>(this->_num_edges);
+            auto dense = true;
+            for (auto [first, last] = detail::bgl_edges(*this); first != last && dense; ++first) {
+                const auto id = detail::bgl_edge_index(*first, *this);
+                dense = id < seen.size() && seen[id] == 0;
+                if (dense) seen[id] = 1;
+            }
+            if (dense) return;
+            auto id = std::size_t{0};
+            for (auto [first, last] = detail::bgl_edges(*this); first != last; ++first) {
+                boost::put(boost::edge_index, *this, *first, id++);
+            }
+        }
+
+        template <typename Int> static auto to_index(Int v) -> std::size_t {
+            if constexpr (std::is_signed_v<Int>) {
+                if (v < 0) throw std::out_of_range("negative node id");
+            }
+            return static_cast<std::size_t>(v);
+        }
+
+        void grow_tables() {
+            const auto num_nodes = static_cast<std::size_t>(this->number_of_nodes());
+            if (this->_node_data.size() != num_nodes) this->_node_data.resize(num_nodes);
+            if (this->_edge_data.size() != this->_num_edges) {
+                this->_edge_data.resize(this->_num_edges);
+            }
+        }
+
+        void grow_to(std::size_t num_nodes) {
+            while (static_cast<std::size_t>(this->number_of_nodes()) < num_nodes) {
+                boost::add_vertex(*this);
+            }
+        }
+
+        std::size_t _num_edges{};
+        AttributeTable _node_data{};
+        AttributeTable _edge_data{};
     };
 
 }  // namespace py
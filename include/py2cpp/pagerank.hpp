@@ -0,0 +1,408 @@
+/**
+ * @file pagerank.hpp
+ * @brief PageRank and Katz centrality as parallel sparse matrix-vector products
+ *
+ * Provides the NetworkX-style py::pagerank(), py::personalized_pagerank()
+ * and py::katz_centrality(). Each power iteration is one product with the
+ * transposed adjacency matrix, computed pull-style: every vertex sums the
+ * scores of its in-neighbours from a CSR copy of the in-edges, so no two
+ * threads write to the same entry and no atomics are needed. The vertices
+ * are cut into parts holding about the same number of in-edges, which
+ * keeps the threads busy on graphs with skewed degrees.
+ *
+ * PageRank divides every score by the out-degree (or out-weight) once per
+ * iteration, so the inner loop of the unweighted product is a plain sum.
+ * personalized_pagerank() iterates one vector per seed at once, stored
+ * vertex by vertex, so the innermost loop runs over contiguous values of
+ * the seeds and is vectorized by the compiler.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/pending/property.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "nx2bgl.hpp"
+#include "thread_pool.hpp"
+
+namespace py {
+
+    namespace detail {
+
+        /**
+         * @brief Transposed adjacency matrix of a graph, split into balanced parts
+         *
+         * @tparam Vertex Unsigned integral vertex type
+         */
+        template <typename Vertex> class LinkMatrix {
+            static_assert(std::is_unsigned_v<Vertex>, "Vertex must be an unsigned integer type");
+
+            ThreadPool& _pool;
+            std::size_t _n{};
+            CsrGraph<double, Vertex> _in{};  // row v: the in-edges of v (no weights for all 1)
+            std::vector<double> _out_weight{};  // out-degree or total out-weight of every vertex
+            std::vector<std::size_t> _bounds{};  // first vertex of every part
+
+          public:
+            // Unit weights
+            template <typename Graph> LinkMatrix(ThreadPool& pool, const Graph& gra) : _pool{pool} {
+                auto own = CsrGraph<boost::no_property, Vertex>{};
+                const auto [offsets, targets] = csr_arrays<Vertex>(gra, own);
+                this->build(offsets, targets, std::span<const double>{});
+            }
+
+            // The weight `weight_of(e)` of every edge `e`
+            template <typename Graph, typename WeightOf>
+            LinkMatrix(ThreadPool& pool, const Graph& gra, WeightOf&& weight_of) : _pool{pool} {
+                auto offsets = std::vector<std::size_t>{};
+                auto targets = std::vector<Vertex>{};
+                auto weights = std::vector<double>{};
+                csr_fill(gra, offsets, targets, [&](std::size_t pos, const auto& e) {
+                    if (weights.empty()) weights.resize(targets.size());
+                    weights[pos] = static_cast<double>(weight_of(e));
+                });
+                weights.resize(targets.size());
+                for (const auto w : weights) {
+                    if (!(w >= 0.0)) throw std::invalid_argument("negative edge weight");
+                }
+                this->build(offsets, targets, weights);
+            }
+
+            [[nodiscard]] auto num_vertices() const noexcept -> std::size_t { return this->_n; }
+
+            [[nodiscard]] auto out_weight(std::size_t v) const -> double {
+                return this->_out_weight[v];
+            }
+
+            [[nodiscard]] auto num_parts() const noexcept -> std::size_t {
+                return this->_bounds.size() - 1;
+            }
+
+            // Call body(part, lo, hi) for the vertices `lo .. hi-1` of every part, in parallel
+            template <typename Body> void for_parts(Body&& body) const {
+                const auto parts = this->num_parts();
+                parallel_for(this->_pool, parts, parts,
+                             [&](std::size_t, std::size_t lo, std::size_t hi) {
+                                 for (auto p = lo; p != hi; ++p) {
+                                     body(p, this->_bounds[p], this->_bounds[p + 1]);
+                                 }
+                             });
+            }
+
+            // y[b] = sum of w * x[u * batch + b] over the in-edges (u, v) of weight w
+            void pull(std::size_t v, const double* x, double* y, std::size_t batch) const {
+                const auto offsets = this->_in.row_offsets();
+                const auto sources = this->_in.column_indices();
+                const auto weights = this->_in.edge_properties();
+                const auto* weight = weights.data();
+                const auto lo = offsets[v];
+                const auto hi = offsets[v + 1];
+                if (batch == 1) {
+                    auto sum = 0.0;
+                    if (weights.empty()) {
+                        for (auto k = lo; k != hi; ++k) sum += x[sources[k]];
+                    } else {
+                        for (auto k = lo; k != hi; ++k) sum += weight[k] * x[sources[k]];
+                    }
+                    y[0] = sum;
+                    return;
+                }
+                std::fill(y, y + batch, 0.0);
+                for (auto k = lo; k != hi; ++k) {
+                    const auto w = weights.empty() ? 1.0 : weight[k];
+                    const auto* xu = x + static_cast<std::size_t>(sources[k]) * batch;
+                    for (auto b = std::size_t{0}; b != batch; ++b) y[b] += w * xu[b];
+                }
+            }
+
+          private:
+            void build(std::span<const std::size_t> offsets, std::span<const Vertex> targets,
+                       std::span<const double> weights) {
+                const auto n = offsets.size() - 1;
+                const auto m = targets.size();
+                this->_n = n;
+                this->_out_weight.assign(n, 0.0);
+                auto reversed = std::vector<std::pair<Vertex, Vertex>>(m);
+                for (auto u = std::size_t{0}; u != n; ++u) {
+                    for (auto i = offsets[u]; i != offsets[u + 1]; ++i) {
+                        reversed[i] = {targets[i], static_cast<Vertex>(u)};
+                        this->_out_weight[u] += weights.empty() ? 1.0 : weights[i];
+                    }
+                }
+                // Reversed in the order of `targets`, so `weights` lines up with the edges
+                this->_in = CsrGraph<double, Vertex>(this->_pool, n, reversed, weights);
+
+                // Parts of about equal cost, counting one per vertex and one per in-edge
+                const auto in_offsets = this->_in.row_offsets();
+                const auto parts = std::min(8 * (this->_pool.size() + 1), (n + m) / 4096 + 1);
+                const auto total = n + m;
+                this->_bounds.assign(1, 0);
+                auto v = std::size_t{0};
+                for (auto p = std::size_t{1}; p != parts; ++p) {
+                    const auto goal = total / parts * p;
+                    while (v != n && in_offsets[v] + v < goal) ++v;
+                    this->_bounds.push_back(v);
+                }
+                this->_bounds.push_back(n);
+            }
+        };
+
+        /**
+         * @brief Power iteration of PageRank for `seeds.size()` seeds at once
+         *
+         * With no seeds a single vector is computed with uniform teleports;
+         * otherwise vector `b` teleports to `seeds[b]`. Dangling vertices
+         * distribute their score like the teleports, as in NetworkX.
+         *
+         * @return std::vector<double> Scores, vertex by vertex (`n * batch` entries)
+         */
+        template <typename Vertex>
+        auto pagerank_power(const LinkMatrix<Vertex>& mat, std::span<const Vertex> seeds,
+                            double alpha, std::size_t max_iter, double tol)
+            -> std::vector<double> {
+            const auto n = mat.num_vertices();
+            if (n == 0) return {};
+            for (const auto s : seeds) {
+                if (static_cast<std::size_t>(s) >= n) {
+                    throw std::out_of_range("seed is not a vertex of the graph");
+                }
+            }
+            const auto batch = std::max(seeds.size(), std::size_t{1});
+            const auto parts = mat.num_parts();
+            const auto uniform = 1.0 / static_cast<double>(n);
+            // Teleport target of vector b: every vertex, or vertex seeds[b]
+            auto teleport = std::vector<double>(n * batch, seeds.empty() ? uniform : 0.0);
+            for (auto b = std::size_t{0}; b != seeds.size(); ++b) {
+                teleport[static_cast<std::size_t>(seeds[b]) * batch + b] = 1.0;
+            }
+            auto inv_out = std::vector<double>(n);
+            for (auto v = std::size_t{0}; v != n; ++v) {
+                inv_out[v] = mat.out_weight(v) > 0.0 ? 1.0 / mat.out_weight(v) : 0.0;
+            }
+
+            auto x = std::vector<double>(n * batch, uniform);
+            auto next = std::vector<double>(n * batch);
+            auto share = std::vector<double>(n * batch);  // x divided by the out-weight
+            auto next_share = std::vector<double>(n * batch);
+            auto dangling = std::vector<double>(batch);  // total x of the dangling vertices
+            // Per-part sums: dangling score of the next vector, and its change
+            auto part_dangling = std::vector<double>(parts * batch);
+            auto part_change = std::vector<double>(parts * batch);
+
+            mat.for_parts([&](std::size_t p, std::size_t lo, std::size_t hi) {
+                auto* dang = part_dangling.data() + p * batch;
+                std::fill(dang, dang + batch, 0.0);
+                for (auto v = lo; v != hi; ++v) {
+                    for (auto b = std::size_t{0}; b != batch; ++b) {
+                        share[v * batch + b] = x[v * batch + b] * inv_out[v];
+                        if (inv_out[v] == 0.0) dang[b] += x[v * batch + b];
+                    }
+                }
+            });
+            for (auto iter = std::size_t{0}; iter != max_iter; ++iter) {
+                std::fill(dangling.begin(), dangling.end(), 0.0);
+                for (auto p = std::size_t{0}; p != parts; ++p) {
+                    for (auto b = std::size_t{0}; b != batch; ++b) {
+                        dangling[b] += part_dangling[p * batch + b];
+                    }
+                }
+                mat.for_parts([&](std::size_t p, std::size_t lo, std::size_t hi) {
+                    auto* dang = part_dangling.data() + p * batch;
+                    auto* change = part_change.data() + p * batch;
+                    std::fill(dang, dang + batch, 0.0);
+                    std::fill(change, change + batch, 0.0);
+                    for (auto v = lo; v != hi; ++v) {
+                        auto* y = next.data() + v * batch;
+                        const auto* t = teleport.data() + v * batch;
+                        mat.pull(v, share.data(), y, batch);
+                        for (auto b = std::size_t{0}; b != batch; ++b) {
+                            y[b] = alpha * (y[b] + dangling[b] * t[b]) + (1.0 - alpha) * t[b];
+                            change[b] += std::abs(y[b] - x[v * batch + b]);
+                            next_share[v * batch + b] = y[b] * inv_out[v];
+                            if (inv_out[v] == 0.0) dang[b] += y[b];
+                        }
+                    }
+                });
+                std::swap(x, next);
+                std::swap(share, next_share);
+                auto converged = true;
+                for (auto b = std::size_t{0}; b != batch; ++b) {
+                    auto change = 0.0;
+                    for (auto p = std::size_t{0}; p != parts; ++p) {
+                        change += part_change[p * batch + b];
+                    }
+                    converged = converged && change < static_cast<double>(n) * tol;
+                }
+                if (converged) return x;
+            }
+            throw std::runtime_error("power iteration failed to converge");
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief PageRank of every vertex, as in NetworkX `nx.pagerank(G)`
+     *
+     * Computed on a ThreadPool by power iteration. The scores sum to 1.
+     * An undirected BGL graph counts every edge in both directions.
+     *
+     * @param[in] pool Pool running the iterations
+     * @param[in] gra The graph; vertices must be `0 .. n-1`
+     * @param[in] alpha Damping factor
+     * @param[in] max_iter Maximum number of iterations
+     * @param[in] tol Stop when the scores change by less than `n * tol` in total
+     * @return std::vector<double> The score of every vertex
+     * @throw std::runtime_error if the iteration does not converge
+     */
+    template <typename Graph>
+    auto pagerank(ThreadPool& pool, const Graph& gra, double alpha = 0.85,
+                  std::size_t max_iter = 100, double tol = 1.0e-6) -> std::vector<double> {
+        using Vertex = typename boost::graph_traits<Graph>::vertex_descriptor;
+        const auto mat = detail::LinkMatrix<Vertex>(pool, gra);
+        return detail::pagerank_power<Vertex>(mat, {}, alpha, max_iter, tol);
+    }
+
+    /**
+     * @brief PageRank with edge weights from a property map
+     *
+     * An edge `(u, v)` passes the share `weight(e) / (total out-weight of u)`
+     * of the score of `u` to `v`.
+     *
+     * @throw std::invalid_argument for a negative weight
+     */
+    template <typename Graph, typename WeightMap>
+        requires(!std::is_arithmetic_v<WeightMap>)
+    auto pagerank(ThreadPool& pool, const Graph& gra, WeightMap weight, double alpha = 0.85,
+                  std::size_t max_iter = 100, double tol = 1.0e-6) -> std::vector<double> {
+        using Vertex = typename boost::graph_traits<Graph>::vertex_descriptor;
+        const auto mat = detail::LinkMatrix<Vertex>(
+            pool, gra, [&weight](const auto& e) { return get(weight, e); });
+        return detail::pagerank_power<Vertex>(mat, {}, alpha, max_iter, tol);
+    }
+
+    /**
+     * @brief PageRank weighted by the edge attribute `weight`, as in NetworkX
+     *
+     * @code
+     * auto rank = py::pagerank<double>(pool, G, "weight");
+     * @endcode
+     *
+     * @tparam Weight Type of the attribute column
+     * @throw std::invalid_argument for a negative weight
+     */
+    template <typename Weight, typename Graph>
+    auto pagerank(ThreadPool& pool, const GrAdaptor<Graph>& gra, std::string_view weight,
+                  double alpha = 0.85, std::size_t max_iter = 100, double tol = 1.0e-6)
+        -> std::vector<double> {
+        using Vertex = typename GrAdaptor<Graph>::Vertex;
+        const auto column = gra.edge_data().template column<Weight>(weight);
+        const auto mat = detail::LinkMatrix<Vertex>(pool, gra, [&](const auto& e) {
+            const auto id = gra.edge_id(e);
+            if (id >= column.size()) throw std::out_of_range("edge without attributes");
+            return column[id];
+        });
+        return detail::pagerank_power<Vertex>(mat, {}, alpha, max_iter, tol);
+    }
+
+    /**
+     * @brief Personalized PageRank for many seeds at once
+     *
+     * Result `b` is NetworkX's `nx.pagerank(G, personalization={seeds[b]: 1})`.
+     * All the vectors are iterated together until every one has converged,
+     * so one sweep over the in-edges serves all the seeds.
+     *
+     * @param[in] pool Pool running the iterations
+     * @param[in] gra The graph; vertices must be `0 .. n-1`
+     * @param[in] seeds The vertex every walk restarts from, one per result
+     * @param[in] alpha Damping factor
+     * @param[in] max_iter Maximum number of iterations
+     * @param[in] tol Stop when every vector changes by less than `n * tol` in total
+     * @return std::vector<std::vector<double>> The scores for every seed
+     * @throw std::out_of_range if a seed is not a vertex
+     * @throw std::runtime_error if the iteration does not converge
+     */
+    template <typename Graph,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto personalized_pagerank(ThreadPool& pool, const Graph& gra,
+                               std::span<const std::type_identity_t<Vertex>> seeds,
+                               double alpha = 0.85, std::size_t max_iter = 100,
+                               double tol = 1.0e-6) -> std::vector<std::vector<double>> {
+        if (seeds.empty()) return {};
+        const auto mat = detail::LinkMatrix<Vertex>(pool, gra);
+        const auto x = detail::pagerank_power<Vertex>(mat, seeds, alpha, max_iter, tol);
+        const auto n = mat.num_vertices();
+        auto result = std::vector<std::vector<double>>(seeds.size(), std::vector<double>(n));
+        for (auto v = std::size_t{0}; v != n; ++v) {
+            for (auto b = std::size_t{0}; b != seeds.size(); ++b) {
+                result[b][v] = x[v * seeds.size() + b];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Katz centrality of every vertex, as in NetworkX `nx.katz_centrality(G)`
+     *
+     * Iterates `x[v] = alpha * (sum of x[u] over the edges (u, v)) + beta`
+     * from zero. `alpha` must be below the inverse of the largest
+     * eigenvalue of the adjacency matrix for the iteration to converge.
+     *
+     * @param[in] pool Pool running the iterations
+     * @param[in] gra The graph; vertices must be `0 .. n-1`
+     * @param[in] alpha Attenuation factor
+     * @param[in] beta Weight given to every vertex
+     * @param[in] max_iter Maximum number of iterations
+     * @param[in] tol Stop when the scores change by less than `n * tol` in total
+     * @param[in] normalized Scale the result to unit Euclidean norm
+     * @return std::vector<double> The score of every vertex
+     * @throw std::runtime_error if the iteration does not converge
+     */
+    template <typename Graph,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto katz_centrality(ThreadPool& pool, const Graph& gra, double alpha = 0.1,
+                         double beta = 1.0, std::size_t max_iter = 1000, double tol = 1.0e-6,
+                         bool normalized = true) -> std::vector<double> {
+        const auto mat = detail::LinkMatrix<Vertex>(pool, gra);
+        const auto n = mat.num_vertices();
+        auto x = std::vector<double>(n);
+        auto next = std::vector<double>(n);
+        auto part_change = std::vector<double>(mat.num_parts());
+        for (auto iter = std::size_t{0}; iter != max_iter; ++iter) {
+            mat.for_parts([&](std::size_t p, std::size_t lo, std::size_t hi) {
+                auto change = 0.0;
+                for (auto v = lo; v != hi; ++v) {
+                    mat.pull(v, x.data(), next.data() + v, 1);
+                    next[v] = alpha * next[v] + beta;
+                    change += std::abs(next[v] - x[v]);
+                }
+                part_change[p] = change;
+            });
+            std::swap(x, next);
+            auto change = 0.0;
+            for (const auto c : part_change) change += c;
+            if (change < static_cast<double>(n) * tol) {
+                if (normalized) {
+                    auto norm = 0.0;
+                    for (const auto s : x) norm += s * s;
+                    const auto scale = norm > 0.0 ? 1.0 / std::sqrt(norm) : 1.0;
+                    for (auto& s : x) s *= scale;
+                }
+                return x;
+            }
+        }
+        throw std::runtime_error("power iteration failed to converge");
+    }
+
+}  // namespace py
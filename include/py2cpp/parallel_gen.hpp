@@ -0,0 +1,327 @@
+/**
+ * @file parallel_gen.hpp
+ * @brief Drive a RecursiveGenerator across a work-stealing thread pool
+ *
+ * Provides ParallelGenerator, which iterates a RecursiveGenerator whose
+ * coroutines mark large subtrees with `co_yield py::spawn(child)`. Every
+ * spawned subtree becomes a separate job on a ThreadPool, so tree and DAG
+ * enumerations (backtracking searches in particular) run on all cores while
+ * the consumer keeps a plain input-iterator loop.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "recursive_gen.hpp"
+#include "thread_pool.hpp"
+
+namespace py {
+
+    /**
+     * @brief Parallel iteration over a RecursiveGenerator tree.
+     *
+     * The root generator runs as one pool job. Whenever a generator in the
+     * tree yields `py::spawn(child)`, the child subtree is submitted as a
+     * further job and its parent carries on. Each job buffers its values in
+     * chunks and publishes them to the consumer thread.
+     *
+     * Two merge orders are supported:
+     *
+     * - unordered (default): chunks are handed out as soon as they are
+     *   published, so the values arrive in no particular order;
+     * - ordered: every spawn leaves a placeholder in its parent's output,
+     *   and the consumer reads the subtrees in place, so the values come
+     *   out exactly as sequential iteration would produce them. Later
+     *   subtrees keep running (and buffering) while the consumer waits for
+     *   an earlier one.
+     *
+     * Jobs never block on the consumer, so the buffered output is not
+     * bounded. If a generator throws, the remaining work is cancelled and
+     * the exception is rethrown from the iterator. Destroying the
+     * ParallelGenerator (e.g. after breaking out of the loop) cancels all
+     * jobs and waits for them to finish.
+     *
+     * The consumer must not be one of the pool's own workers.
+     *
+     * @tparam T Value type (must be copy constructible)
+     */
+    template <typename T> class ParallelGenerator {
+        static_assert(!std::is_reference_v<T>, "ParallelGenerator stores its values by copy");
+
+        using chunk_type = std::vector<T>;
+
+        struct Segment;
+        using entry_type = std::variant<chunk_type, std::shared_ptr<Segment>>;
+
+        // Output of one job in ordered mode (guarded by Shared::mutex)
+        struct Segment {
+            std::deque<entry_type> entries{};
+            bool done{false};
+        };
+
+        struct Shared {
+            ThreadPool& pool;
+            bool ordered;
+            std::size_t chunk_size;
+
+            std::mutex mutex{};
+            std::condition_variable ready{};
+            std::deque<chunk_type> chunks{};  // unordered mode
+            std::size_t active{0};            // jobs not finished yet
+            std::exception_ptr exception{};
+            std::atomic<bool> cancelled{false};
+
+            Shared(ThreadPool& pool_, bool ordered_, std::size_t chunk_size_)
+                : pool(pool_), ordered(ordered_), chunk_size(chunk_size_) {}
+        };
+
+        /**
+         * @brief One pool job: drains a (sub)tree, spawning further jobs
+         */
+        class Drain final : public detail::SpawnHandler<T> {
+            std::shared_ptr<Shared> _shared;
+            std::shared_ptr<Segment> _segment;  // null in unordered mode
+            chunk_type _chunk{};
+
+          public:
+            Drain(std::shared_ptr<Shared> shared, std::shared_ptr<Segment> segment)
+                : _shared(std::move(shared)), _segment(std::move(segment)) {}
+
+            static void submit(const std::shared_ptr<Shared>& shared, RecursiveGenerator<T> gen,
+                               std::shared_ptr<Segment> segment) {
+                {
+                    auto lock = std::lock_guard{shared->mutex};
+                    ++shared->active;
+                }
+                shared->pool.submit([shared, segment = std::move(segment),
+                                     gen = std::move(gen)]() mutable {
+                    Drain{shared, std::move(segment)}.run(std::move(gen));
+                });
+            }
+
+            void run(RecursiveGenerator<T> gen) noexcept {
+                auto& shared = *this->_shared;
+                try {
+                    if (gen.m_promise != nullptr) {
+                        gen.m_promise->m_spawnHandler = this;
+                    }
+                    this->_chunk.reserve(shared.chunk_size);
+                    for (auto it = gen.begin(); it != gen.end(); ++it) {
+                        if (shared.cancelled.load(std::memory_order_relaxed)) break;
+                        this->_chunk.push_back(*it);
+                        if (this->_chunk.size() == shared.chunk_size) {
+                            this->flush(nullptr);
+                        }
+                    }
+                    this->flush(nullptr);
+                } catch (...) {
+                    auto lock = std::lock_guard{shared.mutex};
+                    if (shared.exception == nullptr) {
+                        shared.exception = std::current_exception();
+                    }
+                    shared.cancelled.store(true, std::memory_order_relaxed);
+                }
+                gen = RecursiveGenerator<T>{};  // destroy the frames before signalling
+                {
+                    auto lock = std::lock_guard{shared.mutex};
+                    if (this->_segment) this->_segment->done = true;
+                    --shared.active;
+                }
+                shared.ready.notify_all();
+            }
+
+            void spawn(RecursiveGenerator<T>&& child) override {
+                auto& shared = *this->_shared;
+                if (shared.cancelled.load(std::memory_order_relaxed)) {
+                    auto dropped = std::move(child);  // skip the subtree altogether
+                    return;
+                }
+                auto segment = shared.ordered ? std::make_shared<Segment>() : nullptr;
+                this->flush(segment);
+                submit(this->_shared, std::move(child), std::move(segment));
+            }
+
+          private:
+            // Publish the pending chunk, followed by `child` (ordered mode)
+            void flush(const std::shared_ptr<Segment>& child) {
+                auto& shared = *this->_shared;
+                if (this->_chunk.empty() && !child) return;
+                {
+                    auto lock = std::lock_guard{shared.mutex};
+                    if (!this->_chunk.empty()) {
+                        if (this->_segment) {
+                            this->_segment->entries.emplace_back(std::move(this->_chunk));
+                        } else {
+                            shared.chunks.push_back(std::move(this->_chunk));
+                        }
+                    }
+                    if (child) this->_segment->entries.emplace_back(child);
+                }
+                shared.ready.notify_all();
+                this->_chunk = chunk_type{};
+                this->_chunk.reserve(shared.chunk_size);
+            }
+        };
+
+        /**
+         * @brief Consumer side: the chunk being read and, in ordered mode,
+         *        the path of segments leading to it
+         */
+        struct Cursor {
+            std::shared_ptr<Shared> shared;
+            std::vector<std::shared_ptr<Segment>> path{};
+            chunk_type chunk{};
+            std::size_t index{0};
+
+            // Load the next non-empty chunk; false at the end
+            auto refill() -> bool {
+                this->chunk.clear();
+                this->index = 0;
+                auto lock = std::unique_lock{this->shared->mutex};
+                for (;;) {
+                    if (this->shared->exception != nullptr) {
+                        std::rethrow_exception(this->shared->exception);
+                    }
+                    if (!this->shared->ordered) {
+                        if (!this->shared->chunks.empty()) {
+                            this->chunk = std::move(this->shared->chunks.front());
+                            this->shared->chunks.pop_front();
+                            return true;
+                        }
+                        if (this->shared->active == 0) return false;
+                    } else {
+                        if (this->path.empty()) return false;
+                        auto& segment = *this->path.back();
+                        if (!segment.entries.empty()) {
+                            auto entry = std::move(segment.entries.front());
+                            segment.entries.pop_front();
+                            if (auto* chunk_ = std::get_if<chunk_type>(&entry)) {
+                                this->chunk = std::move(*chunk_);
+                                return true;
+                            }
+                            this->path.push_back(std::get<std::shared_ptr<Segment>>(entry));
+                            continue;
+                        }
+                        if (segment.done) {
+                            this->path.pop_back();
+                            continue;
+                        }
+                    }
+                    this->shared->ready.wait(lock);
+                }
+            }
+        };
+
+        std::shared_ptr<Shared> _shared;
+        RecursiveGenerator<T> _root;
+        std::unique_ptr<Cursor> _cursor{};
+
+      public:
+        /**
+         * @brief Prepare a parallel iteration over `root` (started by begin())
+         *
+         * @param[in] pool Pool running the jobs (must outlive this object)
+         * @param[in] root Root generator
+         * @param[in] ordered Whether to reassemble the sequential order
+         * @param[in] chunk_size Number of values a job publishes at once
+         */
+        ParallelGenerator(ThreadPool& pool, RecursiveGenerator<T> root, bool ordered = false,
+                          std::size_t chunk_size = 256)
+            : _shared{std::make_shared<Shared>(pool, ordered,
+                                               chunk_size == 0 ? std::size_t{1} : chunk_size)},
+              _root{std::move(root)} {}
+
+        ParallelGenerator(ParallelGenerator&&) noexcept = default;
+        ParallelGenerator& operator=(ParallelGenerator&&) = delete;
+        ParallelGenerator(const ParallelGenerator&) = delete;
+        ParallelGenerator& operator=(const ParallelGenerator&) = delete;
+
+        ~ParallelGenerator() {
+            if (!this->_shared) return;
+            auto& shared = *this->_shared;
+            shared.cancelled.store(true, std::memory_order_relaxed);
+            auto lock = std::unique_lock{shared.mutex};
+            shared.ready.wait(lock, [&shared] { return shared.active == 0; });
+        }
+
+        class iterator {
+            Cursor* _cursor{};
+
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = T&;
+            using pointer = T*;
+
+            iterator() noexcept = default;
+            explicit iterator(Cursor* cursor) noexcept : _cursor(cursor) {}
+
+            iterator& operator++() {
+                if (++this->_cursor->index == this->_cursor->chunk.size()) {
+                    if (!this->_cursor->refill()) this->_cursor = nullptr;
+                }
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+
+            reference operator*() const noexcept {
+                return this->_cursor->chunk[this->_cursor->index];
+            }
+            pointer operator->() const noexcept { return std::addressof(operator*()); }
+
+            bool operator==(const iterator& other) const noexcept {
+                return this->_cursor == other._cursor;
+            }
+            bool operator!=(const iterator& other) const noexcept { return !(*this == other); }
+        };
+
+        /**
+         * @brief Submit the root job and wait for the first values
+         *
+         * May only be called once.
+         */
+        iterator begin() {
+            this->_cursor = std::make_unique<Cursor>(Cursor{this->_shared});
+            auto segment = this->_shared->ordered ? std::make_shared<Segment>() : nullptr;
+            if (segment) this->_cursor->path.push_back(segment);
+            Drain::submit(this->_shared, std::move(this->_root), std::move(segment));
+            if (!this->_cursor->refill()) return iterator{};
+            return iterator{this->_cursor.get()};
+        }
+
+        iterator end() noexcept { return iterator{}; }
+    };
+
+    /**
+     * @brief Iterate a RecursiveGenerator on a thread pool
+     *
+     * @code
+     * py::ThreadPool pool;
+     * for (auto val : py::parallel(pool, search(root))) { ... }
+     * @endcode
+     *
+     * @tparam T Value type
+     * @param[in] pool Pool running the jobs
+     * @param[in] root Root generator, which marks parallel subtrees with py::spawn()
+     * @param[in] ordered Whether to reassemble the sequential order
+     * @return ParallelGenerator<T>
+     */
+    template <typename T> auto parallel(ThreadPool& pool, RecursiveGenerator<T> root,
+                                        bool ordered = false) -> ParallelGenerator<T> {
+        return ParallelGenerator<T>{pool, std::move(root), ordered};
+    }
+
+}  // namespace py
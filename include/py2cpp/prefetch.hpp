@@ -0,0 +1,336 @@
+/**
+ * @file prefetch.hpp
+ * @brief Run a generator on a worker thread ahead of its consumer
+ *
+ * Provides a bounded lock-free single-producer/single-consumer ring buffer
+ * (SpscRing) and the prefetch() adaptor, which drives a Generator (or any
+ * other input range) on a background thread so that producing and consuming
+ * stages overlap.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace py {
+
+    /**
+     * @brief Bounded lock-free single-producer/single-consumer ring buffer.
+     *
+     * The producer and the consumer each own one monotonically increasing
+     * position counter; slots are addressed modulo the capacity, which is
+     * rounded up to a power of two. Both sides keep a cached copy of the
+     * other side's counter to avoid touching the shared cache line on every
+     * operation.
+     *
+     * The top bit of each counter doubles as a flag: the producer sets it in
+     * its counter to close the ring, the consumer sets it in its counter to
+     * cancel production. The blocking push() / wait_front() calls park on the
+     * counters with `std::atomic::wait` and wake up on either event.
+     *
+     * @tparam T Element type
+     */
+    template <typename T> class SpscRing {
+        static constexpr auto flag = std::size_t{1}
+                                     << (std::numeric_limits<std::size_t>::digits - 1);
+        static constexpr std::size_t cache_line = 64;
+
+      public:
+        /**
+         * @brief Construct a ring with room for at least `capacity` elements
+         *
+         * @param[in] capacity Minimum number of slots (at least 1)
+         */
+        explicit SpscRing(std::size_t capacity)
+            : _capacity{std::bit_ceil(capacity == 0 ? std::size_t{1} : capacity)},
+              _slots{std::make_unique<std::optional<T>[]>(_capacity)} {}
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        [[nodiscard]] auto capacity() const noexcept -> std::size_t { return this->_capacity; }
+
+        // ---- producer side ----
+
+        /**
+         * @brief Append a value if there is room (producer only)
+         *
+         * @param[in] value Value to store
+         * @return true if the value was stored, false if the ring is full
+         */
+        template <typename U> auto try_push(U&& value) -> bool {
+            const auto tail = this->_tail.load(std::memory_order_relaxed);
+            if (tail - this->_head_cache == this->_capacity) {
+                this->_head_cache = this->_head.load(std::memory_order_acquire) & ~flag;
+                if (tail - this->_head_cache == this->_capacity) return false;
+            }
+            this->publish(tail, std::forward<U>(value));
+            return true;
+        }
+
+        /**
+         * @brief Append a value, waiting for room if necessary (producer only)
+         *
+         * @param[in] value Value to store
+         * @return true if the value was stored, false if the consumer cancelled
+         */
+        template <typename U> auto push(U&& value) -> bool {
+            const auto tail = this->_tail.load(std::memory_order_relaxed);
+            while (tail - this->_head_cache == this->_capacity) {
+                const auto head = this->_head.load(std::memory_order_acquire);
+                if ((head & flag) != 0) return false;
+                this->_head_cache = head;
+                if (tail - head == this->_capacity) {
+                    this->_head.wait(head, std::memory_order_acquire);
+                }
+            }
+            this->publish(tail, std::forward<U>(value));
+            return true;
+        }
+
+        /**
+         * @brief Signal that no more values will be pushed (producer only)
+         */
+        void close() noexcept {
+            this->_tail.fetch_or(flag, std::memory_order_release);
+            this->_tail.notify_one();
+        }
+
+        // ---- consumer side ----
+
+        /**
+         * @brief Wait until a value is available (consumer only)
+         *
+         * @return true if front() may be called, false if the ring is closed and drained
+         */
+        auto wait_front() -> bool {
+            const auto head = this->_head.load(std::memory_order_relaxed) & ~flag;
+            while (head == this->_tail_cache) {
+                const auto tail = this->_tail.load(std::memory_order_acquire);
+                this->_tail_cache = tail & ~flag;
+                if (head != this->_tail_cache) break;
+                if ((tail & flag) != 0) return false;
+                this->_tail.wait(tail, std::memory_order_acquire);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Oldest value in the ring (consumer only, after wait_front())
+         *
+         * @return T& Reference to the front value
+         */
+        auto front() noexcept -> T& {
+            const auto head = this->_head.load(std::memory_order_relaxed) & ~flag;
+            return *this->_slots[head & (this->_capacity - 1)];
+        }
+
+        /**
+         * @brief Discard the front value (consumer only)
+         */
+        void pop() noexcept {
+            const auto head = this->_head.load(std::memory_order_relaxed);
+            this->_slots[head & (this->_capacity - 1)].reset();
+            this->_head.store(head + 1, std::memory_order_release);
+            this->_head.notify_one();
+        }
+
+        /**
+         * @brief Ask the producer to stop (consumer only)
+         */
+        void cancel() noexcept {
+            this->_head.fetch_or(flag, std::memory_order_release);
+            this->_head.notify_one();
+        }
+
+      private:
+        template <typename U> void publish(std::size_t tail, U&& value) {
+            this->_slots[tail & (this->_capacity - 1)].emplace(std::forward<U>(value));
+            this->_tail.store(tail + 1, std::memory_order_release);
+            this->_tail.notify_one();
+        }
+
+        std::size_t _capacity;
+        std::unique_ptr<std::optional<T>[]> _slots;
+
+        // consumer-owned cache line
+        alignas(cache_line) std::atomic<std::size_t> _head{0};
+        std::size_t _tail_cache{0};
+
+        // producer-owned cache line
+        alignas(cache_line) std::atomic<std::size_t> _tail{0};
+        std::size_t _head_cache{0};
+    };
+
+    /**
+     * @brief Input range whose values are produced ahead on a worker thread.
+     *
+     * Created by prefetch(). The wrapped generator is moved to a background
+     * thread that moves each owned value (or copies each borrowed one) into an
+     * SpscRing; the consumer iterates the ring. The producer blocks while the
+     * ring is full (back-pressure), and an exception escaping the producer is
+     * rethrown to the consumer once the values produced before it have been
+     * consumed.
+     *
+     * Destroying a Prefetched before the end is reached cancels the producer
+     * at its next push and joins the worker thread.
+     *
+     * @tparam T Value type
+     */
+    template <typename T> class Prefetched {
+        struct Shared {
+            SpscRing<T> ring;
+            std::exception_ptr error;
+
+            explicit Shared(std::size_t capacity) : ring{capacity} {}
+        };
+
+      public:
+        /**
+         * @brief Start producing the values of `gen` on a worker thread
+         *
+         * @tparam Gen Input range type (e.g. Generator<T>)
+         * @param[in] gen The range to drain (moved to the worker)
+         * @param[in] capacity Number of values the producer may run ahead
+         */
+        template <typename Gen>
+        Prefetched(Gen gen, std::size_t capacity) : _shared{std::make_unique<Shared>(capacity)} {
+            auto* shared = this->_shared.get();
+            this->_worker = std::thread([shared, gen = std::move(gen)]() mutable {
+                try {
+                    for (auto it = gen.begin(); it != gen.end(); ++it) {
+                        if (!push_current(shared->ring, it)) break;
+                    }
+                } catch (...) {
+                    shared->error = std::current_exception();
+                }
+                shared->ring.close();
+            });
+        }
+
+        ~Prefetched() { this->stop(); }
+
+        Prefetched(Prefetched&&) noexcept = default;
+        Prefetched& operator=(Prefetched&& other) noexcept {
+            if (this != &other) {
+                this->stop();
+                this->_shared = std::move(other._shared);
+                this->_worker = std::move(other._worker);
+            }
+            return *this;
+        }
+
+        Prefetched(const Prefetched&) = delete;
+        Prefetched& operator=(const Prefetched&) = delete;
+
+        class iterator {
+            Shared* _shared{};
+
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = T&;
+            using pointer = T*;
+
+            iterator() noexcept = default;
+            explicit iterator(Shared* shared) noexcept : _shared{shared} {}
+
+            iterator& operator++() {
+                this->_shared->ring.pop();
+                this->advance();
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+
+            reference operator*() const noexcept { return this->_shared->ring.front(); }
+            pointer operator->() const noexcept { return std::addressof(operator*()); }
+
+            bool operator==(const iterator& other) const noexcept {
+                return this->_shared == other._shared;
+            }
+            bool operator!=(const iterator& other) const noexcept { return !(*this == other); }
+
+          private:
+            friend class Prefetched;
+
+            void advance() {
+                if (this->_shared->ring.wait_front()) return;
+                auto error = std::exchange(this->_shared->error, nullptr);
+                this->_shared = nullptr;
+                if (error != nullptr) std::rethrow_exception(error);
+            }
+        };
+
+        iterator begin() {
+            if (this->_shared == nullptr) return iterator{};
+            auto it = iterator{this->_shared.get()};
+            it.advance();
+            return it;
+        }
+
+        iterator end() noexcept { return iterator{}; }
+
+      private:
+        /**
+         * @brief Push the current value of `it`, moving it when the range owns it
+         *
+         * Values of move-only types and rvalues yielded by a Generator are
+         * moved into the ring; everything else is copied.
+         */
+        template <typename It> static auto push_current(SpscRing<T>& ring, It& it) -> bool {
+            if constexpr (!std::is_copy_constructible_v<T>) {
+                return ring.push(std::move(*it));
+            } else {
+                if constexpr (requires { it.owns_value(); }) {
+                    if (it.owns_value()) return ring.push(std::move(*it));
+                }
+                return ring.push(*it);
+            }
+        }
+
+        void stop() noexcept {
+            if (this->_worker.joinable()) {
+                this->_shared->ring.cancel();
+                this->_worker.join();
+            }
+        }
+
+        std::unique_ptr<Shared> _shared;
+        std::thread _worker;
+    };
+
+    /**
+     * @brief Drive a generator on a background thread
+     *
+     * The returned range yields the values of `gen`, in order,
+     * while the worker thread keeps up to `capacity` values ready ahead of
+     * the consumer.
+     *
+     * @code
+     * for (const auto& rec : py::prefetch(parse_records(file), 256)) {
+     *     process(rec);  // overlaps with parsing of the following records
+     * }
+     * @endcode
+     *
+     * @tparam Gen Input range type (e.g. Generator<T>)
+     * @param[in] gen The range to drain (moved to the worker)
+     * @param[in] capacity Size of the ring buffer between the two threads
+     * @return Prefetched<value type of Gen>
+     */
+    template <typename Gen> auto prefetch(Gen gen, std::size_t capacity = 64) {
+        using value_type = std::remove_cvref_t<decltype(*std::declval<Gen&>().begin())>;
+        return Prefetched<value_type>(std::move(gen), capacity);
+    }
+
+}  // namespace py
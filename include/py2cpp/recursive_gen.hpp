@@ -4,6 +4,9 @@
  *
  * Provides a RecursiveGenerator template that supports yielding sub-generators
  * via co_yield, enabling stackless recursive generation for tree/graph traversal.
+ * Nested frames are recycled through the FramePool, and control moves between
+ * parent and child frames by symmetric transfer, so neither deep nor long
+ * traversals grow the native stack.
  */
 
 #pragma once
@@ -14,8 +17,52 @@
 #include <iterator>
 #include <utility>
 
+#include "frame_alloc.hpp"
+
 namespace py {
 
+    template <typename T> class RecursiveGenerator;
+    template <typename T> class ParallelGenerator;
+
+    /**
+     * @brief Sub-generator marked as worth running in parallel, see spawn()
+     *
+     * @tparam T Value type of the generator
+     */
+    template <typename T> struct Spawned {
+        RecursiveGenerator<T> generator;
+    };
+
+    /**
+     * @brief Mark a sub-generator as a candidate for parallel execution
+     *
+     * `co_yield py::spawn(child)` behaves exactly like `co_yield child` when
+     * the generator is iterated directly. When it is driven by a
+     * ParallelGenerator, the child is instead handed to the thread pool as a
+     * separate task and the parent carries on immediately.
+     *
+     * @tparam T Value type of the generator
+     * @param[in] generator Sub-generator (typically a large subtree)
+     * @return Spawned<T> Value to `co_yield`
+     */
+    template <typename T> auto spawn(RecursiveGenerator<T> generator) -> Spawned<T> {
+        return Spawned<T>{std::move(generator)};
+    }
+
+    namespace detail {
+
+        /**
+         * @brief Receives the sub-generators spawned under a root generator
+         */
+        template <typename T> struct SpawnHandler {
+            virtual void spawn(RecursiveGenerator<T>&& child) = 0;
+
+          protected:
+            ~SpawnHandler() = default;
+        };
+
+    }  // namespace detail
+
     /**
      * @brief Recursive generator using C++20 coroutines with symmetric transfer.
      *
@@ -24,15 +71,25 @@ namespace py {
      * ideal for lazy tree/graph traversal.
      *
      * Uses promise chaining so only one coroutine frame is active at any depth.
+     * Descending into a child (`co_yield child`) and returning from a finished
+     * child to its parent are both symmetric transfers, so advancing the
+     * iterator costs a single resume() regardless of depth. Every frame,
+     * including the one of each nested generator, comes from the FramePool
+     * (see FrameAllocated), so a traversal allocates only while the tree is
+     * deeper than it has been before.
      *
      * @tparam T Value type to yield
      */
     template <typename T> class [[nodiscard]] RecursiveGenerator {
       public:
-        class promise_type final {
+        class promise_type final : public FrameAllocated {
           public:
             promise_type() noexcept
-                : m_value(nullptr), m_exception(nullptr), m_root(this), m_parentOrLeaf(this) {}
+                : m_value(nullptr),
+                  m_exception(nullptr),
+                  m_root(this),
+                  m_parentOrLeaf(this),
+                  m_spawnHandler(nullptr) {}
 
             promise_type(const promise_type&) = delete;
             promise_type(promise_type&&) = delete;
@@ -42,7 +99,32 @@ namespace py {
             }
 
             std::suspend_always initial_suspend() noexcept { return {}; }
-            std::suspend_always final_suspend() noexcept { return {}; }
+
+            /**
+             * A finished child hands control straight back to its parent,
+             * which resumes right after its `co_yield child`; the root
+             * returns to the consumer.
+             */
+            auto final_suspend() noexcept {
+                struct final_awaiter {
+                    bool await_ready() const noexcept { return false; }
+
+                    std::coroutine_handle<> await_suspend(
+                        std::coroutine_handle<promise_type> coro) const noexcept {
+                        auto& promise = coro.promise();
+                        if (promise.m_root == &promise) {
+                            return std::noop_coroutine();
+                        }
+                        auto* parent = promise.m_parentOrLeaf;
+                        promise.m_root->m_parentOrLeaf = parent;
+                        return std::coroutine_handle<promise_type>::from_promise(*parent);
+                    }
+
+                    void await_resume() const noexcept {}
+                };
+                return final_awaiter{};
+            }
+
             void return_void() noexcept {}
 
             void unhandled_exception() noexcept { m_exception = std::current_exception(); }
@@ -57,6 +139,18 @@ namespace py {
                 return {};
             }
 
+            /**
+             * Hands the child to the root's spawn handler if there is one,
+             * otherwise runs it inline like `co_yield child`.
+             */
+            auto yield_value(Spawned<T>&& spawned) {
+                auto* handler = m_root->m_spawnHandler;
+                if (handler != nullptr && spawned.generator.m_promise != nullptr) {
+                    handler->spawn(std::move(spawned.generator));
+                }
+                return yield_value(spawned.generator);
+            }
+
             auto yield_value(RecursiveGenerator&& generator) noexcept {
                 return yield_value(generator);
             }
@@ -65,9 +159,22 @@ namespace py {
                 struct awaitable {
                     awaitable(promise_type* childPromise) : m_childPromise(childPromise) {}
 
-                    bool await_ready() noexcept { return this->m_childPromise == nullptr; }
+                    bool await_ready() noexcept {
+                        return this->m_childPromise == nullptr
+                               || this->m_childPromise->is_complete();
+                    }
 
-                    void await_suspend(std::coroutine_handle<promise_type>) noexcept {}
+                    // Make the child the leaf and transfer to it; its final_suspend()
+                    // transfers back here once it has run to completion.
+                    std::coroutine_handle<> await_suspend(
+                        std::coroutine_handle<promise_type> parent) noexcept {
+                        auto& promise = parent.promise();
+                        promise.m_root->m_parentOrLeaf = this->m_childPromise;
+                        this->m_childPromise->m_root = promise.m_root;
+                        this->m_childPromise->m_parentOrLeaf = &promise;
+                        return std::coroutine_handle<promise_type>::from_promise(
+                            *this->m_childPromise);
+                    }
 
                     void await_resume() {
                         if (this->m_childPromise != nullptr) {
@@ -79,20 +186,7 @@ namespace py {
                     promise_type* m_childPromise;
                 };
 
-                if (generator.m_promise != nullptr) {
-                    m_root->m_parentOrLeaf = generator.m_promise;
-                    generator.m_promise->m_root = m_root;
-                    generator.m_promise->m_parentOrLeaf = this;
-                    generator.m_promise->resume();
-
-                    if (!generator.m_promise->is_complete()) {
-                        return awaitable{generator.m_promise};
-                    }
-
-                    m_root->m_parentOrLeaf = this;
-                }
-
-                return awaitable{nullptr};
+                return awaitable{generator.m_promise};
             }
 
             template <typename U> std::suspend_never await_transform(U&&) = delete;
@@ -117,15 +211,16 @@ namespace py {
                 return *m_parentOrLeaf->m_value;
             }
 
+            /**
+             * Resume the current leaf. It runs (transferring into children and
+             * back into parents as needed) until some frame yields a value or
+             * the root completes.
+             */
             void pull() noexcept {
+                assert(this == m_root);
                 assert(!m_parentOrLeaf->is_complete());
 
                 m_parentOrLeaf->resume();
-
-                while (m_parentOrLeaf != this && m_parentOrLeaf->is_complete()) {
-                    m_parentOrLeaf = m_parentOrLeaf->m_parentOrLeaf;
-                    m_parentOrLeaf->resume();
-                }
             }
 
           private:
@@ -137,6 +232,9 @@ namespace py {
             std::exception_ptr m_exception;
             promise_type* m_root;
             promise_type* m_parentOrLeaf;
+            detail::SpawnHandler<T>* m_spawnHandler;  // only used on the root
+
+            friend class ParallelGenerator<T>;
         };
 
         RecursiveGenerator() noexcept : m_promise(nullptr) {}
@@ -228,6 +326,7 @@ namespace py {
 
       private:
         friend class promise_type;
+        friend class ParallelGenerator<T>;
 
         explicit RecursiveGenerator(std::coroutine_handle<promise_type> h) noexcept
             : m_promise(&h.promise()) {}
@@ -0,0 +1,392 @@
+/**
+ * @file reorder.hpp
+ * @brief Vertex orderings that improve memory locality, and relabeling
+ *
+ * Traversals touch the neighbours of a vertex, so they run faster when
+ * neighbours have nearby ids: their entries in distance, rank or visited
+ * arrays then share cache lines. This file computes such orderings as a
+ * Permutation,
+ *
+ * - reverse_cuthill_mckee_ordering(): breadth-first from a
+ *   pseudo-peripheral vertex, low degrees first, reversed; keeps the
+ *   bandwidth (largest id difference along an edge) small;
+ * - degree_ordering(): hubs first, which packs the most accessed entries;
+ * - bfs_ordering(): plain breadth-first order, neighbours in storage order;
+ *
+ * and applies one with relabel_nodes(), which renumbers a CsrGraph or a
+ * GrAdaptor together with its node and edge attribute columns.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/pending/property.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "attributes.hpp"
+#include "csr_graph.hpp"
+#include "nx2bgl.hpp"
+
+namespace py {
+
+    /**
+     * @brief A renumbering of the vertices `0 .. n-1`, with its inverse
+     *
+     * @tparam Vertex Vertex type
+     */
+    template <typename Vertex = std::uint32_t> struct Permutation {
+        std::vector<Vertex> new_id;  ///< new id of every old vertex
+        std::vector<Vertex> old_id;  ///< old vertex of every new id
+
+        /**
+         * @brief The permutation that puts the vertices in the given order
+         *
+         * @param[in] order Every vertex exactly once; `order[i]` gets new id `i`
+         * @return Permutation
+         * @throw std::invalid_argument if `order` is not a permutation
+         */
+        static auto from_order(std::vector<Vertex> order) -> Permutation {
+            const auto n = order.size();
+            auto result = Permutation{};
+            result.new_id.assign(n, Vertex{0});
+            auto seen = std::vector<char>(n);
+            for (auto i = std::size_t{0}; i != n; ++i) {
+                const auto v = static_cast<std::size_t>(order[i]);
+                if (v >= n || seen[v] != 0) {
+                    throw std::invalid_argument("order is not a permutation of the vertices");
+                }
+                seen[v] = 1;
+                result.new_id[v] = static_cast<Vertex>(i);
+            }
+            result.old_id = std::move(order);
+            return result;
+        }
+
+        /**
+         * @brief Number of vertices
+         */
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return this->old_id.size(); }
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Cuthill-McKee order of every component (not yet reversed)
+         *
+         * Each component starts at a pseudo-peripheral vertex found with the
+         * George-Liu heuristic: repeat a breadth-first search from a vertex
+         * of least degree in the last level while that makes the search
+         * deeper.
+         */
+        template <typename Vertex>
+        auto cuthill_mckee(std::span<const std::size_t> offsets, std::span<const Vertex> targets)
+            -> std::vector<Vertex> {
+            const auto n = offsets.size() - 1;
+            const auto degree = [&](Vertex v) { return offsets[v + 1] - offsets[v]; };
+            const auto lighter = [&](Vertex a, Vertex b) {
+                return std::pair{degree(a), a} < std::pair{degree(b), b};
+            };
+            auto order = std::vector<Vertex>{};
+            order.reserve(n);
+            auto placed = std::vector<char>(n);
+
+            // Depth of a search from `root`, and a least-degree vertex of its last level
+            auto stamp = std::vector<std::size_t>(n);
+            auto round = std::size_t{0};
+            auto queue = std::vector<Vertex>{};
+            const auto search = [&](Vertex root) {
+                ++round;
+                queue.assign(1, root);
+                stamp[root] = round;
+                auto depth = std::size_t{0};
+                auto level = std::size_t{0};
+                for (;;) {
+                    const auto end = queue.size();
+                    for (auto i = level; i != end; ++i) {
+                        for (auto k = offsets[queue[i]]; k != offsets[queue[i] + 1]; ++k) {
+                            const auto v = targets[k];
+                            if (placed[v] == 0 && stamp[v] != round) {
+                                stamp[v] = round;
+                                queue.push_back(v);
+                            }
+                        }
+                    }
+                    if (queue.size() == end) {
+                        return std::pair{depth, *std::min_element(queue.begin() + level,
+                                                                  queue.end(), lighter)};
+                    }
+                    level = end;
+                    ++depth;
+                }
+            };
+
+            auto starts = std::vector<Vertex>(n);
+            std::iota(starts.begin(), starts.end(), Vertex{0});
+            std::stable_sort(starts.begin(), starts.end(),
+                             [&](Vertex a, Vertex b) { return degree(a) < degree(b); });
+            auto neighbours = std::vector<Vertex>{};
+            for (const auto start : starts) {
+                if (placed[start] != 0) continue;
+                auto root = start;
+                auto [depth, far] = search(root);
+                while (far != root) {
+                    const auto [far_depth, next] = search(far);
+                    if (far_depth <= depth) break;
+                    root = std::exchange(far, next);
+                    depth = far_depth;
+                }
+
+                // Breadth-first, unplaced neighbours by increasing degree
+                auto head = order.size();
+                order.push_back(root);
+                placed[root] = 1;
+                while (head != order.size()) {
+                    const auto u = order[head++];
+                    neighbours.clear();
+                    for (auto k = offsets[u]; k != offsets[u + 1]; ++k) {
+                        const auto v = targets[k];
+                        if (placed[v] == 0) {
+                            placed[v] = 1;
+                            neighbours.push_back(v);
+                        }
+                    }
+                    std::sort(neighbours.begin(), neighbours.end(), lighter);
+                    order.insert(order.end(), neighbours.begin(), neighbours.end());
+                }
+            }
+            return order;
+        }
+
+        // Renumbered copy of a CsrGraph; `old_edge[i]` is the old id of new edge `i`
+        template <typename EdgeProperty, typename Vertex>
+        auto relabel_csr(const CsrGraph<EdgeProperty, Vertex>& gra, const Permutation<Vertex>& perm,
+                         std::vector<std::size_t>& old_edge) -> CsrGraph<EdgeProperty, Vertex> {
+            const auto offsets = gra.row_offsets();
+            const auto targets = gra.column_indices();
+            const auto properties = gra.edge_properties();
+            const auto n = perm.size();
+            auto new_offsets = std::vector<std::size_t>(n + 1, 0);
+            for (auto u = std::size_t{0}; u != n; ++u) {
+                const auto old = perm.old_id[u];
+                new_offsets[u + 1] = new_offsets[u] + offsets[old + 1] - offsets[old];
+            }
+            auto new_targets = std::vector<Vertex>(targets.size());
+            auto new_properties = std::vector<EdgeProperty>(properties.size());
+            old_edge.resize(targets.size());
+            for (auto u = std::size_t{0}; u != n; ++u) {
+                auto pos = new_offsets[u];
+                const auto old = perm.old_id[u];
+                for (auto k = offsets[old]; k != offsets[old + 1]; ++k, ++pos) {
+                    new_targets[pos] = perm.new_id[targets[k]];
+                    if (!properties.empty()) new_properties[pos] = properties[k];
+                    old_edge[pos] = k;
+                }
+            }
+            return {std::move(new_offsets), std::move(new_targets), std::move(new_properties)};
+        }
+
+        // Renumbered copy of a mutable BGL graph with vertices `0 .. n-1`.
+        // Edges are added by increasing new source (the smaller end for an
+        // undirected graph) and, if the edges store an edge_index, numbered
+        // in that order; `old_edge[i]` is the old id of new edge `i`, which
+        // is its position in edges() when the graph stores no index.
+        template <typename Graph, typename Vertex>
+        auto relabel_bgl(const Graph& gra, const Permutation<Vertex>& perm,
+                         std::vector<std::size_t>& old_edge) -> Graph {
+            using Edge = typename boost::graph_traits<Graph>::edge_descriptor;
+            struct Item {
+                Vertex u;
+                Vertex v;
+                std::size_t old;
+                Edge e;
+            };
+            auto items = std::vector<Item>{};
+            items.reserve(static_cast<std::size_t>(bgl_num_edges(gra)));
+            auto [first, last] = bgl_edges(gra);
+            for (auto pos = std::size_t{0}; first != last; ++first, ++pos) {
+                auto u = perm.new_id[bgl_source(*first, gra)];
+                auto v = perm.new_id[bgl_target(*first, gra)];
+                if (boost::is_undirected_graph<Graph>::value && v < u) std::swap(u, v);
+                auto old = pos;
+                if constexpr (stores_edge_index<Graph>::value) old = bgl_edge_index(*first, gra);
+                items.push_back({u, v, old, *first});
+            }
+            std::stable_sort(items.begin(), items.end(),
+                             [](const Item& a, const Item& b) { return a.u < b.u; });
+
+            auto result = Graph(perm.size());
+            if constexpr (!std::is_same_v<typename Graph::vertex_property_type,
+                                          boost::no_property>) {
+                for (auto v = std::size_t{0}; v != perm.size(); ++v) {
+                    boost::put(boost::vertex_all, result, perm.new_id[v],
+                               boost::get(boost::vertex_all, gra, static_cast<Vertex>(v)));
+                }
+            }
+            old_edge.resize(items.size());
+            for (auto i = std::size_t{0}; i != items.size(); ++i) {
+                const auto& item = items[i];
+                const auto e = boost::add_edge(item.u, item.v,
+                                               boost::get(boost::edge_all, gra, item.e), result)
+                                   .first;
+                if constexpr (stores_edge_index<Graph>::value) {
+                    boost::put(boost::edge_index, result, e, i);
+                }
+                old_edge[i] = item.old;
+            }
+            return result;
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Reverse Cuthill-McKee ordering, as in NetworkX
+     *
+     * Gives neighbouring vertices nearby ids, which keeps the bandwidth of
+     * the adjacency matrix small. Components are ordered one after another.
+     * The ordering follows the out-edges, so for a directed graph it is
+     * meant for one stored in both directions; an undirected BGL graph is
+     * converted that way.
+     *
+     * @param[in] gra The graph; vertices must be `0 .. n-1`
+     * @return Permutation<Vertex>
+     */
+    template <typename Graph,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto reverse_cuthill_mckee_ordering(const Graph& gra) -> Permutation<Vertex> {
+        auto own = CsrGraph<boost::no_property, Vertex>{};
+        const auto [offsets, targets] = detail::csr_arrays<Vertex>(gra, own);
+        auto order = detail::cuthill_mckee<Vertex>(offsets, targets);
+        std::reverse(order.begin(), order.end());
+        return Permutation<Vertex>::from_order(std::move(order));
+    }
+
+    /**
+     * @brief Ordering by decreasing out-degree (ties keep their order)
+     *
+     * Puts the hubs, whose entries most edges lead to, next to each other.
+     *
+     * @param[in] gra The graph; vertices must be `0 .. n-1`
+     * @return Permutation<Vertex>
+     */
+    template <typename Graph,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto degree_ordering(const Graph& gra) -> Permutation<Vertex> {
+        auto own = CsrGraph<boost::no_property, Vertex>{};
+        const auto [offsets, targets] = detail::csr_arrays<Vertex>(gra, own);
+        auto order = std::vector<Vertex>(offsets.size() - 1);
+        std::iota(order.begin(), order.end(), Vertex{0});
+        std::stable_sort(order.begin(), order.end(), [&](Vertex a, Vertex b) {
+            return offsets[a + 1] - offsets[a] > offsets[b + 1] - offsets[b];
+        });
+        return Permutation<Vertex>::from_order(std::move(order));
+    }
+
+    /**
+     * @brief Breadth-first ordering
+     *
+     * Searches from vertex 0, then from the smallest vertex not yet
+     * reached, and so on; out-neighbours are taken in storage order.
+     *
+     * @param[in] gra The graph; vertices must be `0 .. n-1`
+     * @return Permutation<Vertex>
+     */
+    template <typename Graph,
+              typename Vertex = typename boost::graph_traits<Graph>::vertex_descriptor>
+    auto bfs_ordering(const Graph& gra) -> Permutation<Vertex> {
+        auto own = CsrGraph<boost::no_property, Vertex>{};
+        const auto [offsets, targets] = detail::csr_arrays<Vertex>(gra, own);
+        const auto n = offsets.size() - 1;
+        auto order = std::vector<Vertex>{};
+        order.reserve(n);
+        auto placed = std::vector<char>(n);
+        for (auto s = std::size_t{0}; s != n; ++s) {
+            if (placed[s] != 0) continue;
+            auto head = order.size();
+            order.push_back(static_cast<Vertex>(s));
+            placed[s] = 1;
+            while (head != order.size()) {
+                const auto u = order[head++];
+                for (auto k = offsets[u]; k != offsets[u + 1]; ++k) {
+                    if (placed[targets[k]] == 0) {
+                        placed[targets[k]] = 1;
+                        order.push_back(targets[k]);
+                    }
+                }
+            }
+        }
+        return Permutation<Vertex>::from_order(std::move(order));
+    }
+
+    /**
+     * @brief Renumber the vertices of a CsrGraph
+     *
+     * Vertex `v` becomes `perm.new_id[v]`. Every vertex keeps its out-edges
+     * in their order, with their properties.
+     *
+     * @param[in] gra The graph
+     * @param[in] perm A permutation of its vertices
+     * @return CsrGraph<EdgeProperty, Vertex>
+     * @throw std::invalid_argument if `perm` has another number of vertices
+     */
+    template <typename EdgeProperty, typename Vertex>
+    auto relabel_nodes(const CsrGraph<EdgeProperty, Vertex>& gra, const Permutation<Vertex>& perm)
+        -> CsrGraph<EdgeProperty, Vertex> {
+        if (perm.size() != num_vertices(gra)) {
+            throw std::invalid_argument("permutation does not match the graph");
+        }
+        auto old_edge = std::vector<std::size_t>{};
+        return detail::relabel_csr(gra, perm, old_edge);
+    }
+
+    /**
+     * @brief Renumber the vertices of a graph and its attributes, as in NetworkX
+     *
+     * Vertex `v` becomes `perm.new_id[v]`. The node attribute columns are
+     * permuted the same way and the edge attribute columns follow their
+     * edges, whose ids are renumbered by increasing new source. BGL vertex
+     * and edge properties are copied (an `edge_index` is renumbered). The
+     * graph type must be a CsrGraph or be constructible from a number of
+     * vertices, like `boost::adjacency_list` with `vecS` vertices.
+     *
+     * @code
+     * G = py::relabel_nodes(G, py::reverse_cuthill_mckee_ordering(G));
+     * @endcode
+     *
+     * @param[in] gra The graph
+     * @param[in] perm A permutation of its vertices
+     * @return GrAdaptor<Graph>
+     * @throw std::invalid_argument if `perm` has another number of vertices
+     */
+    template <typename Graph>
+    auto relabel_nodes(const GrAdaptor<Graph>& gra,
+                       const Permutation<typename GrAdaptor<Graph>::Vertex>& perm)
+        -> GrAdaptor<Graph> {
+        const auto n = static_cast<std::size_t>(gra.number_of_nodes());
+        if (perm.size() != n) {
+            throw std::invalid_argument("permutation does not match the graph");
+        }
+        const auto& base = static_cast<const Graph&>(gra);
+        auto old_edge = std::vector<std::size_t>{};
+        auto result = [&] {
+            if constexpr (requires { base.column_indices(); }) {
+                return GrAdaptor<Graph>(detail::relabel_csr(base, perm, old_edge));
+            } else {
+                return GrAdaptor<Graph>(detail::relabel_bgl(base, perm, old_edge));
+            }
+        }();
+        const auto rows = std::vector<std::size_t>(perm.old_id.begin(), perm.old_id.end());
+        result.node_data() = detail::take_rows(gra.node_data(), n, rows);
+        result.edge_data() = detail::take_rows(
+            gra.edge_data(), static_cast<std::size_t>(gra.number_of_edges()), old_edge);
+        return result;
+    }
+
+}  // namespace py
@@ -0,0 +1,522 @@
+/**
+ * @file shortest_path.hpp
+ * @brief Single-source shortest paths with non-negative edge weights
+ *
+ * Provides the NetworkX-style py::single_source_dijkstra() in two modes:
+ *
+ * - sequential Dijkstra, which keeps its queue in a RadixHeap when the
+ *   weights are integers and in a binary heap otherwise;
+ * - parallel delta-stepping (Meyer and Sanders, 2003) on a ThreadPool.
+ *   Vertices are kept in buckets of width `delta` by distance; all
+ *   vertices of the lowest bucket are relaxed at once, first along their
+ *   light edges (weight <= delta), which may refill the same bucket, then
+ *   along their heavy edges.
+ *
+ * Weights only need `+`, `<` and a zero `Weight{}`, so exact types such as
+ * fun::Fraction work as they are (delta-stepping also divides a distance
+ * by `delta`). The results are dense arrays indexed by vertex.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "nx2bgl.hpp"
+#include "thread_pool.hpp"
+
+namespace py {
+
+    /**
+     * @brief Monotone priority queue for unsigned integer keys
+     *
+     * Items live in `digits + 1` buckets by the highest bit in which their
+     * key differs from the last key popped. pop() empties the lowest
+     * non-empty bucket into lower ones, so every item moves at most
+     * `digits` times. Keys pushed must not be smaller than the last key
+     * popped, which is what Dijkstra's algorithm does.
+     *
+     * @tparam Key Unsigned integral key type
+     * @tparam Value Item type
+     */
+    template <typename Key, typename Value> class RadixHeap {
+        static_assert(std::is_unsigned_v<Key>, "Key must be an unsigned integer type");
+
+        std::array<std::vector<std::pair<Key, Value>>, std::numeric_limits<Key>::digits + 1>
+            _buckets{};
+        Key _last{0};
+        std::size_t _size{0};
+
+        auto bucket(Key key) const noexcept -> std::size_t {
+            return static_cast<std::size_t>(std::bit_width(static_cast<Key>(key ^ this->_last)));
+        }
+
+      public:
+        [[nodiscard]] auto empty() const noexcept -> bool { return this->_size == 0; }
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return this->_size; }
+
+        /**
+         * @brief Insert `value` with priority `key` (at least the last key popped)
+         */
+        void push(Key key, Value value) {
+            this->_buckets[this->bucket(key)].emplace_back(key, std::move(value));
+            ++this->_size;
+        }
+
+        /**
+         * @brief Remove an item with the smallest key
+         *
+         * @return std::pair<Key, Value> The key and the item
+         */
+        auto pop() -> std::pair<Key, Value> {
+            if (this->_buckets[0].empty()) {
+                auto i = std::size_t{1};
+                while (this->_buckets[i].empty()) ++i;
+                auto& items = this->_buckets[i];
+                this->_last = std::min_element(items.begin(), items.end(), [](auto& a, auto& b) {
+                                  return a.first < b.first;
+                              })->first;
+                for (auto& item : items) {
+                    this->_buckets[this->bucket(item.first)].push_back(std::move(item));
+                }
+                items.clear();
+            }
+            auto item = std::move(this->_buckets[0].back());
+            this->_buckets[0].pop_back();
+            --this->_size;
+            return item;
+        }
+    };
+
+    /**
+     * @brief Distances and shortest-path tree from one source
+     *
+     * @tparam Weight Distance type
+     * @tparam Vertex Vertex type
+     */
+    template <typename Weight, typename Vertex> struct ShortestPaths {
+        /// Distance of every vertex from the source (`Weight{}` if unreached)
+        std::vector<Weight> distance{};
+        /// Previous vertex on a shortest path: the source for itself, null_vertex() if unreached
+        std::vector<Vertex> predecessor{};
+
+        static auto null_vertex() noexcept -> Vertex { return std::numeric_limits<Vertex>::max(); }
+
+        /**
+         * @brief Whether `v` can be reached from the source
+         */
+        [[nodiscard]] auto reached(Vertex v) const -> bool {
+            return this->predecessor[static_cast<std::size_t>(v)] != null_vertex();
+        }
+
+        /**
+         * @brief A shortest path from the source to `v`, as in NetworkX
+         *
+         * @return std::vector<Vertex> The vertices from the source to `v`
+         *         (empty if `v` is unreached)
+         */
+        [[nodiscard]] auto path(Vertex v) const -> std::vector<Vertex> {
+            auto result = std::vector<Vertex>{};
+            if (!this->reached(v)) return result;
+            result.push_back(v);
+            for (auto u = v; this->predecessor[static_cast<std::size_t>(u)] != u;) {
+                u = this->predecessor[static_cast<std::size_t>(u)];
+                result.push_back(u);
+            }
+            std::reverse(result.begin(), result.end());
+            return result;
+        }
+    };
+
+    namespace detail {
+
+        // Vertex type of a graph; no type for non-class arguments, so that an
+        // explicit `single_source_dijkstra<Weight>(...)` skips the overloads
+        // taking a graph type first
+        template <typename Graph> struct vertex_of {};
+        template <typename Graph>
+            requires std::is_class_v<Graph>
+        struct vertex_of<Graph> {
+            using type = typename boost::graph_traits<Graph>::vertex_descriptor;
+        };
+        template <typename Graph> using vertex_of_t = typename vertex_of<Graph>::type;
+
+        /**
+         * @brief CSR arrays with one weight per edge, owned or borrowed
+         */
+        template <typename Weight, typename Vertex> struct WeightedCsr {
+            CsrGraph<Weight, Vertex> own{};
+            std::span<const std::size_t> offsets{};
+            std::span<const Vertex> targets{};
+            std::span<const Weight> weights{};
+
+            explicit WeightedCsr(const CsrGraph<Weight, Vertex>& gra)
+                : offsets{gra.row_offsets()},
+                  targets{gra.column_indices()},
+                  weights{gra.edge_properties()} {
+                if (this->weights.size() != this->targets.size()) {
+                    throw std::invalid_argument("graph has no edge weights");
+                }
+            }
+
+            // Copy `gra` with the weight `weight_of(e)` of every edge `e`
+            template <typename Graph, typename WeightOf>
+            WeightedCsr(const Graph& gra, WeightOf&& weight_of) {
+                auto offsets_ = std::vector<std::size_t>{};
+                auto targets_ = std::vector<Vertex>{};
+                auto weights_ = std::vector<Weight>{};
+                csr_fill(gra, offsets_, targets_, [&](std::size_t pos, const auto& e) {
+                    if (weights_.empty()) weights_.resize(targets_.size());
+                    weights_[pos] = weight_of(e);
+                });
+                weights_.resize(targets_.size());
+                this->own = {std::move(offsets_), std::move(targets_), std::move(weights_)};
+                this->offsets = this->own.row_offsets();
+                this->targets = this->own.column_indices();
+                this->weights = this->own.edge_properties();
+            }
+
+            WeightedCsr(const WeightedCsr&) = delete;  // the spans may point into `own`
+            WeightedCsr& operator=(const WeightedCsr&) = delete;
+
+            [[nodiscard]] auto num_vertices() const noexcept -> std::size_t {
+                return this->offsets.size() - 1;
+            }
+
+            void check_source(Vertex source) const {
+                if (static_cast<std::size_t>(source) >= this->num_vertices()) {
+                    throw std::out_of_range("source is not a vertex of the graph");
+                }
+            }
+        };
+
+        // Copy of `gra` weighted by the edge property map `weight`
+        template <typename Vertex, typename Graph, typename WeightMap>
+        auto map_csr(const Graph& gra, WeightMap weight)
+            -> WeightedCsr<typename boost::property_traits<WeightMap>::value_type, Vertex> {
+            return {gra, [&weight](const auto& e) { return get(weight, e); }};
+        }
+
+        // Copy of `gra` weighted by its edge attribute `name`
+        template <typename Weight, typename Graph>
+        auto attribute_csr(const GrAdaptor<Graph>& gra, std::string_view name)
+            -> WeightedCsr<Weight, typename GrAdaptor<Graph>::Vertex> {
+            const auto column = gra.edge_data().template column<Weight>(name);
+            return {gra, [&](const auto& e) {
+                        const auto id = gra.edge_id(e);
+                        if (id >= column.size()) throw std::out_of_range("edge without attributes");
+                        return column[id];
+                    }};
+        }
+
+        // Dijkstra's algorithm
+        template <typename Weight, typename Vertex>
+        auto dijkstra(const WeightedCsr<Weight, Vertex>& gra, Vertex source)
+            -> ShortestPaths<Weight, Vertex> {
+            using Result = ShortestPaths<Weight, Vertex>;
+            gra.check_source(source);
+            const auto n = gra.num_vertices();
+            auto result = Result{std::vector<Weight>(n),
+                                 std::vector<Vertex>(n, Result::null_vertex())};
+            auto& dist = result.distance;
+            auto& pred = result.predecessor;
+            pred[source] = source;
+            // Relax the out-edges of `u`, calling push(distance, v) for every improvement
+            const auto relax = [&](std::size_t u, auto&& push) {
+                for (auto i = gra.offsets[u]; i != gra.offsets[u + 1]; ++i) {
+                    const auto& w = gra.weights[i];
+                    if (w < Weight{}) throw std::invalid_argument("negative edge weight");
+                    const auto v = static_cast<std::size_t>(gra.targets[i]);
+                    auto d = dist[u] + w;
+                    if (pred[v] == Result::null_vertex() || d < dist[v]) {
+                        pred[v] = static_cast<Vertex>(u);
+                        push(d, gra.targets[i]);
+                        dist[v] = std::move(d);
+                    }
+                }
+            };
+            if constexpr (std::is_integral_v<Weight>) {
+                using Key = std::make_unsigned_t<Weight>;
+                auto heap = RadixHeap<Key, Vertex>{};
+                heap.push(Key{0}, source);
+                while (!heap.empty()) {
+                    const auto [key, u] = heap.pop();
+                    if (key != static_cast<Key>(dist[u])) continue;  // superseded
+                    relax(u, [&heap](const Weight& d, Vertex v) {
+                        heap.push(static_cast<Key>(d), v);
+                    });
+                }
+            } else {
+                using Item = std::pair<Weight, Vertex>;
+                const auto later = [](const Item& a, const Item& b) { return b.first < a.first; };
+                auto heap = std::vector<Item>{};
+                heap.emplace_back(Weight{}, source);
+                while (!heap.empty()) {
+                    std::pop_heap(heap.begin(), heap.end(), later);
+                    const auto u = heap.back().second;
+                    const auto superseded = dist[u] < heap.back().first;
+                    heap.pop_back();
+                    if (superseded) continue;
+                    relax(u, [&](const Weight& d, Vertex v) {
+                        heap.emplace_back(d, v);
+                        std::push_heap(heap.begin(), heap.end(), later);
+                    });
+                }
+            }
+            return result;
+        }
+
+        // Index of the bucket of width `delta` holding distance `dist`
+        template <typename Weight>
+        auto bucket_of(const Weight& dist, const Weight& delta) -> std::size_t {
+            if constexpr (std::is_arithmetic_v<Weight>) {
+                return static_cast<std::size_t>(dist / delta);
+            } else {
+                static_assert(requires(Weight q) { q.num() / q.den(); },
+                              "delta-stepping needs an arithmetic or fraction weight type");
+                const auto q = dist / delta;
+                return static_cast<std::size_t>(q.num() / q.den());
+            }
+        }
+
+        // Delta-stepping. Every relaxation phase first collects the improving
+        // requests of all chunks, grouped by ranges of target vertices, then
+        // applies each range on its own, so no two threads write one vertex.
+        template <typename Weight, typename Vertex>
+        auto delta_stepping(ThreadPool& pool, const WeightedCsr<Weight, Vertex>& gra,
+                            Vertex source, const Weight& delta) -> ShortestPaths<Weight, Vertex> {
+            using Result = ShortestPaths<Weight, Vertex>;
+            struct Request {
+                Vertex v;
+                Vertex u;
+                Weight d;
+            };
+            if (!(Weight{} < delta)) throw std::invalid_argument("delta must be positive");
+            gra.check_source(source);
+            const auto n = gra.num_vertices();
+            const auto m = gra.targets.size();
+            const auto chunks = [&pool](std::size_t count) {
+                return std::min(4 * (pool.size() + 1), count / 1024 + 1);
+            };
+
+            // Check the weights and find the largest one
+            auto heaviest = std::vector<Weight>(chunks(m));
+            auto negative = std::atomic<bool>{false};
+            parallel_for(pool, m, heaviest.size(),
+                         [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                             for (auto i = lo; i != hi; ++i) {
+                                 const auto& w = gra.weights[i];
+                                 if (w < Weight{}) negative.store(true, std::memory_order_relaxed);
+                                 if (heaviest[c] < w) heaviest[c] = w;
+                             }
+                         });
+            if (negative.load()) throw std::invalid_argument("negative edge weight");
+            const auto max_weight = *std::max_element(heaviest.begin(), heaviest.end());
+
+            // A relaxation from bucket i lands in buckets i .. i + bucket_of(max_weight) + 1,
+            // so a ring of buckets one longer than that never wraps onto a live one
+            // (plus one for the rounding of floating-point weights).
+            const auto ring = bucket_of(max_weight, delta) + 3;
+            const auto none = std::numeric_limits<std::size_t>::max();
+            auto buckets = std::vector<std::vector<Vertex>>(ring);
+            auto where = std::vector<std::size_t>(n, none);  // bucket of a queued vertex
+            auto result = Result{std::vector<Weight>(n),
+                                 std::vector<Vertex>(n, Result::null_vertex())};
+            auto& dist = result.distance;
+            auto& pred = result.predecessor;
+
+            const auto ranges = chunks(n);
+            const auto range_size = (n + ranges - 1) / ranges;
+            auto requests = std::vector<std::vector<std::vector<Request>>>(
+                ranges, std::vector<std::vector<Request>>(ranges));
+            auto moved = std::vector<std::vector<Vertex>>(ranges);
+            auto queued = std::size_t{0};
+
+            const auto relax = [&](const std::vector<Vertex>& from, bool light) {
+                const auto num_chunks = std::min(chunks(from.size()), ranges);
+                parallel_for(pool, from.size(), num_chunks,
+                             [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                                 for (auto k = lo; k != hi; ++k) {
+                                     const auto u = from[k];
+                                     for (auto i = gra.offsets[u]; i != gra.offsets[u + 1]; ++i) {
+                                         if (!(delta < gra.weights[i]) != light) continue;
+                                         const auto v = gra.targets[i];
+                                         auto d = dist[u] + gra.weights[i];
+                                         if (pred[v] == Result::null_vertex() || d < dist[v]) {
+                                             requests[c][v / range_size].push_back(
+                                                 {v, u, std::move(d)});
+                                         }
+                                     }
+                                 }
+                             });
+                parallel_for(pool, ranges, ranges, [&](std::size_t r, std::size_t, std::size_t) {
+                    for (auto c = std::size_t{0}; c != num_chunks; ++c) {
+                        for (auto& [v, u, d] : requests[c][r]) {
+                            if (pred[v] != Result::null_vertex() && !(d < dist[v])) continue;
+                            const auto k = bucket_of(d, delta);
+                            dist[v] = std::move(d);
+                            pred[v] = u;
+                            if (std::exchange(where[v], k) != k) moved[r].push_back(v);
+                        }
+                        requests[c][r].clear();
+                    }
+                });
+                for (auto& part : moved) {
+                    for (const auto v : part) {
+                        buckets[where[v] % ring].push_back(v);
+                    }
+                    queued += part.size();
+                    part.clear();
+                }
+            };
+
+            pred[source] = source;
+            where[source] = 0;
+            buckets[0].push_back(source);
+            queued = 1;
+            auto frontier = std::vector<Vertex>{};
+            auto settled = std::vector<Vertex>{};
+            auto in_settled = std::vector<char>(n, 0);
+            for (auto current = std::size_t{0}; queued != 0; ++current) {
+                auto& bucket = buckets[current % ring];
+                while (!bucket.empty()) {
+                    frontier.swap(bucket);
+                    queued -= frontier.size();
+                    // Drop stale and repeated entries
+                    std::erase_if(frontier, [&](Vertex v) {
+                        return std::exchange(where[v], none) != current;
+                    });
+                    for (const auto v : frontier) {
+                        if (std::exchange(in_settled[v], char{1}) == 0) settled.push_back(v);
+                    }
+                    relax(frontier, true);
+                    frontier.clear();
+                }
+                relax(settled, false);
+                for (const auto v : settled) in_settled[v] = 0;
+                settled.clear();
+            }
+            return result;
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Shortest paths from `source` over a CsrGraph weighted by its edge properties
+     *
+     * @param[in] gra The graph; its edge properties are the (non-negative) weights
+     * @param[in] source Start vertex
+     * @return ShortestPaths<Weight, Vertex> Distances and predecessors
+     * @throw std::invalid_argument if a reachable edge has a negative weight
+     * @throw std::out_of_range if `source` is not a vertex
+     */
+    template <typename Weight, typename Vertex>
+    auto single_source_dijkstra(const CsrGraph<Weight, Vertex>& gra,
+                                std::type_identity_t<Vertex> source)
+        -> ShortestPaths<Weight, Vertex> {
+        return detail::dijkstra(detail::WeightedCsr<Weight, Vertex>(gra), source);
+    }
+
+    /**
+     * @brief Shortest paths from `source`, as in NetworkX `single_source_dijkstra(G, source)`
+     *
+     * @code
+     * auto sp = py::single_source_dijkstra(gra, 0, boost::get(boost::edge_weight, gra));
+     * @endcode
+     *
+     * @param[in] gra Any BGL graph with vertices `0 .. n-1`
+     * @param[in] source Start vertex
+     * @param[in] weight Readable edge property map of non-negative weights
+     * @return ShortestPaths Distances and predecessors
+     */
+    template <typename Graph, typename WeightMap>
+        requires(!std::is_convertible_v<WeightMap, std::string_view>)
+    auto single_source_dijkstra(const Graph& gra, detail::vertex_of_t<Graph> source,
+                                WeightMap weight)
+        -> ShortestPaths<typename boost::property_traits<WeightMap>::value_type,
+                         detail::vertex_of_t<Graph>> {
+        return detail::dijkstra(detail::map_csr<detail::vertex_of_t<Graph>>(gra, weight), source);
+    }
+
+    /**
+     * @brief Shortest paths from `source`, weighted by the edge attribute `weight`
+     *
+     * @code
+     * auto sp = py::single_source_dijkstra<int>(G, 0, "weight");
+     * @endcode
+     *
+     * @tparam Weight Type of the attribute column
+     * @throw std::out_of_range if there is no such column
+     */
+    template <typename Weight, typename Graph>
+    auto single_source_dijkstra(const GrAdaptor<Graph>& gra,
+                                typename GrAdaptor<Graph>::Vertex source, std::string_view weight)
+        -> ShortestPaths<Weight, typename GrAdaptor<Graph>::Vertex> {
+        return detail::dijkstra(detail::attribute_csr<Weight>(gra, weight), source);
+    }
+
+    /**
+     * @brief Parallel (delta-stepping) shortest paths over a weighted CsrGraph
+     *
+     * `delta` trades work for parallelism: a bucket of width `delta` is
+     * relaxed at once, so a larger `delta` exposes more vertices per step
+     * but may relax a vertex several times before its distance is final.
+     * The average edge weight is a reasonable start. The distances equal
+     * those of the sequential mode; among equally short paths the
+     * predecessors may differ.
+     *
+     * @param[in] pool Pool running the search
+     * @param[in] gra The graph; its edge properties are the (non-negative) weights
+     * @param[in] source Start vertex
+     * @param[in] delta Bucket width (positive)
+     * @return ShortestPaths<Weight, Vertex> Distances and predecessors
+     * @throw std::invalid_argument if an edge has a negative weight or `delta` is not positive
+     */
+    template <typename Weight, typename Vertex>
+    auto single_source_dijkstra(ThreadPool& pool, const CsrGraph<Weight, Vertex>& gra,
+                                std::type_identity_t<Vertex> source,
+                                const std::type_identity_t<Weight>& delta)
+        -> ShortestPaths<Weight, Vertex> {
+        return detail::delta_stepping(pool, detail::WeightedCsr<Weight, Vertex>(gra), source,
+                                      delta);
+    }
+
+    /**
+     * @brief Parallel (delta-stepping) shortest paths over any BGL graph
+     */
+    template <typename Graph, typename WeightMap>
+        requires(!std::is_convertible_v<WeightMap, std::string_view>)
+    auto single_source_dijkstra(ThreadPool& pool, const Graph& gra,
+                                detail::vertex_of_t<Graph> source, WeightMap weight,
+                                const typename boost::property_traits<WeightMap>::value_type& delta)
+        -> ShortestPaths<typename boost::property_traits<WeightMap>::value_type,
+                         detail::vertex_of_t<Graph>> {
+        return detail::delta_stepping(
+            pool, detail::map_csr<detail::vertex_of_t<Graph>>(gra, weight), source, delta);
+    }
+
+    /**
+     * @brief Parallel (delta-stepping) shortest paths, weighted by the edge attribute `weight`
+     */
+    template <typename Weight, typename Graph>
+    auto single_source_dijkstra(ThreadPool& pool, const GrAdaptor<Graph>& gra,
+                                typename GrAdaptor<Graph>::Vertex source, std::string_view weight,
+                                const std::type_identity_t<Weight>& delta)
+        -> ShortestPaths<Weight, typename GrAdaptor<Graph>::Vertex> {
+        return detail::delta_stepping(pool, detail::attribute_csr<Weight>(gra, weight), source,
+                                      delta);
+    }
+
+}  // namespace py
@@ -0,0 +1,349 @@
+/**
+ * @file subgraph.hpp
+ * @brief Filtered subgraph views of a GrAdaptor, as in NetworkX
+ *
+ * Provides SubgraphView together with the NetworkX-style py::subgraph(),
+ * py::edge_subgraph() and py::subgraph_view(). A view copies nothing: it is
+ * a `boost::filtered_graph` over the wrapped graph that tests a node
+ * filter and an edge filter as it iterates, so it offers the same
+ * VertexView, EdgeView and AtlasView iteration as GrAdaptor and can be
+ * passed straight to BGL algorithms. Vertices and edges keep their ids,
+ * so the attribute columns of the graph are read in place.
+ *
+ * Every visit pays for the filters, and counting nodes or edges takes a
+ * pass over the graph; a view that is traversed many times can be turned
+ * into a CsrGraph with SubgraphView::compact().
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <boost/graph/filtered_graph.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "attributes.hpp"
+#include "csr_graph.hpp"
+#include "nx2bgl.hpp"
+
+namespace py {
+
+    /**
+     * @brief A set of vertex ids stored as a bitset, usable as a node filter
+     *
+     * Copies share the bits, so the filter stays cheap to copy inside BGL
+     * iterators.
+     */
+    class NodeMask {
+        std::size_t _size;
+        std::shared_ptr<std::vector<std::uint64_t>> _words;
+
+      public:
+        /**
+         * @brief Construct an empty set of the vertices `0 .. num_nodes-1`
+         */
+        explicit NodeMask(std::size_t num_nodes = 0)
+            : _size{num_nodes},
+              _words{std::make_shared<std::vector<std::uint64_t>>((num_nodes + 63) / 64)} {}
+
+        /**
+         * @brief Add vertex `v`
+         *
+         * @throw std::out_of_range if `v` is not below the number of nodes
+         */
+        template <typename Vertex> void insert(Vertex v) {
+            const auto i = static_cast<std::size_t>(v);
+            if (i >= this->_size) throw std::out_of_range("node is not in the mask");
+            (*this->_words)[i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+
+        /**
+         * @brief Whether vertex `v` is in the set
+         */
+        template <typename Vertex> [[nodiscard]] auto contains(Vertex v) const -> bool {
+            const auto i = static_cast<std::size_t>(v);
+            return i < this->_size
+                   && ((*this->_words)[i / 64] >> (i % 64) & std::uint64_t{1}) != 0;
+        }
+
+        template <typename Vertex> auto operator()(Vertex v) const -> bool {
+            return this->contains(v);
+        }
+    };
+
+    /**
+     * @brief A compacted subgraph: a CsrGraph with dense vertex ids
+     *
+     * @tparam Vertex Vertex type of the original graph
+     */
+    template <typename Vertex> struct CompactSubgraph {
+        GrAdaptor<CsrGraph<>> graph;
+        std::vector<Vertex> original;  ///< original vertex of every new vertex
+    };
+
+    namespace detail {
+
+        // Whether the edges of Graph have ids for the edge attribute columns
+        template <typename Graph> constexpr auto has_edge_ids
+            = stores_edge_index<Graph>::value
+              || requires(const Graph& gra) { gra.column_indices(); };
+
+    }  // namespace detail
+
+    /**
+     * @brief Read-only view of the nodes and edges of a GrAdaptor that pass two filters
+     *
+     * An edge is in the view when it passes `EdgeFilter` and both of its
+     * ends pass `NodeFilter`. The view refers to the graph, which must
+     * outlive it and must not change while it is used.
+     *
+     * @tparam Graph The graph type wrapped by the GrAdaptor
+     * @tparam NodeFilter Predicate on vertex descriptors
+     * @tparam EdgeFilter Predicate on edge descriptors
+     */
+    template <typename Graph, typename NodeFilter, typename EdgeFilter> class SubgraphView
+        : public VertexView<boost::filtered_graph<Graph, EdgeFilter, NodeFilter>> {
+      public:
+        using Filtered = boost::filtered_graph<Graph, EdgeFilter, NodeFilter>;
+        using Vertex = typename boost::graph_traits<Graph>::vertex_descriptor;
+        using node_t = Vertex;
+        using edge_t = typename boost::graph_traits<Graph>::edge_descriptor;
+
+        /**
+         * @brief View the parts of `gra` that pass `filter_node` and `filter_edge`
+         */
+        SubgraphView(const GrAdaptor<Graph>& gra, NodeFilter filter_node, EdgeFilter filter_edge)
+            : VertexView<Filtered>{Filtered(gra, std::move(filter_edge), std::move(filter_node))},
+              _gra{&gra} {}
+
+        /**
+         * @brief The viewed graph
+         */
+        [[nodiscard]] auto parent() const noexcept -> const GrAdaptor<Graph>& {
+            return *this->_gra;
+        }
+
+        /**
+         * @brief Number of nodes in the view (a pass over the vertices)
+         */
+        [[nodiscard]] auto number_of_nodes() const -> std::size_t {
+            return static_cast<std::size_t>(std::distance(this->begin(), this->end()));
+        }
+
+        /**
+         * @brief Number of edges in the view (a pass over the edges)
+         */
+        [[nodiscard]] auto number_of_edges() const -> std::size_t {
+            const auto [first, last] = detail::bgl_edges(*this);
+            return static_cast<std::size_t>(std::distance(first, last));
+        }
+
+        /**
+         * @brief Whether `v` is a node of the view
+         */
+        [[nodiscard]] auto has_node(Vertex v) const -> bool {
+            return static_cast<std::size_t>(v) < static_cast<std::size_t>(
+                       this->_gra->number_of_nodes())
+                   && this->m_vertex_pred(v);
+        }
+
+        /**
+         * @brief Iterable view of the edges in the view
+         */
+        [[nodiscard]] auto edges() const -> EdgeView<Filtered> { return EdgeView<Filtered>(*this); }
+
+        /**
+         * @brief Iterable view of the out-edges of `v` in the view
+         */
+        [[nodiscard]] auto neighbors(Vertex v) const -> AtlasView<Vertex, Filtered> {
+            return AtlasView<Vertex, Filtered>(v, *this);
+        }
+
+        /**
+         * @brief Iterable view of the vertices adjacent to `v` in the view
+         */
+        [[nodiscard]] auto adjacent_nodes(Vertex v) const -> AdjacencyView<Vertex, Filtered> {
+            return AdjacencyView<Vertex, Filtered>(v, *this);
+        }
+
+        template <typename Edge> auto source(const Edge& e) const -> Vertex {
+            return detail::bgl_source(e, *this);
+        }
+
+        template <typename Edge> auto target(const Edge& e) const -> Vertex {
+            return detail::bgl_target(e, *this);
+        }
+
+        template <typename Edge> [[nodiscard]] auto end_points(const Edge& e) const {
+            return std::make_pair(this->source(e), this->target(e));
+        }
+
+        /**
+         * @brief Node attributes of the graph (indexed by the original ids)
+         */
+        auto node_data() const -> const AttributeTable& { return this->_gra->node_data(); }
+
+        /**
+         * @brief Edge attributes of the graph (indexed by the original edge ids)
+         */
+        auto edge_data() const -> const AttributeTable& { return this->_gra->edge_data(); }
+
+        template <typename Edge> [[nodiscard]] auto edge_id(const Edge& e) const -> std::size_t {
+            return this->_gra->edge_id(e);
+        }
+
+        /**
+         * @brief Node attribute, as in NetworkX `H.nodes[v][name]`
+         */
+        template <typename T> auto node_attr(Vertex v, std::string_view name) const -> const T& {
+            return this->node_data().template at<T>(static_cast<std::size_t>(v), name);
+        }
+
+        /**
+         * @brief Edge attribute of edge `e`
+         */
+        template <typename T, typename Edge>
+        auto edge_attr(const Edge& e, std::string_view name) const -> const T& {
+            return this->edge_data().template at<T>(this->edge_id(e), name);
+        }
+
+        /**
+         * @brief Copy the view into a CsrGraph, as in NetworkX `H.copy()`
+         *
+         * The nodes are numbered `0 .. k-1` in increasing original order and
+         * keep their out-edges in order (an undirected graph gets both
+         * directions of every edge, as with to_csr()). The node attribute
+         * columns are copied for the kept nodes, and the edge attribute
+         * columns for the kept edges when the graph has edge ids.
+         *
+         * @return CompactSubgraph<Vertex> The graph and the original id of every node
+         */
+        [[nodiscard]] auto compact() const -> CompactSubgraph<Vertex> {
+            const auto n = static_cast<std::size_t>(this->_gra->number_of_nodes());
+            auto original = std::vector<Vertex>(this->begin(), this->end());
+            if (original.size() > std::size_t{CsrGraph<>::null_vertex()}) {
+                throw std::out_of_range("too many vertices for the CSR vertex type");
+            }
+            auto new_id = std::vector<std::uint32_t>(n, CsrGraph<>::null_vertex());
+            for (auto i = std::size_t{0}; i != original.size(); ++i) {
+                new_id[static_cast<std::size_t>(original[i])] = static_cast<std::uint32_t>(i);
+            }
+            auto offsets = std::vector<std::size_t>(original.size() + 1, 0);
+            auto targets = std::vector<std::uint32_t>{};
+            auto old_edge = std::vector<std::size_t>{};
+            for (auto i = std::size_t{0}; i != original.size(); ++i) {
+                for (auto [first, last] = detail::bgl_out_edges(original[i], *this); first != last;
+                     ++first) {
+                    targets.push_back(new_id[static_cast<std::size_t>(this->target(*first))]);
+                    if constexpr (detail::has_edge_ids<Graph>) {
+                        old_edge.push_back(this->edge_id(*first));
+                    }
+                }
+                offsets[i + 1] = targets.size();
+            }
+
+            auto result = CompactSubgraph<Vertex>{
+                GrAdaptor<CsrGraph<>>(CsrGraph<>(std::move(offsets), std::move(targets))),
+                std::move(original)};
+            const auto rows
+                = std::vector<std::size_t>(result.original.begin(), result.original.end());
+            result.graph.node_data() = detail::take_rows(this->node_data(), n, rows);
+            if constexpr (detail::has_edge_ids<Graph>) {
+                result.graph.edge_data() = detail::take_rows(
+                    this->edge_data(), static_cast<std::size_t>(this->_gra->number_of_edges()),
+                    old_edge);
+            }
+            return result;
+        }
+
+      private:
+        const GrAdaptor<Graph>* _gra;
+    };
+
+    /**
+     * @brief View of the nodes and edges that pass two filters, as in NetworkX
+     *
+     * @code
+     * auto H = py::subgraph_view(G, [](auto v) { return v % 2 == 0; },
+     *                            [&](const auto& e) { return weight[G.edge_id(e)] > 0; });
+     * @endcode
+     *
+     * @param[in] gra The graph (must outlive the view)
+     * @param[in] filter_node Predicate on vertices
+     * @param[in] filter_edge Predicate on edges
+     */
+    template <typename Graph, typename NodeFilter = boost::keep_all,
+              typename EdgeFilter = boost::keep_all>
+    auto subgraph_view(const GrAdaptor<Graph>& gra, NodeFilter filter_node = {},
+                       EdgeFilter filter_edge = {})
+        -> SubgraphView<Graph, NodeFilter, EdgeFilter> {
+        return {gra, std::move(filter_node), std::move(filter_edge)};
+    }
+
+    /**
+     * @brief Subgraph induced by a set of nodes, as in NetworkX `G.subgraph(nodes)`
+     *
+     * @param[in] gra The graph (must outlive the view)
+     * @param[in] nodes The nodes to keep
+     */
+    template <typename Graph>
+    auto subgraph(const GrAdaptor<Graph>& gra, NodeMask nodes)
+        -> SubgraphView<Graph, NodeMask, boost::keep_all> {
+        return {gra, std::move(nodes), boost::keep_all{}};
+    }
+
+    /**
+     * @brief Subgraph induced by a range of nodes (ids outside the graph are ignored)
+     */
+    template <typename Graph, typename NodeRange>
+        requires(!std::is_same_v<std::remove_cvref_t<NodeRange>, NodeMask>)
+    auto subgraph(const GrAdaptor<Graph>& gra, const NodeRange& nodes)
+        -> SubgraphView<Graph, NodeMask, boost::keep_all> {
+        const auto n = static_cast<std::size_t>(gra.number_of_nodes());
+        auto mask = NodeMask(n);
+        for (const auto& v : nodes) {
+            if (static_cast<std::size_t>(v) < n) mask.insert(v);
+        }
+        return subgraph(gra, std::move(mask));
+    }
+
+    /**
+     * @brief Subgraph of the edges that pass a filter, as in NetworkX `G.edge_subgraph(edges)`
+     *
+     * The nodes of the view are the ends of those edges, found with one
+     * pass over the edges.
+     *
+     * @param[in] gra The graph (must outlive the view)
+     * @param[in] filter_edge Predicate on edges
+     */
+    template <typename Graph, typename EdgeFilter>
+    auto edge_subgraph(const GrAdaptor<Graph>& gra, EdgeFilter filter_edge)
+        -> SubgraphView<Graph, NodeMask, EdgeFilter> {
+        auto mask = NodeMask(static_cast<std::size_t>(gra.number_of_nodes()));
+        for (const auto& e : gra.edges()) {
+            if (filter_edge(e)) {
+                mask.insert(gra.source(e));
+                mask.insert(gra.target(e));
+            }
+        }
+        return {gra, std::move(mask), std::move(filter_edge)};
+    }
+
+}  // namespace py
+
+namespace boost {
+
+    // Property maps of a view are those of the filtered graph it derives from
+    template <typename Graph, typename NodeFilter, typename EdgeFilter, typename Property>
+    struct property_map<py::SubgraphView<Graph, NodeFilter, EdgeFilter>, Property>
+        : property_map<filtered_graph<Graph, EdgeFilter, NodeFilter>, Property> {};
+
+}  // namespace boost
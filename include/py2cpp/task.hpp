@@ -0,0 +1,163 @@
+/**
+ * @file task.hpp
+ * @brief Lazily started C++20 coroutine task with co_await support
+ *
+ * Provides a Task template modelling a Python coroutine object: calling a
+ * Task-returning function creates the coroutine without running it, and
+ * `co_await task` runs it to completion (possibly across suspensions) and
+ * yields its result. Control is handed back and forth with symmetric
+ * transfer, so chains of awaiting tasks do not grow the stack.
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "frame_alloc.hpp"
+
+namespace py {
+
+    template <typename T> class Task;
+
+    namespace detail {
+
+        /**
+         * @brief Result slot of a Task promise
+         *
+         * @tparam T Result type
+         */
+        template <typename T> struct TaskResult {
+            std::optional<T> m_value{};
+            std::exception_ptr m_exception{};
+
+            template <typename U = T> void return_value(U&& value) noexcept(
+                std::is_nothrow_constructible_v<T, U&&>) {
+                m_value.emplace(std::forward<U>(value));
+            }
+
+            auto result() -> T {
+                if (m_exception != nullptr) {
+                    std::rethrow_exception(m_exception);
+                }
+                return std::move(*m_value);
+            }
+        };
+
+        template <> struct TaskResult<void> {
+            std::exception_ptr m_exception{};
+
+            void return_void() noexcept {}
+
+            void result() {
+                if (m_exception != nullptr) {
+                    std::rethrow_exception(m_exception);
+                }
+            }
+        };
+
+    }  // namespace detail
+
+    /**
+     * @brief Lazily started coroutine producing a single value of type T.
+     *
+     * The coroutine body may `co_await` other tasks and any awaitable (for
+     * example py::sleep() or py::wait_readable() from asyncio.hpp). An
+     * exception escaping the body is stored and rethrown to the awaiter.
+     *
+     * A Task is awaited at most once. Frames come from the FramePool, see
+     * FrameAllocated.
+     *
+     * @tparam T Result type (may be void)
+     */
+    template <typename T = void> class [[nodiscard]] Task {
+      public:
+        struct promise_type : FrameAllocated, detail::TaskResult<T> {
+            std::coroutine_handle<> m_continuation{};
+
+            auto get_return_object() noexcept {
+                return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+
+            auto final_suspend() noexcept {
+                struct final_awaiter {
+                    bool await_ready() const noexcept { return false; }
+
+                    std::coroutine_handle<> await_suspend(
+                        std::coroutine_handle<promise_type> coro) const noexcept {
+                        auto continuation = coro.promise().m_continuation;
+                        return continuation ? continuation : std::noop_coroutine();
+                    }
+
+                    void await_resume() const noexcept {}
+                };
+                return final_awaiter{};
+            }
+
+            void unhandled_exception() noexcept {
+                this->m_exception = std::current_exception();
+            }
+        };
+
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        Task() noexcept = default;
+        ~Task() {
+            if (coro_) coro_.destroy();
+        }
+
+        Task(Task&& other) noexcept : coro_(std::exchange(other.coro_, {})) {}
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                if (coro_) coro_.destroy();
+                coro_ = std::exchange(other.coro_, {});
+            }
+            return *this;
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        /**
+         * @brief Whether the coroutine has run to completion
+         */
+        [[nodiscard]] auto done() const noexcept -> bool { return !coro_ || coro_.done(); }
+
+        /**
+         * @brief Underlying coroutine handle (used by schedulers)
+         */
+        [[nodiscard]] auto handle() const noexcept -> handle_type { return coro_; }
+
+        /**
+         * @brief Result of a completed task; rethrows its exception if any
+         */
+        auto result() -> T { return coro_.promise().result(); }
+
+        auto operator co_await() noexcept {
+            struct awaiter {
+                handle_type m_coro;
+
+                bool await_ready() const noexcept { return !m_coro || m_coro.done(); }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                    m_coro.promise().m_continuation = awaiting;
+                    return m_coro;
+                }
+
+                auto await_resume() -> T { return m_coro.promise().result(); }
+            };
+            return awaiter{coro_};
+        }
+
+      private:
+        explicit Task(handle_type coro) noexcept : coro_(coro) {}
+
+        handle_type coro_{};
+    };
+
+}  // namespace py
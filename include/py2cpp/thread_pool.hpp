@@ -0,0 +1,265 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Work-stealing thread pool
+ *
+ * Provides a fixed-size ThreadPool in which every worker owns a deque of
+ * jobs. A worker runs its own jobs last-in first-out (depth first, which
+ * keeps recursive fork/join work cache friendly and bounded) and, when it
+ * runs dry, steals the oldest job of another worker. parallel_for() splits a
+ * loop into chunks on top of it.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace py {
+
+    /**
+     * @brief Fixed-size pool of worker threads with per-worker deques.
+     *
+     * Jobs submitted from one of the pool's own workers go to the front of
+     * that worker's deque; jobs submitted from any other thread are spread
+     * over the workers round robin. Idle workers steal from the back of the
+     * other deques before going to sleep.
+     *
+     * Jobs must not throw (an escaping exception terminates the program, as
+     * with std::thread). The destructor runs every job already submitted
+     * and then joins the workers.
+     */
+    class ThreadPool {
+      public:
+        /**
+         * @brief Start `num_threads` workers
+         *
+         * @param[in] num_threads Number of workers (0 means one per hardware thread)
+         */
+        explicit ThreadPool(std::size_t num_threads = 0) {
+            if (num_threads == 0) {
+                num_threads = std::max(1U, std::thread::hardware_concurrency());
+            }
+            this->_queues.reserve(num_threads);
+            for (auto i = std::size_t{0}; i != num_threads; ++i) {
+                this->_queues.push_back(std::make_unique<Queue>());
+            }
+            this->_threads.reserve(num_threads);
+            for (auto i = std::size_t{0}; i != num_threads; ++i) {
+                this->_threads.emplace_back([this, i] { this->work(i); });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                auto lock = std::lock_guard{this->_mutex};
+                this->_stopping = true;
+            }
+            this->_wakeup.notify_all();
+            for (auto& thread : this->_threads) {
+                thread.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Number of worker threads
+         */
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return this->_threads.size(); }
+
+        /**
+         * @brief Queue a callable for execution on one of the workers
+         *
+         * The callable may be move-only.
+         *
+         * @param[in] func Callable taking no arguments
+         */
+        template <typename F> void submit(F&& func) {
+            auto job = std::unique_ptr<Job>{new Model<std::decay_t<F>>{std::forward<F>(func)}};
+            const auto index = worker_index(this);
+            auto& queue = index != npos
+                              ? *this->_queues[index]
+                              : *this->_queues[this->_next.fetch_add(1, std::memory_order_relaxed)
+                                               % this->_queues.size()];
+            {
+                auto lock = std::lock_guard{queue.mutex};
+                queue.jobs.push_front(std::move(job));
+            }
+            this->_pending.fetch_add(1, std::memory_order_release);
+            {
+                // Pairs with the predicate check in work(): no wakeup can be lost
+                auto lock = std::lock_guard{this->_mutex};
+            }
+            this->_wakeup.notify_one();
+        }
+
+        /**
+         * @brief Run one queued job on the calling thread, if there is any
+         *
+         * Lets a thread that waits for pool work help instead of blocking,
+         * which also makes waiting from inside a job deadlock free.
+         *
+         * @return true if a job was run
+         */
+        auto run_one() -> bool {
+            const auto index = worker_index(this);
+            auto job = this->take(index != npos ? index : 0);
+            if (!job) return false;
+            this->_pending.fetch_sub(1, std::memory_order_relaxed);
+            job->run();
+            return true;
+        }
+
+        /**
+         * @brief Index of the calling thread among this pool's workers
+         *
+         * @return std::size_t The worker index, or ThreadPool::npos for other threads
+         */
+        [[nodiscard]] auto current_worker() const noexcept -> std::size_t {
+            return worker_index(this);
+        }
+
+        static constexpr auto npos = static_cast<std::size_t>(-1);
+
+      private:
+        struct Job {
+            virtual ~Job() = default;
+            virtual void run() noexcept = 0;
+        };
+
+        template <typename F> struct Model final : Job {
+            F func;
+            explicit Model(F&& f) : func(std::move(f)) {}
+            explicit Model(const F& f) : func(f) {}
+            void run() noexcept override { this->func(); }
+        };
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::unique_ptr<Job>> jobs;
+        };
+
+        struct WorkerId {
+            const ThreadPool* pool;
+            std::size_t index;
+        };
+
+        static auto worker_id() noexcept -> WorkerId& {
+            thread_local WorkerId id{nullptr, npos};
+            return id;
+        }
+
+        static auto worker_index(const ThreadPool* pool) noexcept -> std::size_t {
+            const auto& id = worker_id();
+            return id.pool == pool ? id.index : npos;
+        }
+
+        auto take(std::size_t index) -> std::unique_ptr<Job> {
+            {
+                auto& own = *this->_queues[index];
+                auto lock = std::lock_guard{own.mutex};
+                if (!own.jobs.empty()) {
+                    auto job = std::move(own.jobs.front());
+                    own.jobs.pop_front();
+                    return job;
+                }
+            }
+            const auto count = this->_queues.size();
+            for (auto step = std::size_t{1}; step != count; ++step) {
+                auto& victim = *this->_queues[(index + step) % count];
+                auto lock = std::lock_guard{victim.mutex};
+                if (!victim.jobs.empty()) {
+                    auto job = std::move(victim.jobs.back());
+                    victim.jobs.pop_back();
+                    return job;
+                }
+            }
+            return nullptr;
+        }
+
+        void work(std::size_t index) {
+            worker_id() = WorkerId{this, index};
+            for (;;) {
+                if (auto job = this->take(index)) {
+                    this->_pending.fetch_sub(1, std::memory_order_relaxed);
+                    job->run();
+                    continue;
+                }
+                auto lock = std::unique_lock{this->_mutex};
+                this->_wakeup.wait(lock, [this] {
+                    return this->_pending.load(std::memory_order_acquire) != 0
+                           || this->_stopping;
+                });
+                if (this->_stopping && this->_pending.load(std::memory_order_acquire) == 0) {
+                    return;
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<Queue>> _queues{};
+        std::vector<std::thread> _threads{};
+        std::atomic<std::size_t> _next{0};
+        std::atomic<std::size_t> _pending{0};
+        std::mutex _mutex{};
+        std::condition_variable _wakeup{};
+        bool _stopping{false};
+    };
+
+    /**
+     * @brief Run `body(chunk, begin, end)` over `[0, count)` split into chunks
+     *
+     * The range is cut into `chunks` contiguous pieces of nearly equal size
+     * (chunk `c` covers `[begin, end)`), which run on the pool. The calling
+     * thread runs the first piece itself and then helps with queued jobs
+     * until every piece has finished. The first exception thrown by `body`
+     * is rethrown once all pieces are done.
+     *
+     * @param[in] pool Pool to run on
+     * @param[in] count Number of items
+     * @param[in] chunks Number of pieces (clamped to `[1, count]`)
+     * @param[in] body Callable `(std::size_t chunk, std::size_t begin, std::size_t end)`
+     */
+    template <typename F>
+    void parallel_for(ThreadPool& pool, std::size_t count, std::size_t chunks, F&& body) {
+        chunks = std::clamp(chunks, std::size_t{1}, std::max(count, std::size_t{1}));
+        const auto bound = [count, chunks](std::size_t c) {
+            return count / chunks * c + std::min(c, count % chunks);
+        };
+        if (chunks == 1) {
+            body(std::size_t{0}, std::size_t{0}, count);
+            return;
+        }
+
+        auto remaining = std::atomic<std::size_t>{chunks};
+        auto failed = std::atomic<bool>{false};
+        auto exception = std::exception_ptr{};
+        const auto run = [&](std::size_t c) noexcept {
+            try {
+                body(c, bound(c), bound(c + 1));
+            } catch (...) {
+                if (!failed.exchange(true)) exception = std::current_exception();
+            }
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+        };
+        for (auto c = std::size_t{1}; c != chunks; ++c) {
+            pool.submit([&run, c] { run(c); });
+        }
+        run(0);
+        while (remaining.load(std::memory_order_acquire) != 0) {
+            if (!pool.run_one()) std::this_thread::yield();
+        }
+        if (exception != nullptr) std::rethrow_exception(exception);
+    }
+
+}  // namespace py
@@ -0,0 +1,27 @@
+/**
+ * @file lcg.hpp
+ * @brief Deterministic random numbers shared by the graph tests
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// 64-bit linear congruential generator (Knuth's MMIX constants)
+class Lcg {
+    std::uint64_t _state;
+
+  public:
+    explicit Lcg(std::uint64_t seed) noexcept : _state{seed} {}
+
+    /// Next 31-bit value (the high bits, which are the well-mixed ones)
+    auto operator()() noexcept -> std::uint32_t {
+        _state = _state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<std::uint32_t>(_state >> 33);
+    }
+
+    /// Next value in [0, bound)
+    auto operator()(std::uint64_t bound) noexcept -> std::uint32_t {
+        return static_cast<std::uint32_t>((*this)() % bound);
+    }
+};
@@ -0,0 +1,148 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/bfs.hpp>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lcg.hpp"
+
+using Csr = py::CsrGraph<>;
+using Bfs = py::ParallelBfs<>;
+
+static auto random_graph(std::size_t n, std::size_t m) -> Csr {
+    auto edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+    auto random = Lcg{7};
+    for (auto i = std::size_t{0}; i != m; ++i) {
+        const auto u = random(n);
+        edges.emplace_back(u, random(n));
+    }
+    return {n, edges};
+}
+
+// Sequential reference
+static auto distances(const Csr& gra, std::uint32_t source) -> std::vector<std::uint32_t> {
+    auto dist = std::vector<std::uint32_t>(num_vertices(gra), Bfs::unreached);
+    auto queue = std::queue<std::uint32_t>{};
+    dist[source] = 0;
+    queue.push(source);
+    while (!queue.empty()) {
+        const auto u = queue.front();
+        queue.pop();
+        for (auto [vi, vend] = adjacent_vertices(u, gra); vi != vend; ++vi) {
+            if (dist[*vi] == Bfs::unreached) {
+                dist[*vi] = dist[u] + 1;
+                queue.push(*vi);
+            }
+        }
+    }
+    return dist;
+}
+
+static void check_tree(const Csr& gra, std::uint32_t source, Bfs& bfs) {
+    const auto expected = distances(gra, source);
+    const auto parent = bfs.parents(std::vector<std::uint32_t>{source});
+    for (auto v = std::uint32_t{0}; v != num_vertices(gra); ++v) {
+        if (expected[v] == Bfs::unreached) {
+            CHECK_EQ(parent[v], Bfs::null_vertex());
+        } else if (v == source) {
+            CHECK_EQ(parent[v], source);
+        } else {
+            REQUIRE_NE(parent[v], Bfs::null_vertex());
+            CHECK_EQ(expected[parent[v]] + 1, expected[v]);
+            CHECK(edge(parent[v], v, gra).second);
+        }
+    }
+}
+
+TEST_CASE("Test ParallelBfs parents match sequential BFS") {
+    auto pool = py::ThreadPool{3};
+    const auto gra = random_graph(20000, 100000);
+    auto bfs = Bfs{pool, gra};
+    check_tree(gra, 0, bfs);
+    check_tree(gra, 12345, bfs);
+
+    // Always top-down, then bottom-up as early as possible
+    bfs.alpha = 1U << 30;
+    check_tree(gra, 7, bfs);
+    bfs.alpha = 1;
+    bfs.beta = 1U << 30;
+    check_tree(gra, 7, bfs);
+}
+
+TEST_CASE("Test bfs_layers on a grid") {
+    auto pool = py::ThreadPool{2};
+    const auto side = 30U;
+    auto edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+    for (auto r = 0U; r != side; ++r) {
+        for (auto c = 0U; c != side; ++c) {
+            const auto v = r * side + c;
+            if (c + 1 != side) {
+                edges.emplace_back(v, v + 1);
+                edges.emplace_back(v + 1, v);
+            }
+            if (r + 1 != side) {
+                edges.emplace_back(v, v + side);
+                edges.emplace_back(v + side, v);
+            }
+        }
+    }
+    const auto gra = Csr(side * side, edges);
+    const auto layers = py::bfs_layers(pool, gra, {0U, side * side - 1}, true);
+    REQUIRE_EQ(layers.size(), side);
+    CHECK_EQ(layers[0], std::vector<std::uint32_t>{0, side * side - 1});
+    for (auto d = std::size_t{0}; d != layers.size(); ++d) {
+        for (const auto v : layers[d]) {
+            const auto r = v / side;
+            const auto c = v % side;
+            CHECK_EQ(std::min(r + c, 2 * (side - 1) - r - c), d);
+        }
+    }
+}
+
+TEST_CASE("Test bfs_edges on a GrAdaptor") {
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS>;
+    auto G = py::GrAdaptor<Graph>(Graph(0));
+    G.add_edges_from(std::vector<std::pair<int, int>>{{0, 1}, {0, 2}, {1, 3}, {2, 3}, {3, 4}});
+    auto pool = py::ThreadPool{2};
+    auto tree = py::bfs_edges(pool, G, std::size_t{0});
+    REQUIRE_EQ(tree.size(), 4);
+    std::sort(tree.begin(), tree.begin() + 2);
+    CHECK_EQ(tree[0], std::pair<std::size_t, std::size_t>{0, 1});
+    CHECK_EQ(tree[1], std::pair<std::size_t, std::size_t>{0, 2});
+    CHECK_EQ(tree[2].second, 3);
+    CHECK_EQ(tree[3], std::pair<std::size_t, std::size_t>{3, 4});
+    CHECK_EQ(py::bfs_edges(pool, G, std::size_t{4}).size(), 0);
+}
+
+TEST_CASE("Test ParallelBfs batched distances") {
+    auto pool = py::ThreadPool{3};
+    const auto gra = random_graph(3000, 9000);
+    auto bfs = Bfs{pool, gra};
+    auto sources = std::vector<std::uint32_t>{};
+    for (auto k = 0U; k != 70; ++k) {
+        sources.push_back((k * 37) % 3000);
+    }
+    const auto dist = bfs.distances(sources);
+    REQUIRE_EQ(dist.size(), sources.size());
+    for (auto k = std::size_t{0}; k != sources.size(); ++k) {
+        CHECK_EQ(dist[k], distances(gra, sources[k]));
+    }
+}
+
+TEST_CASE("Test ParallelBfs rejects invalid sources") {
+    auto pool = py::ThreadPool{2};
+    const auto gra = random_graph(100, 300);
+    auto bfs = Bfs{pool, gra};
+    const auto sources = std::vector<std::uint32_t>{0, 100};
+    CHECK_THROWS_AS(bfs.distances(sources), std::out_of_range);
+    CHECK_THROWS_AS(bfs.parents(sources), std::out_of_range);
+}
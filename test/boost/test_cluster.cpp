@@ -0,0 +1,110 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <py2cpp/cluster.hpp>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "lcg.hpp"
+
+using Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+TEST_CASE("Test sorted intersection") {
+    auto random = Lcg{3};
+    // Lengths on both sides of the gallop threshold, with and without SIMD tails
+    for (const auto& [m, k] : {std::pair{0, 5}, {3, 7}, {17, 19}, {64, 61}, {5, 1000}, {2, 300}}) {
+        const auto sorted_set = [&](int size) {
+            auto result = std::vector<std::uint32_t>{};
+            for (auto i = 0; i != size; ++i) result.push_back(random(400));
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+            return result;
+        };
+        const auto a = sorted_set(m);
+        const auto b = sorted_set(k);
+        auto expected = std::vector<std::uint32_t>{};
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                              std::back_inserter(expected));
+        auto found = std::vector<std::uint32_t>{};
+        py::detail::intersect(std::span<const std::uint32_t>(a), std::span<const std::uint32_t>(b),
+                              [&found](std::uint32_t w) { found.push_back(w); });
+        CHECK_EQ(found, expected);
+    }
+}
+
+TEST_CASE("Test triangles and clustering") {
+    // Random graph with parallel edges, self-loops and edges in both directions
+    constexpr auto n = std::size_t{150};
+    auto random = Lcg{11};
+    auto edges = Edges{};
+    for (auto i = 0; i != 1500; ++i) edges.emplace_back(random(n), random(n));
+    std::sort(edges.begin(), edges.end());
+    auto adjacent = std::vector<std::vector<bool>>(n, std::vector<bool>(n));
+    for (const auto& [u, v] : edges) {
+        if (u != v) adjacent[u][v] = adjacent[v][u] = true;
+    }
+
+    py::ThreadPool pool{3};
+    const auto gra = py::CsrGraph<>(n, edges);
+    const auto index = py::NeighborIndex<>(pool, gra);
+    const auto count = index.triangles();
+    const auto coefficient = py::clustering(pool, gra);
+    for (auto u = std::size_t{0}; u != n; ++u) {
+        auto expected = std::size_t{0};
+        auto degree = std::size_t{0};
+        for (auto v = std::size_t{0}; v != n; ++v) {
+            if (!adjacent[u][v]) continue;
+            ++degree;
+            for (auto w = v + 1; w != n; ++w) {
+                expected += static_cast<std::size_t>(adjacent[u][w] && adjacent[v][w]);
+            }
+        }
+        CHECK_EQ(count[u], expected);
+        CHECK_EQ(index.degree(static_cast<std::uint32_t>(u)), degree);
+        const auto pairs = static_cast<double>(degree * (degree - 1) / 2);
+        const auto expected_coefficient = degree < 2 ? 0.0 : static_cast<double>(expected) / pairs;
+        CHECK(std::abs(coefficient[u] - expected_coefficient) < 1.0e-12);
+    }
+    CHECK_EQ(py::triangles(pool, gra), count);
+
+    auto both = std::vector<std::uint32_t>{};
+    for (auto w = std::uint32_t{0}; w != n; ++w) {
+        if (adjacent[3][w] && adjacent[8][w]) both.push_back(w);
+    }
+    CHECK_EQ(index.common_neighbors(3, 8), both);
+    // On the directed CsrGraph itself: the common successors
+    auto successors = std::vector<std::uint32_t>{};
+    for (auto w = std::uint32_t{0}; w != n; ++w) {
+        const auto out = [&](std::uint32_t u) {
+            return std::binary_search(edges.begin(), edges.end(), std::pair{u, w});
+        };
+        if (w != 3 && w != 8 && out(3) && out(8)) successors.push_back(w);
+    }
+    CHECK_EQ(py::common_neighbors(gra, 3, 8), successors);
+    CHECK_THROWS_AS((void)index.common_neighbors(3, 150), std::out_of_range);
+}
+
+TEST_CASE("Test common_neighbors on a BGL graph") {
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
+    // Two triangles 0-1-2 and 0-2-3 sharing the edge 0-2, plus a loop on 0
+    auto gra = Graph(5);
+    for (const auto& [u, v] : Edges{{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 0}, {0, 0}, {3, 4}}) {
+        boost::add_edge(u, v, gra);
+    }
+    CHECK_EQ(py::common_neighbors(gra, 0, 2), std::vector<std::size_t>{1, 3});
+    CHECK_EQ(py::common_neighbors(gra, 0, 4), std::vector<std::size_t>{3});
+    py::ThreadPool pool{2};
+    CHECK_EQ(py::triangles(pool, gra), std::vector<std::size_t>{2, 1, 2, 1, 0});
+    const auto coefficient = py::clustering(pool, gra);
+    CHECK(std::abs(coefficient[0] - 2.0 / 3.0) < 1.0e-12);
+    CHECK(std::abs(coefficient[3] - 1.0 / 3.0) < 1.0e-12);
+    CHECK_EQ(coefficient[4], 0.0);
+}
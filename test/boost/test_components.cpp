@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/connected_components.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/components.hpp>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <utility>
+#include <vector>
+
+#include "lcg.hpp"
+
+using Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+// A large random component on the even vertices below `n / 2`, plus pairs and isolated vertices
+static auto mixed_edges(std::uint32_t n) -> Edges {
+    auto edges = Edges{};
+    auto random = Lcg{9};
+    for (auto i = std::uint32_t{0}; i != 2 * n; ++i) {
+        edges.emplace_back(2 * random(n / 4), 2 * random(n / 4));
+    }
+    for (auto v = n / 2; v + 1 < n; v += 4) {
+        edges.emplace_back(v + 1, v);
+    }
+    return edges;
+}
+
+TEST_CASE("Test connected_components against BGL") {
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
+    constexpr auto n = std::uint32_t{20000};
+    const auto edges = mixed_edges(n);
+    const auto gra = py::GrAdaptor<Graph>(Graph(edges.begin(), edges.end(), n));
+    auto expected = std::vector<std::size_t>(n);
+    const auto count = boost::connected_components(gra, expected.data());
+
+    for (const auto threads : {1U, 4U}) {
+        py::ThreadPool pool{threads};
+        const auto labels = py::connected_components(pool, gra);
+        REQUIRE_EQ(labels.size(), n);
+        // Same partition, labelled by the smallest vertex
+        auto first = std::vector<std::size_t>(count, n);
+        for (auto v = std::size_t{0}; v != n; ++v) {
+            auto& f = first[expected[v]];
+            if (f == n) f = v;
+            CHECK_EQ(labels[v], f);
+        }
+        CHECK_EQ(py::number_connected_components(pool, gra), count);
+    }
+}
+
+TEST_CASE("Test connected_components on CsrGraph") {
+    py::ThreadPool pool{2};
+    // Weakly connected: 0 -> 1 <- 2, 3 -> 4, 5 alone
+    const auto directed = py::CsrGraph<>(6, Edges{{0, 1}, {2, 1}, {3, 4}});
+    CHECK_EQ(py::connected_components(pool, directed),
+             std::vector<std::uint32_t>{0, 0, 0, 3, 3, 5});
+    CHECK_EQ(py::number_connected_components(pool, directed), 3);
+
+    // Stored in both directions
+    constexpr auto n = std::uint32_t{10000};
+    auto edges = mixed_edges(n);
+    const auto size = edges.size();
+    for (auto i = std::size_t{0}; i != size; ++i) {
+        edges.emplace_back(edges[i].second, edges[i].first);
+    }
+    const auto symmetric = py::CsrGraph<>(n, edges);
+    CHECK_EQ(py::connected_components(pool, symmetric, true),
+             py::connected_components(pool, symmetric, false));
+
+    CHECK(py::connected_components(pool, py::CsrGraph<>{}).empty());
+}
@@ -0,0 +1,122 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#    include <doctest/doctest.h>
+
+#    include <algorithm>
+#    include <boost/graph/adjacency_list.hpp>
+#    include <cstddef>
+#    include <cstdint>
+#    include <filesystem>
+#    include <fstream>
+#    include <py2cpp/csr_file.hpp>
+#    include <py2cpp/csr_graph.hpp>
+#    include <py2cpp/nx2bgl.hpp>
+#    include <stdexcept>
+#    include <string>
+#    include <system_error>
+#    include <tuple>
+#    include <utility>
+#    include <vector>
+
+using Csr = py::CsrGraph<>;
+
+static auto temp_file(const char* name) -> std::string {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static auto sample_edges() -> std::vector<std::pair<int, int>> {
+    return {{2, 0}, {0, 1}, {0, 2}, {1, 2}, {2, 3}, {0, 3}};
+}
+
+TEST_CASE("Test save_csr and open_csr round trip") {
+    const auto path = temp_file("py2cpp_test_round_trip.csr");
+    const auto weights = std::vector<double>{2.0, 0.1, 0.2, 1.2, 2.3, 0.3};
+    const auto original = py::CsrGraph<double>(4, sample_edges(), weights);
+    py::save_csr(path, original);
+
+    auto mapped = py::open_csr<double>(path);
+    CHECK(mapped.is_view());
+    CHECK_EQ(num_vertices(mapped), 4);
+    CHECK_EQ(num_edges(mapped), 6);
+    CHECK(std::ranges::equal(mapped.row_offsets(), original.row_offsets()));
+    CHECK(std::ranges::equal(mapped.column_indices(), original.column_indices()));
+    CHECK(std::ranges::equal(mapped.edge_properties(), original.edge_properties()));
+
+    // Writes go to private pages, never to the file
+    const auto e = edge(2, 0, mapped).first;
+    mapped[e] = -1.0;
+    CHECK_EQ(mapped[e], -1.0);
+    CHECK_EQ(py::open_csr<double>(path)[e], 2.0);
+
+    // The weights can be ignored, the types must match
+    CHECK_EQ(num_edges(py::open_csr(path)), 6);
+    CHECK_THROWS_AS(py::open_csr<float>(path), std::runtime_error);
+    CHECK_THROWS_AS((py::open_csr<double, std::uint64_t>(path)), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Test save_csr and open_csr round trip without edges") {
+    const auto path = temp_file("py2cpp_test_empty_weighted.csr");
+    const auto original = py::CsrGraph<double>(3, std::vector<std::pair<int, int>>{},
+                                               std::vector<double>{});
+    py::save_csr(path, original);
+
+    const auto mapped = py::open_csr<double>(path);
+    CHECK_EQ(num_vertices(mapped), 3);
+    CHECK_EQ(num_edges(mapped), 0);
+    CHECK(mapped.edge_properties().empty());
+    CHECK_THROWS_AS(py::open_csr<float>(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Test open_csr keeps the mapping alive") {
+    const auto path = temp_file("py2cpp_test_alive.csr");
+    py::save_csr(path, Csr(3, std::vector<std::pair<int, int>>{{0, 1}, {1, 2}}));
+    auto copy = Csr{};
+    {
+        const auto mapped = py::open_csr(path);
+        copy = mapped;
+    }
+    std::filesystem::remove(path);
+    CHECK(copy.is_view());
+    CHECK_EQ(num_edges(copy), 2);
+    CHECK_EQ(target(*out_edges(1, copy).first, copy), 2);
+}
+
+TEST_CASE("Test save_csr from a GrAdaptor") {
+    using Weight = boost::property<boost::edge_weight_t, int>;
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                        boost::no_property, Weight>;
+    auto G = py::GrAdaptor<Graph>(Graph(0));
+    G.add_edges_from(std::vector<std::tuple<int, int, int>>{{0, 1, 5}, {1, 2, 7}, {2, 0, 9}});
+    const auto path = temp_file("py2cpp_test_adaptor.csr");
+    py::save_csr(path, G, boost::get(boost::edge_weight, G));
+
+    auto H = py::GrAdaptor<py::CsrGraph<int>>(py::open_csr<int>(path));
+    CHECK_EQ(H.number_of_nodes(), 3);
+    CHECK_EQ(H.number_of_edges(), 3);
+    auto total = 0;
+    for (auto e : H.edges()) {
+        total += H[e];
+    }
+    CHECK_EQ(total, 21);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Test open_csr rejects bad files") {
+    CHECK_THROWS_AS(py::open_csr(temp_file("py2cpp_test_missing.csr")), std::system_error);
+
+    const auto path = temp_file("py2cpp_test_bad.csr");
+    {
+        auto out = std::ofstream(path, std::ios::binary);
+        out << "0 1\n1 2\n";
+    }
+    CHECK_THROWS_AS(py::open_csr(path), std::runtime_error);
+
+    py::save_csr(path, Csr(3, std::vector<std::pair<int, int>>{{0, 1}, {1, 2}}));
+    std::filesystem::resize_file(path, 80);
+    CHECK_THROWS_AS(py::open_csr(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+#endif
@@ -0,0 +1,228 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/breadth_first_search.hpp>
+#include <boost/graph/graph_concepts.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "lcg.hpp"
+
+using Csr = py::CsrGraph<>;
+using WeightedCsr = py::CsrGraph<int>;
+
+BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<Csr>));
+BOOST_CONCEPT_ASSERT((boost::EdgeListGraphConcept<Csr>));
+BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<Csr>));
+BOOST_CONCEPT_ASSERT((boost::AdjacencyGraphConcept<Csr>));
+
+static auto sample_edges() -> std::vector<std::pair<int, int>> {
+    return {{2, 0}, {0, 1}, {0, 2}, {1, 2}, {2, 3}, {0, 3}};
+}
+
+TEST_CASE("Test CsrGraph from edge list") {
+    const auto gra = Csr(4, sample_edges());
+    CHECK_EQ(num_vertices(gra), 4);
+    CHECK_EQ(num_edges(gra), 6);
+    CHECK_EQ(gra.row_offsets()[0], 0);
+    CHECK_EQ(gra.row_offsets()[4], 6);
+
+    // out-edges keep the input order
+    auto [first, last] = adjacent_vertices(0, gra);
+    CHECK_EQ(std::vector<std::uint32_t>(first, last), std::vector<std::uint32_t>{1, 2, 3});
+    CHECK_EQ(out_degree(2, gra), 2);
+    CHECK_EQ(out_degree(3, gra), 0);
+
+    auto count = 0;
+    for (auto [ei, eend] = edges(gra); ei != eend; ++ei) {
+        CHECK_EQ(gra.column_indices()[Csr::edge_index(*ei)], target(*ei, gra));
+        CHECK_LT(source(*ei, gra), 3);
+        ++count;
+    }
+    CHECK_EQ(count, 6);
+
+    auto [e, found] = edge(1, 2, gra);
+    CHECK(found);
+    CHECK_EQ(source(e, gra), 1);
+    CHECK_EQ(target(e, gra), 2);
+    CHECK_FALSE(edge(3, 0, gra).second);
+}
+
+TEST_CASE("Test CsrGraph edges skip empty rows") {
+    const auto gra = Csr(5, std::vector<std::pair<int, int>>{{1, 4}, {3, 0}});
+    auto sources = std::vector<std::uint32_t>{};
+    for (auto [ei, eend] = edges(gra); ei != eend; ++ei) {
+        sources.push_back(source(*ei, gra));
+    }
+    CHECK_EQ(sources, std::vector<std::uint32_t>{1, 3});
+    CHECK_EQ(num_edges(Csr{}), 0);
+    CHECK_EQ(num_vertices(Csr{}), 0);
+}
+
+TEST_CASE("Test CsrGraph edge properties") {
+    const auto weights = std::vector<int>{20, 1, 2, 12, 23, 3};
+    const auto gra = WeightedCsr(4, sample_edges(), weights);
+    REQUIRE_EQ(gra.edge_properties().size(), 6);
+    for (auto [ei, eend] = out_edges(0, gra); ei != eend; ++ei) {
+        CHECK_EQ(gra[*ei], static_cast<int>(target(*ei, gra)));
+    }
+    CHECK_EQ(gra[edge(2, 0, gra).first], 20);
+}
+
+TEST_CASE("Test CsrGraph rejects invalid input") {
+    CHECK_THROWS_AS(Csr(2, std::vector<std::pair<int, int>>{{0, 2}}), std::out_of_range);
+    CHECK_THROWS_AS(Csr(std::vector<std::size_t>{0, 2}, std::vector<std::uint32_t>{0}),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(Csr(std::vector<std::size_t>{0, 1}, std::vector<std::uint32_t>{1}),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(py::CsrGraph<int>(std::vector<std::size_t>{0, 1},
+                                      std::vector<std::uint32_t>{0}, std::vector<int>{1, 2}),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Test to_csr from adjacency_list") {
+    using Weight = boost::property<boost::edge_weight_t, int>;
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                        boost::no_property, Weight>;
+    auto gra = Graph(4);
+    for (auto [u, v] : sample_edges()) {
+        boost::add_edge(static_cast<std::size_t>(u), static_cast<std::size_t>(v), 10 * u + v, gra);
+    }
+
+    const auto csr = py::to_csr(gra);
+    CHECK_EQ(num_vertices(csr), 4);
+    CHECK_EQ(num_edges(csr), 6);
+    auto [first, last] = adjacent_vertices(0, csr);
+    CHECK_EQ(std::vector<std::uint32_t>(first, last), std::vector<std::uint32_t>{1, 2, 3});
+
+    const auto weighted = py::to_csr(gra, boost::get(boost::edge_weight, gra));
+    for (auto [ei, eend] = edges(weighted); ei != eend; ++ei) {
+        const auto u = static_cast<int>(source(*ei, weighted));
+        const auto v = static_cast<int>(target(*ei, weighted));
+        CHECK_EQ(weighted[*ei], 10 * u + v);
+    }
+}
+
+TEST_CASE("Test to_csr from undirected graph stores both directions") {
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
+    auto gra = Graph(3);
+    boost::add_edge(0, 1, gra);
+    boost::add_edge(1, 2, gra);
+    const auto csr = py::to_csr<std::uint64_t>(gra);
+    CHECK_EQ(num_edges(csr), 4);
+    CHECK_EQ(out_degree(1, csr), 2);
+}
+
+TEST_CASE("Test GrAdaptor over CsrGraph") {
+    auto G = py::GrAdaptor<Csr>(Csr(4, sample_edges()));
+    CHECK_EQ(G.number_of_nodes(), 4);
+    CHECK_EQ(G.number_of_edges(), 6);
+
+    auto nodes = 0;
+    for (auto v : G) {
+        (void)v;
+        ++nodes;
+    }
+    CHECK_EQ(nodes, 4);
+
+    auto count = 0;
+    for (auto e : G.edges()) {
+        auto [s, t] = G.end_points(e);
+        CHECK_EQ(s, G.source(e));
+        CHECK_EQ(t, G.target(e));
+        ++count;
+    }
+    CHECK_EQ(count, 6);
+
+    auto targets = std::vector<std::uint32_t>{};
+    for (auto e : G.neighbors(0)) {
+        targets.push_back(G.target(e));
+    }
+    CHECK_EQ(targets, std::vector<std::uint32_t>{1, 2, 3});
+    CHECK_EQ(py::GrAdaptor<Csr>::null_vertex(), Csr::null_vertex());
+}
+
+TEST_CASE("Test GrAdaptor adjacent_nodes over CsrGraph is a span") {
+    const auto G = py::GrAdaptor<Csr>(Csr(4, sample_edges()));
+    const auto nodes = G.adjacent_nodes(0);
+    static_assert(std::is_same_v<decltype(nodes), const std::span<const std::uint32_t>>);
+    CHECK_EQ(std::vector<std::uint32_t>(nodes.begin(), nodes.end()),
+             std::vector<std::uint32_t>{1, 2, 3});
+    CHECK_EQ(nodes.data(), G.column_indices().data());
+    CHECK(G.adjacent_nodes(3).empty());
+}
+
+TEST_CASE("Test GrAdaptor edge attributes over CsrGraph") {
+    auto G = py::GrAdaptor<Csr>(Csr(4, sample_edges()));
+    auto cost = G.edge_data().add_column<double>("cost");
+    REQUIRE_EQ(cost.size(), 6);
+    for (auto e : G.edges()) {
+        cost[G.edge_id(e)] = static_cast<double>(G.target(e));
+    }
+    CHECK_EQ(G.edge_attr<double>(2, 0, "cost"), 0.0);
+    CHECK_EQ(G.edge_attr<double>(0, 3, "cost"), 3.0);
+    G.node_data().add_column<int>("color", -1);
+    CHECK_EQ(G.node_attr<int>(3, "color"), -1);
+}
+
+TEST_CASE("Test CsrGraph with a BGL algorithm") {
+    const auto gra = Csr(5, sample_edges());
+    auto dist = std::vector<int>(5, -1);
+    dist[2] = 0;
+    auto record = boost::record_distances(dist.data(), boost::on_tree_edge{});
+    boost::breadth_first_search(gra, 2, boost::visitor(boost::make_bfs_visitor(record)));
+    CHECK_EQ(dist, std::vector<int>{1, 2, 0, 1, -1});
+}
+
+using EdgeList = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+static auto random_edges(std::size_t n, std::size_t m) -> EdgeList {
+    auto edges = EdgeList{};
+    edges.reserve(m);
+    auto random = Lcg{12345};
+    for (auto i = std::size_t{0}; i != m; ++i) {
+        const auto u = random(n);
+        edges.emplace_back(u, random(n));
+    }
+    return edges;
+}
+
+TEST_CASE("Test CsrGraph parallel construction matches sequential") {
+    py::ThreadPool pool{3};
+    const auto edges = random_edges(1000, 200000);
+    auto weights = std::vector<int>(edges.size());
+    for (auto i = std::size_t{0}; i != weights.size(); ++i) {
+        weights[i] = static_cast<int>(i);
+    }
+
+    const auto expected = WeightedCsr(1000, edges, weights);
+    const auto gra = WeightedCsr(pool, 1000, edges, weights);
+    CHECK(std::ranges::equal(gra.row_offsets(), expected.row_offsets()));
+    CHECK(std::ranges::equal(gra.column_indices(), expected.column_indices()));
+    CHECK(std::ranges::equal(gra.edge_properties(), expected.edge_properties()));
+
+    const auto plain = Csr(pool, 1000, edges);
+    CHECK(std::ranges::equal(plain.column_indices(), expected.column_indices()));
+    CHECK(plain.edge_properties().empty());
+}
+
+TEST_CASE("Test CsrGraph parallel construction errors") {
+    py::ThreadPool pool{2};
+    auto edges = random_edges(100, 100000);
+    edges[77777].second = 100;
+    CHECK_THROWS_AS(Csr(pool, 100, edges), std::out_of_range);
+    CHECK_THROWS_AS(WeightedCsr(pool, 100, random_edges(100, 10), std::vector<int>{1}),
+                    std::invalid_argument);
+    const auto empty = Csr(pool, 3, std::vector<std::pair<int, int>>{});
+    CHECK_EQ(num_vertices(empty), 3);
+    CHECK_EQ(num_edges(empty), 0);
+}
@@ -0,0 +1,129 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/dag.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lcg.hpp"
+
+using Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+// Random DAG: edges from lower to higher rank, with the ranks shuffled
+static auto random_dag(std::uint32_t n, std::size_t m) -> Edges {
+    auto random = Lcg{5};
+    auto id = std::vector<std::uint32_t>(n);
+    for (auto v = std::uint32_t{0}; v != n; ++v) id[v] = v;
+    for (auto i = n - 1; i != 0; --i) std::swap(id[i], id[random(i + 1)]);
+    auto edges = Edges{};
+    while (edges.size() != m) {
+        const auto a = random(n);
+        const auto b = random(n);
+        if (a < b) edges.emplace_back(id[a], id[b]);
+    }
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+TEST_CASE("Test topological_generations and topological_sort") {
+    constexpr auto n = std::uint32_t{500};
+    const auto edges = random_dag(n, 3000);
+    const auto gra = py::CsrGraph<>(n, edges);
+    py::ThreadPool pool{3};
+
+    // The generation of a vertex is the longest path ending at it
+    auto depth = std::vector<std::size_t>(n);
+    for (auto round = std::uint32_t{0}; round != n; ++round) {
+        for (const auto& [u, v] : edges) depth[v] = std::max(depth[v], depth[u] + 1);
+    }
+    const auto levels = py::topological_generations(pool, gra);
+    auto seen = std::size_t{0};
+    for (auto k = std::size_t{0}; k != levels.size(); ++k) {
+        CHECK(std::is_sorted(levels[k].begin(), levels[k].end()));
+        for (const auto v : levels[k]) CHECK_EQ(depth[v], k);
+        seen += levels[k].size();
+    }
+    CHECK_EQ(seen, n);
+
+    const auto order = py::topological_sort(pool, gra);
+    auto position = std::vector<std::size_t>(n);
+    for (auto i = std::size_t{0}; i != order.size(); ++i) position[order[i]] = i;
+    for (const auto& [u, v] : edges) CHECK_LT(position[u], position[v]);
+
+    // A BGL graph with a cycle
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS>;
+    auto G = py::GrAdaptor<Graph>(Graph(4));
+    G.add_edges_from(std::vector<std::pair<int, int>>{{0, 1}, {1, 2}, {2, 3}});
+    CHECK_EQ(py::topological_sort(pool, G), std::vector<std::size_t>{0, 1, 2, 3});
+    G.add_edge(3, 1);
+    CHECK_THROWS_AS((void)py::topological_generations(pool, G), std::invalid_argument);
+}
+
+TEST_CASE("Test dag_foreach") {
+    constexpr auto n = std::uint32_t{2000};
+    const auto edges = random_dag(n, 12000);
+    const auto gra = py::CsrGraph<>(n, edges);
+    auto predecessors = std::vector<std::vector<std::uint32_t>>(n);
+    for (const auto& [u, v] : edges) predecessors[v].push_back(u);
+
+    for (const auto schedule : {py::DagSchedule::levels, py::DagSchedule::dependencies}) {
+        for (const auto threads : {1U, 4U}) {
+            py::ThreadPool pool{threads};
+            // Longest path to every vertex, read from the predecessors' results
+            auto finished = std::vector<std::atomic<bool>>(n);
+            auto depth = std::vector<std::size_t>(n);
+            auto calls = std::atomic<std::size_t>{0};
+            auto ordered = std::atomic<bool>{true};
+            py::dag_foreach(
+                pool, gra,
+                [&](std::uint32_t v) {
+                    for (const auto u : predecessors[v]) {
+                        if (!finished[u].load(std::memory_order_relaxed)) ordered = false;
+                        depth[v] = std::max(depth[v], depth[u] + 1);
+                    }
+                    finished[v].store(true, std::memory_order_relaxed);
+                    calls.fetch_add(1);
+                },
+                schedule);
+            CHECK(ordered.load());
+            CHECK_EQ(calls.load(), n);
+            const auto levels = py::topological_generations(pool, gra);
+            for (auto k = std::size_t{0}; k != levels.size(); ++k) {
+                for (const auto v : levels[k]) CHECK_EQ(depth[v], k);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test dag_foreach errors") {
+    py::ThreadPool pool{2};
+    // 0 -> 1 -> 2 -> 1, and 3 on its own
+    const auto cyclic = py::CsrGraph<>(4, Edges{{0, 1}, {1, 2}, {2, 1}});
+    auto calls = std::atomic<int>{0};
+    const auto count = [&](std::uint32_t) { calls.fetch_add(1); };
+    CHECK_THROWS_AS(py::dag_foreach(pool, cyclic, count), std::invalid_argument);
+    CHECK_EQ(calls.load(), 0);
+    CHECK_THROWS_AS(py::dag_foreach(pool, cyclic, count, py::DagSchedule::dependencies),
+                    std::invalid_argument);
+    CHECK_EQ(calls.load(), 2);  // 0 and 3
+
+    const auto chain = py::CsrGraph<>(4, Edges{{0, 1}, {1, 2}, {2, 3}});
+    auto visited = std::vector<std::uint32_t>{};
+    const auto fail_at_2 = [&](std::uint32_t v) {
+        if (v == 2) throw std::runtime_error("stop");
+        visited.push_back(v);
+    };
+    for (const auto schedule : {py::DagSchedule::levels, py::DagSchedule::dependencies}) {
+        visited.clear();
+        CHECK_THROWS_AS(py::dag_foreach(pool, chain, fail_at_2, schedule), std::runtime_error);
+        CHECK_EQ(visited, std::vector<std::uint32_t>{0, 1});
+    }
+}
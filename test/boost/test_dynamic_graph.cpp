@@ -0,0 +1,128 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <boost/graph/breadth_first_search.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/dynamic_graph.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+// All the edges of a snapshot, through the BGL edge list
+static auto edge_set(const py::DynamicSnapshot<>& snap)
+    -> std::set<std::pair<std::uint32_t, std::uint32_t>> {
+    auto result = std::set<std::pair<std::uint32_t, std::uint32_t>>{};
+    for (auto [it, last] = edges(snap); it != last; ++it) {
+        result.emplace(source(*it, snap), target(*it, snap));
+    }
+    return result;
+}
+
+TEST_CASE("Test DynamicGraph updates and snapshots") {
+    py::ThreadPool pool{2};
+    auto gra = py::DynamicGraph<>(pool, 5, Edges{{0, 1}, {1, 2}, {2, 3}, {0, 1}, {3, 3}});
+    CHECK_EQ(gra.pending_updates(), 0);
+    const auto before = gra.snapshot();
+    CHECK_EQ(num_vertices(before), 5);
+    CHECK_EQ(num_edges(before), 4);  // the repeated 0 -> 1 counts once
+
+    gra.add_edge(4, 0);
+    gra.add_edge(0, 3);
+    gra.remove_edge(1, 2);
+    gra.remove_edge(2, 0);  // absent: no effect
+    gra.add_edge(1, 2);
+    gra.remove_edge(1, 2);  // the last update of an edge wins
+    const auto v = gra.add_node();
+    CHECK_EQ(v, 5);
+    gra.add_edge(5, 4);
+    CHECK_EQ(gra.pending_updates(), 7);
+
+    const auto after = gra.snapshot();
+    using Set = std::set<std::pair<std::uint32_t, std::uint32_t>>;
+    const auto expected = Set{{0, 1}, {0, 3}, {2, 3}, {3, 3}, {4, 0}, {5, 4}};
+    CHECK_EQ(edge_set(after), expected);
+    CHECK_EQ(num_vertices(after), 6);
+    CHECK_EQ(num_edges(after), expected.size());
+    CHECK_EQ(out_degree(0, after), 2);
+    CHECK(after.has_edge(0, 3));
+    CHECK_FALSE(after.has_edge(1, 2));
+    CHECK(edge(5, 4, after).second);
+    CHECK_EQ(target(edge(0, 3, after).first, after), 3);
+    CHECK_EQ(after.neighbors(0)[1], 3);
+
+    // The old snapshot is unchanged, also after compaction
+    gra.compact();
+    CHECK_EQ(gra.pending_updates(), 0);
+    CHECK_EQ(edge_set(before), (Set{{0, 1}, {1, 2}, {2, 3}, {3, 3}}));
+    CHECK_EQ(edge_set(gra.snapshot()), expected);
+    CHECK_EQ(gra.snapshot().pending_updates(), 0);
+
+    CHECK_THROWS_AS(gra.add_edge(0, 6), std::out_of_range);
+    CHECK_THROWS_AS((void)after.neighbors(6), std::out_of_range);
+}
+
+TEST_CASE("Test DynamicSnapshot as a BGL graph") {
+    py::ThreadPool pool{1};
+    auto gra = py::DynamicGraph<>(pool, 4, Edges{{0, 1}, {1, 2}});
+    gra.add_edge(2, 3);
+    const auto snap = gra.snapshot();
+    auto dist = std::vector<std::size_t>(4);
+    boost::breadth_first_search(
+        snap, 0,
+        boost::visitor(boost::make_bfs_visitor(boost::record_distances(dist.data(),
+                                                                       boost::on_tree_edge{}))));
+    CHECK_EQ(dist, std::vector<std::size_t>{0, 1, 2, 3});
+
+    auto G = py::GrAdaptor<py::DynamicSnapshot<>>(gra.snapshot());
+    CHECK_EQ(G.number_of_nodes(), 4);
+    CHECK_EQ(G.number_of_edges(), 3);
+    auto targets = std::vector<std::uint32_t>{};
+    for (const auto w : G.adjacent_nodes(2)) targets.push_back(w);
+    CHECK_EQ(targets, std::vector<std::uint32_t>{3});
+}
+
+TEST_CASE("Test DynamicGraph background compaction") {
+    py::ThreadPool pool{3};
+    constexpr auto n = std::uint32_t{64};
+    auto gra = py::DynamicGraph<>(pool, n);
+    gra.compaction_threshold = 100;
+
+    // Two writers on disjoint vertex ranges, one reader checking every snapshot
+    auto done = std::atomic<int>{0};
+    const auto writer = [&](std::uint32_t first) {
+        for (auto round = 0; round != 50; ++round) {
+            for (auto u = first; u != first + n / 2; ++u) gra.add_edge(u, (u + 1) % n);
+            for (auto u = first; u != first + n / 2; u += 2) gra.remove_edge(u, (u + 1) % n);
+        }
+        done.fetch_add(1);
+    };
+    auto threads = std::vector<std::thread>{};
+    threads.emplace_back(writer, 0);
+    threads.emplace_back(writer, n / 2);
+    while (done.load() != 2) {
+        const auto snap = gra.snapshot();
+        auto count = std::size_t{0};
+        for (auto u = std::uint32_t{0}; u != n; ++u) {
+            for (const auto w : snap.neighbors(u)) {
+                CHECK_EQ(w, (u + 1) % n);
+                ++count;
+            }
+        }
+        CHECK_EQ(count, num_edges(snap));
+    }
+    for (auto& t : threads) t.join();
+    gra.wait();
+    const auto last = gra.snapshot();
+    CHECK_EQ(num_edges(last), n / 2);
+    for (auto u = std::uint32_t{0}; u != n; ++u) {
+        CHECK_EQ(last.has_edge(u, (u + 1) % n), u % 2 == 1);
+    }
+    CHECK_LT(gra.pending_updates(), 6400);
+}
@@ -0,0 +1,115 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#    include <doctest/doctest.h>
+
+#    include <algorithm>
+#    include <cstddef>
+#    include <cstdint>
+#    include <filesystem>
+#    include <fstream>
+#    include <py2cpp/edgelist.hpp>
+#    include <py2cpp/thread_pool.hpp>
+#    include <stdexcept>
+#    include <string>
+#    include <utility>
+#    include <vector>
+
+static auto write_file(const char* name, const std::string& text) -> std::string {
+    const auto path = (std::filesystem::temp_directory_path() / name).string();
+    auto out = std::ofstream(path, std::ios::binary);
+    out << text;
+    return path;
+}
+
+static auto neighbors(const auto& gra, std::uint32_t v) -> std::vector<std::uint32_t> {
+    auto [first, last] = adjacent_vertices(v, gra);
+    return {first, last};
+}
+
+TEST_CASE("Test read_edgelist relabels nodes") {
+    auto pool = py::ThreadPool{2};
+    const auto path = write_file("py2cpp_test_relabel.edgelist",
+                                 "# written by networkx\n"
+                                 "10 30 {}\n"
+                                 "\n"
+                                 "30 20 {'weight': 2.5}\r\n"
+                                 "  10 20   # trailing comment\n"
+                                 "20 10");
+    const auto result = py::read_edgelist(pool, path);
+    CHECK_EQ(result.labels, std::vector<std::int64_t>{10, 20, 30});
+    CHECK_EQ(num_vertices(result.graph), 3);
+    CHECK_EQ(num_edges(result.graph), 4);
+    CHECK_EQ(neighbors(result.graph, 0), std::vector<std::uint32_t>{2, 1});
+    CHECK_EQ(neighbors(result.graph, 2), std::vector<std::uint32_t>{1});
+    CHECK_EQ(result.stats.edges, 4);
+    CHECK_GT(result.stats.bytes, 0);
+    std::filesystem::remove(path);
+
+    // Widely spread labels are numbered the same way
+    const auto sparse = write_file("py2cpp_test_sparse.edgelist", "1000000000000 5\n5 -7\n");
+    const auto spread = py::read_edgelist(pool, sparse);
+    CHECK_EQ(spread.labels, std::vector<std::int64_t>{-7, 5, 1000000000000});
+    CHECK_EQ(neighbors(spread.graph, 2), std::vector<std::uint32_t>{1});
+    CHECK_EQ(neighbors(spread.graph, 1), std::vector<std::uint32_t>{0});
+    std::filesystem::remove(sparse);
+}
+
+TEST_CASE("Test read_edgelist weights and undirected graphs") {
+    auto pool = py::ThreadPool{2};
+    const auto path = write_file("py2cpp_test_weighted.edgelist",
+                                 "0 1 0.5\n1 2 {'weight': 4, 'color': 'red'}\n2 3 {}\n");
+    const auto options = py::EdgeListOptions{.relabel = false, .directed = false};
+    const auto result = py::read_edgelist<double>(pool, path, options);
+    const auto& gra = result.graph;
+    CHECK(result.labels.empty());
+    CHECK_EQ(num_vertices(gra), 4);
+    CHECK_EQ(num_edges(gra), 6);
+    CHECK_EQ(result.stats.edges, 3);
+    CHECK_EQ(gra[edge(1, 0, gra).first], 0.5);
+    CHECK_EQ(gra[edge(1, 2, gra).first], 4.0);
+    CHECK_EQ(gra[edge(3, 2, gra).first], 1.0);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Test read_edgelist splits large files into chunks") {
+    auto text = std::string{};
+    const auto n = 5000;
+    for (auto i = 0; i != 40 * n; ++i) {
+        text += std::to_string(i % n) + ' ' + std::to_string((7 * i + 1) % n) + ' '
+                + std::to_string(i % 10) + ".25\n";
+    }
+    const auto path = write_file("py2cpp_test_large.edgelist", text);
+    auto pool = py::ThreadPool{3};
+    const auto result = py::read_edgelist<float>(pool, path);
+    const auto& gra = result.graph;
+    REQUIRE_EQ(num_edges(gra), 40 * n);
+    CHECK_EQ(num_vertices(gra), n);
+
+    // Same graph as a sequential build, so the order of the file is kept
+    auto edges = std::vector<std::pair<int, int>>{};
+    auto weights = std::vector<float>{};
+    for (auto i = 0; i != 40 * n; ++i) {
+        edges.emplace_back(i % n, (7 * i + 1) % n);
+        weights.push_back(static_cast<float>(i % 10) + 0.25F);
+    }
+    const auto expected = py::CsrGraph<float>(static_cast<std::size_t>(n), edges, weights);
+    CHECK(std::ranges::equal(gra.column_indices(), expected.column_indices()));
+    CHECK(std::ranges::equal(gra.edge_properties(), expected.edge_properties()));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Test read_edgelist errors") {
+    auto pool = py::ThreadPool{1};
+    const auto bad = write_file("py2cpp_test_bad.edgelist", "0 1\n0 x\n");
+    CHECK_THROWS_AS(py::read_edgelist(pool, bad), std::runtime_error);
+    const auto negative = write_file("py2cpp_test_negative.edgelist", "-1 2\n");
+    CHECK_THROWS_AS(py::read_edgelist(pool, negative, {.relabel = false}), std::out_of_range);
+    CHECK_EQ(py::read_edgelist(pool, negative).labels, std::vector<std::int64_t>{-1, 2});
+    const auto empty = write_file("py2cpp_test_empty.edgelist", "");
+    CHECK_EQ(num_vertices(py::read_edgelist(pool, empty).graph), 0);
+    std::filesystem::remove(bad);
+    std::filesystem::remove(negative);
+    std::filesystem::remove(empty);
+}
+
+#endif
@@ -0,0 +1,208 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/fractions.hpp>
+#include <py2cpp/min_cost_flow.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lcg.hpp"
+
+using Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+using Fraction = fun::Fraction<std::int64_t>;
+constexpr auto inf = py::MinCostFlowSolver<>::infinite;
+
+template <typename Cost> struct Instance {
+    std::uint32_t n;
+    Edges edges;  // sorted by source, so that edge ids are positions
+    std::vector<std::int64_t> demand;
+    std::vector<std::int64_t> capacity;
+    std::vector<Cost> cost;
+};
+
+// Random instance with a ring of expensive uncapacitated edges, so that
+// it is feasible, and negative costs only on capacitated edges
+template <typename Cost> static auto random_instance(std::uint32_t n, std::size_t m,
+                                                     std::uint64_t seed) -> Instance<Cost> {
+    auto random = Lcg{seed};
+    const auto next = [&random](std::uint32_t bound) {
+        return static_cast<std::int64_t>(random(bound));
+    };
+    struct Edge {
+        std::uint32_t u, v;
+        std::int64_t capacity, cost;
+        auto operator<(const Edge& other) const { return this->u < other.u; }
+    };
+    auto all = std::vector<Edge>{};
+    for (auto u = std::uint32_t{0}; u != n; ++u) all.push_back({u, (u + 1) % n, inf, 120});
+    for (auto k = std::size_t{0}; k != m; ++k) {
+        const auto u = random(n);
+        const auto v = random(n);
+        const auto cost = next(60) - 10;
+        const auto capacity = cost >= 0 && next(4) == 0 ? inf : next(12);
+        all.push_back({u, v, capacity, cost});
+    }
+    std::stable_sort(all.begin(), all.end());
+    auto result = Instance<Cost>{n, {}, std::vector<std::int64_t>(n), {}, {}};
+    for (const auto& e : all) {
+        result.edges.emplace_back(e.u, e.v);
+        result.capacity.push_back(e.capacity);
+        result.cost.push_back(Cost(e.cost) / std::int64_t{6});
+    }
+    for (auto k = 0; k != 8; ++k) {
+        const auto amount = next(20);
+        result.demand[random(n)] -= amount;
+        result.demand[random(n)] += amount;
+    }
+    return result;
+}
+
+// The flow meets the demands and bounds, and its residual graph has no
+// negative cycle (Bellman-Ford from a virtual source)
+template <typename Cost>
+static void check_optimal(const Instance<Cost>& inst, std::span<const std::int64_t> flow) {
+    auto net = std::vector<std::int64_t>(inst.n);
+    struct Arc {
+        std::uint32_t u, v;
+        Cost cost;
+    };
+    auto residual = std::vector<Arc>{};
+    for (auto id = std::size_t{0}; id != inst.edges.size(); ++id) {
+        const auto [u, v] = inst.edges[id];
+        REQUIRE((flow[id] >= 0 && flow[id] <= inst.capacity[id]));
+        net[u] -= flow[id];
+        net[v] += flow[id];
+        if (flow[id] < inst.capacity[id]) residual.push_back({u, v, inst.cost[id]});
+        if (flow[id] > 0) residual.push_back({v, u, -inst.cost[id]});
+    }
+    CHECK_EQ(net, inst.demand);
+    auto dist = std::vector<Cost>(inst.n);
+    auto changed = true;
+    for (auto round = std::uint32_t{0}; changed && round <= inst.n; ++round) {
+        changed = false;
+        for (const auto& a : residual) {
+            if (dist[a.u] + a.cost < dist[a.v]) {
+                dist[a.v] = dist[a.u] + a.cost;
+                changed = true;
+            }
+        }
+    }
+    CHECK_FALSE(changed);
+}
+
+template <typename Cost> static auto total_cost(const Instance<Cost>& inst,
+                                                std::span<const std::int64_t> flow) -> Cost {
+    auto total = Cost{};
+    for (auto id = std::size_t{0}; id != inst.edges.size(); ++id) {
+        total = total + inst.cost[id] * flow[id];
+    }
+    return total;
+}
+
+TEST_CASE("Test network_simplex over GrAdaptor attributes") {
+    using Index = boost::property<boost::edge_index_t, std::size_t>;
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                        boost::no_property, Index>;
+    // The NetworkX example: a -> {b, c} -> d
+    auto G = py::GrAdaptor<Graph>(Graph(4));
+    G.add_edges_from(std::vector<std::pair<int, int>>{{0, 1}, {0, 2}, {1, 3}, {2, 3}});
+    auto demand = G.node_data().add_column<std::int64_t>("demand");
+    demand[0] = -5;
+    demand[3] = 5;
+    auto weight = G.edge_data().add_column<std::int64_t>("weight");
+    auto capacity = G.edge_data().add_column<std::int64_t>("capacity");
+    weight[0] = 3;
+    weight[1] = 6;
+    weight[2] = 1;
+    weight[3] = 2;
+    capacity[0] = 4;
+    capacity[1] = 10;
+    capacity[2] = 9;
+    capacity[3] = 5;
+
+    const auto [cost, flow] = py::network_simplex<std::int64_t>(G);
+    CHECK_EQ(cost, 24);
+    CHECK_EQ(flow, std::vector<std::int64_t>{4, 1, 4, 1});
+    CHECK_EQ(py::min_cost_flow<std::int64_t>(G), flow);
+
+    // Without capacities everything takes the cheapest path
+    G.edge_data().erase("capacity");
+    CHECK_EQ(py::min_cost_flow<std::int64_t>(G), std::vector<std::int64_t>{5, 0, 5, 0});
+
+    CHECK_THROWS_AS((void)py::min_cost_flow<Fraction>(G), std::invalid_argument);
+    demand[3] = 4;
+    CHECK_THROWS_AS((void)py::min_cost_flow<std::int64_t>(G), std::invalid_argument);
+}
+
+// Cold and warm runs on random instances give optimal flows
+template <typename Cost> static void check_random_instances() {
+    for (auto seed = std::uint64_t{1}; seed != 6; ++seed) {
+        auto inst = random_instance<Cost>(40, 200, seed);
+        const auto gra = py::CsrGraph<>(inst.n, inst.edges);
+        auto solver = py::MinCostFlowSolver<Cost>(gra);
+        auto cost = solver.run(inst.demand, inst.capacity, inst.cost);
+        CHECK_FALSE(solver.warm_started());
+        check_optimal(inst, solver.flow());
+        CHECK_EQ(cost, total_cost(inst, solver.flow()));
+
+        // New costs keep the last tree feasible
+        for (auto id = std::size_t{0}; id < inst.cost.size(); id += 7) {
+            inst.cost[id] = inst.cost[id] + Cost(static_cast<std::int64_t>(id % 3 + 1)) / 2L;
+        }
+        cost = solver.run(inst.demand, inst.capacity, inst.cost);
+        CHECK(solver.warm_started());
+        check_optimal(inst, solver.flow());
+        CHECK_EQ(cost, py::MinCostFlowSolver<Cost>(gra).run(inst.demand, inst.capacity,
+                                                            inst.cost));
+
+        // New demands and capacities, repaired by dual pivots
+        inst.demand[0] += 3;
+        inst.demand[inst.n - 1] -= 3;
+        for (auto id = std::size_t{1}; id < inst.capacity.size(); id += 11) {
+            if (inst.capacity[id] != inf) inst.capacity[id] += 2;
+        }
+        cost = solver.run(inst.demand, inst.capacity, inst.cost);
+        CHECK(solver.warm_started());
+        check_optimal(inst, solver.flow());
+        CHECK_EQ(cost, py::MinCostFlowSolver<Cost>(gra).run(inst.demand, inst.capacity,
+                                                            inst.cost));
+    }
+}
+
+TEST_CASE("Test MinCostFlowSolver on random instances") {
+    check_random_instances<std::int64_t>();
+    check_random_instances<Fraction>();
+}
+
+TEST_CASE("Test MinCostFlowSolver errors and special edges") {
+    // 0 -> 1 -> 2 -> 0, with a self-loop at 1 and 3 on its own
+    const auto gra = py::CsrGraph<>(4, Edges{{0, 1}, {1, 1}, {1, 2}, {2, 0}});
+    auto solver = py::MinCostFlowSolver<>(gra);
+    auto demand = std::vector<std::int64_t>{-2, 0, 2, 0};
+    auto capacity = std::vector<std::int64_t>{inf, 3, inf, inf};
+    auto cost = std::vector<std::int64_t>{1, -4, 1, 1};
+    CHECK_EQ(solver.run(demand, capacity, cost), 4 - 12);
+    CHECK_EQ(std::vector<std::int64_t>(solver.flow().begin(), solver.flow().end()),
+             (std::vector<std::int64_t>{2, 3, 2, 0}));
+
+    // Negative cycle of infinite capacity
+    cost[3] = -3;
+    CHECK_THROWS_AS((void)solver.run(demand, capacity, cost), std::invalid_argument);
+    cost[3] = 1;
+    CHECK_EQ(solver.run(demand, capacity, cost), 4 - 12);
+
+    capacity[2] = 1;  // only 1 unit gets to 2
+    CHECK_THROWS_AS((void)solver.run(demand, capacity, cost), std::invalid_argument);
+    demand[3] = 1;
+    CHECK_THROWS_AS((void)solver.run(demand, capacity, cost), std::invalid_argument);
+    capacity[0] = -1;
+    CHECK_THROWS_AS((void)solver.run(demand, capacity, cost), std::invalid_argument);
+    CHECK_THROWS_AS((void)solver.run(demand, std::vector<std::int64_t>(3), cost),
+                    std::invalid_argument);
+}
@@ -0,0 +1,158 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/min_cycle_ratio.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lcg.hpp"
+
+using Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+using Ratio = py::MinCycleRatioSolver<>::Ratio;
+
+// Minimum ratio over all simple cycles, by brute force
+static auto brute_force(std::size_t n, const Edges& edges, const std::vector<std::int64_t>& cost,
+                        const std::vector<std::int64_t>& time) -> std::optional<Ratio> {
+    auto best = std::optional<Ratio>{};
+    auto on_path = std::vector<char>(n);
+    // Cycles through `start` with all other vertices above it
+    const auto search = [&](auto&& self, std::uint32_t start, std::uint32_t u, std::int64_t c,
+                            std::int64_t t) -> void {
+        for (auto id = std::size_t{0}; id != edges.size(); ++id) {
+            const auto [a, b] = edges[id];
+            if (a != u || b < start) continue;
+            if (b == start) {
+                const auto ratio = Ratio(c + cost[id], t + time[id]);
+                if (!best || ratio < *best) best = ratio;
+            } else if (on_path[b] == 0) {
+                on_path[b] = 1;
+                self(self, start, b, c + cost[id], t + time[id]);
+                on_path[b] = 0;
+            }
+        }
+    };
+    for (auto s = std::uint32_t{0}; s != n; ++s) {
+        search(search, s, s, 0, 0);
+    }
+    return best;
+}
+
+// The result has the expected ratio and its cycle attains it
+template <typename Result>
+static void check_result(const Edges& edges, const std::vector<std::int64_t>& cost,
+                         const std::vector<std::int64_t>& time, const std::optional<Result>& result,
+                         const std::optional<Ratio>& expected) {
+    REQUIRE_EQ(result.has_value(), expected.has_value());
+    if (!result) return;
+    CHECK_EQ(result->ratio, *expected);
+    auto total_cost = std::int64_t{0};
+    auto total_time = std::int64_t{0};
+    const auto& cycle = result->cycle;
+    for (auto i = std::size_t{0}; i != cycle.size(); ++i) {
+        CHECK_EQ(edges[cycle[i]].second, edges[cycle[(i + 1) % cycle.size()]].first);
+        total_cost += cost[cycle[i]];
+        total_time += time[cycle[i]];
+    }
+    CHECK_EQ(Ratio(total_cost, total_time), result->ratio);
+}
+
+TEST_CASE("Test MinCycleRatioSolver against brute force") {
+    auto random = Lcg{3};
+    py::ThreadPool pool{2};
+    for (auto trial = 0; trial != 40; ++trial) {
+        constexpr auto n = std::size_t{7};
+        auto edges = Edges{};
+        auto cost = std::vector<std::int64_t>{};
+        auto time = std::vector<std::int64_t>{};
+        // Sorted by source, so that the edge ids of the CsrGraph are the list positions
+        for (auto u = std::uint32_t{0}; u != n; ++u) {
+            for (auto k = random(4); k != 0; --k) {
+                edges.emplace_back(u, random(n));
+                cost.push_back(static_cast<std::int64_t>(random(41)) - 20);
+                time.push_back(1 + static_cast<std::int64_t>(random(5)));
+            }
+        }
+        const auto gra = py::CsrGraph<>(n, edges);
+        const auto expected = brute_force(n, edges, cost, time);
+        auto solver = py::MinCycleRatioSolver<>(gra);
+        check_result(edges, cost, time, solver.run(cost, time), expected);
+        auto parallel = py::MinCycleRatioSolver<>(pool, gra);
+        check_result(edges, cost, time, parallel.run(cost, time), expected);
+        // The portable 128-bit integers used where there is no __int128
+        auto portable = py::MinCycleRatioSolver<std::uint32_t, py::detail::WideInt>(gra);
+        check_result(edges, cost, time, portable.run(cost, time), expected);
+    }
+}
+
+TEST_CASE("Test min_cycle_ratio on a circuit with register edges") {
+    using Index = boost::property<boost::edge_index_t, std::size_t>;
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                        boost::no_property, Index>;
+    // Two loops: 0 -> 1 -> 2 -> 0 with delay 7 over 2 registers, and
+    // 1 -> 3 -> 1 with delay 4 over 1 register; combinational edges take no time
+    auto G = py::GrAdaptor<Graph>(Graph(4));
+    G.add_edges_from(std::vector<std::pair<int, int>>{{0, 1}, {1, 2}, {2, 0}, {1, 3}, {3, 1}});
+    auto cost = G.edge_data().add_column<std::int64_t>("cost");
+    auto time = G.edge_data().add_column<std::int64_t>("time");
+    const auto delays = {2, 3, 2, 1, 3};
+    const auto registers = {1, 0, 1, 0, 1};
+    std::copy(delays.begin(), delays.end(), cost.begin());
+    std::copy(registers.begin(), registers.end(), time.begin());
+
+    const auto result = py::min_cycle_ratio(G, cost, time);
+    REQUIRE(result.has_value());
+    CHECK_EQ(result->ratio, Ratio(7, 2));
+    CHECK_EQ(result->cycle, std::vector<std::size_t>{0, 1, 2});
+
+    // A combinational loop (of negative cost) takes no time
+    time[0] = 0;
+    time[2] = 0;
+    cost[1] = -10;
+    CHECK_THROWS_AS(py::min_cycle_ratio(G, cost, time), std::invalid_argument);
+    time[0] = 1;
+    cost[4] = std::int64_t{1} << 40;
+    CHECK_THROWS_AS(py::min_cycle_ratio(G, cost, time), std::out_of_range);
+
+    // Acyclic
+    const auto dag = py::CsrGraph<>(3, Edges{{0, 1}, {1, 2}});
+    const auto none = std::vector<std::int64_t>{1, 1};
+    CHECK(!py::min_cycle_ratio(dag, none, none).has_value());
+}
+
+TEST_CASE("Test WideInt arithmetic") {
+    using py::detail::WideInt;
+    constexpr auto big = std::int64_t{0x7fffffffffffffff};
+    CHECK(WideInt::product(big, big) == WideInt::product(-big, -big));
+    CHECK(WideInt::product(big, -big) < WideInt::product(-1, big));
+    CHECK(WideInt::product(-3, 5) == WideInt{-15});
+    CHECK(WideInt{-1} + WideInt{1} == WideInt{});
+    CHECK(WideInt{0} - WideInt::product(big, 4) < WideInt{-big});
+#if defined(__SIZEOF_INT128__)
+    __extension__ using Int128 = __int128;
+    const auto as_int128 = [](const WideInt& x) {
+        return static_cast<Int128>(x.hi) * (Int128{1} << 64) + static_cast<Int128>(x.lo);
+    };
+    const auto values = std::vector<std::int64_t>{0, 1, -1, 12345, -987654321, big, -big - 1};
+    for (const auto a : values) {
+        for (const auto b : values) {
+            CHECK(as_int128(WideInt::product(a, b)) == static_cast<Int128>(a) * b);
+            CHECK(as_int128(WideInt::product(a, b) - b) == static_cast<Int128>(a) * b - b);
+        }
+    }
+#endif
+}
+
+TEST_CASE("Test MinCycleRatioSolver rejects too many vertices") {
+    const auto n = py::MinCycleRatioSolver<>::max_vertices + 1;
+    const auto gra = py::CsrGraph<>(n, Edges{{0, 1}, {1, 0}});
+    const auto one = std::vector<std::int64_t>{1, 1};
+    CHECK_THROWS_AS(py::min_cycle_ratio(gra, one, one), std::out_of_range);
+}
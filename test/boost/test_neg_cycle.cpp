@@ -0,0 +1,132 @@
+#include <doctest/doctest.h>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/fractions.hpp>
+#include <py2cpp/neg_cycle.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lcg.hpp"
+
+using Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+// Every cycle is closed and negative
+template <typename Weight, typename Vertex>
+static void check_cycles(const py::NegCycleFinder<Weight, Vertex>& finder,
+                         const std::vector<std::vector<std::size_t>>& cycles,
+                         const std::vector<Weight>& weight) {
+    for (const auto& cycle : cycles) {
+        REQUIRE(!cycle.empty());
+        auto total = Weight{};
+        for (auto i = std::size_t{0}; i != cycle.size(); ++i) {
+            const auto next = cycle[(i + 1) % cycle.size()];
+            CHECK_EQ(finder.target(cycle[i]), finder.source(next));
+            total = total + weight[cycle[i]];
+        }
+        CHECK(total < Weight{});
+    }
+}
+
+// dist[v] <= dist[u] + w(u, v) for every edge
+template <typename Weight, typename Vertex>
+static auto feasible(const py::NegCycleFinder<Weight, Vertex>& finder,
+                     const std::vector<Weight>& dist, const std::vector<Weight>& weight) -> bool {
+    for (auto id = std::size_t{0}; id != finder.num_edge_ids(); ++id) {
+        if (dist[finder.source(id)] + weight[id] < dist[finder.target(id)]) return false;
+    }
+    return true;
+}
+
+TEST_CASE("Test NegCycleFinder with Fraction weights and warm starts") {
+    using Fraction = fun::Fraction<std::int64_t>;
+    using Index = boost::property<boost::edge_index_t, std::size_t>;
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                        boost::no_property, Index>;
+    auto G = py::GrAdaptor<Graph>(Graph(4));
+    G.add_edges_from(std::vector<std::pair<int, int>>{{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 1}});
+    auto weight = G.edge_data().add_column<Fraction>("weight");
+    weight[0] = Fraction(1, 3);
+    weight[1] = Fraction(1, 3);
+    weight[2] = Fraction(-2, 3);  // 0 -> 1 -> 2 -> 0 weighs exactly 0
+    weight[3] = Fraction(1, 2);
+    weight[4] = Fraction(1, 2);
+
+    auto finder = py::NegCycleFinder<Fraction, std::size_t>(G);
+    auto dist = std::vector<Fraction>(4);
+    CHECK(finder.howard(dist, weight).empty());
+    auto copy = std::vector<Fraction>(weight.begin(), weight.end());
+    CHECK(feasible(finder, dist, copy));
+
+    // 1 -> 2 -> 3 -> 1 turns negative
+    weight[4] = Fraction(-6, 7);
+    copy.assign(weight.begin(), weight.end());
+    auto cycles = finder.howard(dist, weight);
+    REQUIRE_EQ(cycles.size(), 1);
+    CHECK_EQ(cycles[0].size(), 3);
+    check_cycles(finder, cycles, copy);
+
+    // Back to non-negative: the warm start from the previous distances ends feasible
+    weight[4] = Fraction(-5, 6);
+    copy.assign(weight.begin(), weight.end());
+    CHECK(finder.howard(dist, weight).empty());
+    CHECK(feasible(finder, dist, copy));
+
+    // Warm start from the changed edges only
+    weight[1] = Fraction(0);
+    copy.assign(weight.begin(), weight.end());
+    cycles = finder.howard(dist, weight, std::vector<std::size_t>{1});
+    REQUIRE_EQ(cycles.size(), 1);
+    check_cycles(finder, cycles, copy);
+    dist.assign(4, Fraction{});
+    weight[1] = Fraction(1, 3);
+    copy.assign(weight.begin(), weight.end());
+    CHECK(finder.howard(dist, weight).empty());
+    for (const auto w : {Fraction(1), Fraction(3, 4)}) {  // 1 -> 2 -> 3 -> 1 stays positive
+        weight[3] = w;
+        copy.assign(weight.begin(), weight.end());
+        CHECK(finder.howard(dist, weight, std::vector<std::size_t>{3}).empty());
+        CHECK(feasible(finder, dist, copy));
+    }
+
+    CHECK_THROWS_AS(finder.howard(std::span<Fraction>(dist).first(2), weight),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Test NegCycleFinder sequential and parallel agree") {
+    constexpr auto n = std::size_t{300};
+    auto edges = Edges{};
+    auto random = Lcg{5};
+    for (auto i = std::size_t{0}; i != 4 * n; ++i) {
+        const auto u = random(n);
+        edges.emplace_back(u, random(n));
+    }
+    const auto gra = py::CsrGraph<>(n, edges);
+    py::ThreadPool pool{4};
+    auto sequential = py::NegCycleFinder<long>(gra);
+    auto parallel = py::NegCycleFinder<long>(pool, gra);
+
+    for (const auto shift : {0L, 5L, 20L, 40L}) {
+        auto weight = std::vector<long>(edges.size());
+        for (auto& w : weight) {
+            w = static_cast<long>(random(100)) - shift;
+        }
+        auto dist1 = std::vector<long>(n);
+        auto dist2 = std::vector<long>(n);
+        const auto cycles1 = sequential.howard(dist1, weight);
+        const auto cycles2 = parallel.howard(dist2, weight);
+        CHECK_EQ(cycles1.empty(), cycles2.empty());
+        check_cycles(sequential, cycles1, weight);
+        check_cycles(parallel, cycles2, weight);
+        if (cycles1.empty()) {
+            CHECK(feasible(sequential, dist1, weight));
+            CHECK_EQ(dist1, dist2);  // both are the shortest distances from a virtual source
+        }
+    }
+}
@@ -1,7 +1,12 @@
 #include <doctest/doctest.h>
 
 #include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
 #include <py2cpp/nx2bgl.hpp>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 TEST_CASE("Test GrAdaptor") {
     using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS>;
@@ -66,3 +71,105 @@ TEST_CASE("Test AtlasView") {
     }
     CHECK_EQ(count, 3);
 }
+
+TEST_CASE("Test GrAdaptor add_nodes_from") {
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS>;
+    auto G = py::GrAdaptor<Graph>(Graph(2));
+    G.add_nodes_from(std::vector<int>{0, 4, 3});
+    CHECK_EQ(G.number_of_nodes(), 5);
+    G.add_nodes_from(std::vector<int>{1});
+    CHECK_EQ(G.number_of_nodes(), 5);
+    CHECK_THROWS_AS(G.add_nodes_from(std::vector<int>{-1}), std::out_of_range);
+}
+
+TEST_CASE("Test GrAdaptor add_edges_from") {
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS>;
+    auto G = py::GrAdaptor<Graph>(Graph(1));
+    G.add_edges_from(std::vector<std::pair<int, int>>{{0, 1}, {0, 2}, {3, 0}, {0, 3}});
+    CHECK_EQ(G.number_of_nodes(), 4);
+    CHECK_EQ(G.number_of_edges(), 4);
+
+    auto targets = std::vector<std::size_t>{};
+    for (auto e : G.neighbors(0)) {
+        targets.push_back(G.target(e));
+    }
+    CHECK_EQ(targets, std::vector<std::size_t>{1, 2, 3});
+    CHECK_EQ(G.out_edge_list(0).capacity(), 3);
+}
+
+TEST_CASE("Test GrAdaptor add_edges_from with properties") {
+    using Weight = boost::property<boost::edge_weight_t, int>;
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS,
+                                        boost::no_property, Weight>;
+    auto G = py::GrAdaptor<Graph>(Graph(0));
+    G.add_edges_from(std::vector<std::tuple<int, int, int>>{{0, 1, 5}, {1, 2, 7}});
+    CHECK_EQ(G.number_of_nodes(), 3);
+    CHECK_EQ(G.number_of_edges(), 2);
+    const auto weight = boost::get(boost::edge_weight, G);
+    auto total = 0;
+    for (auto e : G.edges()) {
+        total += weight[e];
+    }
+    CHECK_EQ(total, 12);
+}
+
+TEST_CASE("Test GrAdaptor adjacent_nodes") {
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS>;
+    auto G = py::GrAdaptor<Graph>(Graph(4));
+    G.add_edges_from(std::vector<std::pair<int, int>>{{0, 3}, {0, 1}, {2, 0}});
+    auto nodes = std::vector<std::size_t>{};
+    for (auto v : G.adjacent_nodes(0)) {
+        nodes.push_back(v);
+    }
+    CHECK_EQ(nodes, std::vector<std::size_t>{3, 1});
+    CHECK(G.adjacent_nodes(3).begin() == G.adjacent_nodes(3).end());
+}
+
+TEST_CASE("Test GrAdaptor node and edge attributes") {
+    using Index = boost::property<boost::edge_index_t, std::size_t>;
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                        boost::no_property, Index>;
+    auto G = py::GrAdaptor<Graph>(Graph(2));
+    G.node_data().add_column<double>("weight", 1.0);
+    G.add_edge(0, 1);
+    G.add_edges_from(std::vector<std::pair<int, int>>{{1, 2}, {2, 0}});
+
+    // Columns follow the graph as it grows
+    CHECK_EQ(std::as_const(G).node_data().size(), 3);
+    CHECK_EQ(std::as_const(G).edge_data().size(), 3);
+    G.node_attr<double>(2, "weight") = 3.0;
+    const auto weight = G.node_data().column<double>("weight");
+    CHECK_EQ(std::vector<double>(weight.begin(), weight.end()), std::vector<double>{1, 1, 3});
+
+    G.edge_data().add_column<int>("cost");
+    for (auto e : G.edges()) {
+        G.edge_attr<int>(e, "cost") = static_cast<int>(10 * G.source(e) + G.target(e));
+    }
+    CHECK_EQ(G.edge_id(boost::edge(2, 0, G).first), 2);
+    CHECK_EQ(G.edge_attr<int>(1, 2, "cost"), 12);
+    const auto cost = G.edge_data().column<int>("cost");
+    CHECK_EQ(std::vector<int>(cost.begin(), cost.end()), std::vector<int>{1, 12, 20});
+    CHECK_THROWS_AS(G.edge_attr<int>(0, 2, "cost"), std::out_of_range);
+    CHECK_THROWS_AS(G.node_attr<int>(0, "weight"), std::invalid_argument);
+}
+
+TEST_CASE("Test GrAdaptor numbers the edges of a wrapped graph") {
+    using Index = boost::property<boost::edge_index_t, std::size_t>;
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                        boost::no_property, Index>;
+    const auto edges = std::vector<std::pair<int, int>>{{0, 1}, {1, 2}, {2, 0}};
+    auto G = py::GrAdaptor<Graph>(Graph(edges.begin(), edges.end(), 3));
+    auto ids = std::vector<std::size_t>{};
+    for (auto e : G.edges()) ids.push_back(G.edge_id(e));
+    CHECK_EQ(ids, std::vector<std::size_t>{0, 1, 2});
+    const auto [e, added] = G.add_edge(0, 2);
+    REQUIRE(added);
+    CHECK_EQ(G.edge_id(e), 3);
+
+    G.edge_data().add_column<int>("cost");
+    for (auto f : G.edges()) {
+        G.edge_attr<int>(f, "cost") = static_cast<int>(10 * G.source(f) + G.target(f));
+    }
+    CHECK_EQ(G.edge_attr<int>(1, 2, "cost"), 12);
+    CHECK_EQ(G.edge_attr<int>(2, 0, "cost"), 20);
+}
@@ -0,0 +1,135 @@
+#include <doctest/doctest.h>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/property_map/function_property_map.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/pagerank.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "lcg.hpp"
+
+using Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+// Plain power iteration of PageRank, teleporting to `teleport` (NetworkX semantics)
+static auto reference_pagerank(std::size_t n, const Edges& edges,
+                               const std::vector<double>& teleport) -> std::vector<double> {
+    auto out_degree = std::vector<double>(n);
+    for (const auto& [u, v] : edges) out_degree[u] += 1.0;
+    auto x = std::vector<double>(n, 1.0 / static_cast<double>(n));
+    for (auto iter = 0; iter != 1000; ++iter) {
+        auto dangling = 0.0;
+        for (auto v = std::size_t{0}; v != n; ++v) {
+            if (out_degree[v] == 0.0) dangling += x[v];
+        }
+        auto next = std::vector<double>(n);
+        for (const auto& [u, v] : edges) next[v] += 0.85 * x[u] / out_degree[u];
+        for (auto v = std::size_t{0}; v != n; ++v) {
+            next[v] += (0.85 * dangling + 0.15) * teleport[v];
+        }
+        x = next;
+    }
+    return x;
+}
+
+// Random graph with a few dangling vertices, sorted by source
+static auto random_edges(std::size_t n, std::size_t m) -> Edges {
+    auto edges = Edges{};
+    auto random = Lcg{7};
+    while (edges.size() != m) {
+        const auto u = random(n);
+        if (u % 10 != 0) edges.emplace_back(u, random(n));
+    }
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+TEST_CASE("Test pagerank") {
+    constexpr auto n = std::size_t{300};
+    const auto edges = random_edges(n, 2000);
+    const auto expected = reference_pagerank(n, edges, std::vector<double>(n, 1.0 / n));
+    for (const auto threads : {1U, 4U}) {
+        py::ThreadPool pool{threads};
+        const auto gra = py::CsrGraph<>(n, edges);
+        const auto rank = py::pagerank(pool, gra, 0.85, 100, 1.0e-10);
+        REQUIRE_EQ(rank.size(), n);
+        auto total = 0.0;
+        for (auto v = std::size_t{0}; v != n; ++v) {
+            CHECK(std::abs(rank[v] - expected[v]) < 1.0e-9);
+            total += rank[v];
+        }
+        CHECK(std::abs(total - 1.0) < 1.0e-9);
+    }
+
+    // Weights on a BGL graph and on a GrAdaptor: doubling an edge counts it twice
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                        boost::no_property,
+                                        boost::property<boost::edge_index_t, std::size_t>>;
+    auto G = py::GrAdaptor<Graph>(Graph(3));
+    G.add_edges_from(std::vector<std::pair<int, int>>{{0, 1}, {0, 2}, {1, 2}, {2, 0}});
+    auto weight = G.edge_data().add_column<double>("weight");
+    weight[0] = 2.0;
+    weight[1] = weight[2] = weight[3] = 1.0;
+    py::ThreadPool pool{2};
+    const auto rank = py::pagerank<double>(pool, G, "weight", 0.85, 100, 1.0e-12);
+    const auto doubled = Edges{{0, 1}, {0, 1}, {0, 2}, {1, 2}, {2, 0}};
+    const auto expected3 = reference_pagerank(3, doubled, std::vector<double>(3, 1.0 / 3));
+    for (auto v = std::size_t{0}; v != 3; ++v) CHECK(std::abs(rank[v] - expected3[v]) < 1.0e-9);
+    const auto by_map = py::pagerank(pool, static_cast<const Graph&>(G),
+                                     boost::make_function_property_map<
+                                         boost::graph_traits<Graph>::edge_descriptor>(
+                                         [&](const auto& e) { return weight[G.edge_id(e)]; }),
+                                     0.85, 100, 1.0e-12);
+    CHECK_EQ(by_map, rank);
+
+    weight[3] = -1.0;
+    CHECK_THROWS_AS((void)py::pagerank<double>(pool, G, "weight"), std::invalid_argument);
+    CHECK_THROWS_AS((void)py::pagerank(pool, py::CsrGraph<>(n, edges), 0.85, 2),
+                    std::runtime_error);
+}
+
+TEST_CASE("Test personalized_pagerank") {
+    constexpr auto n = std::size_t{200};
+    const auto edges = random_edges(n, 1000);
+    const auto gra = py::CsrGraph<>(n, edges);
+    const auto seeds = std::vector<std::uint32_t>{0, 5, 17, 5, 199};
+    py::ThreadPool pool{3};
+    const auto ranks = py::personalized_pagerank(pool, gra, std::span(seeds), 0.85, 200, 1.0e-12);
+    REQUIRE_EQ(ranks.size(), seeds.size());
+    for (auto b = std::size_t{0}; b != seeds.size(); ++b) {
+        auto teleport = std::vector<double>(n);
+        teleport[seeds[b]] = 1.0;
+        const auto expected = reference_pagerank(n, edges, teleport);
+        for (auto v = std::size_t{0}; v != n; ++v) {
+            CHECK(std::abs(ranks[b][v] - expected[v]) < 1.0e-9);
+        }
+    }
+    CHECK_EQ(ranks[1], ranks[3]);
+
+    const auto bad = std::vector<std::uint32_t>{200};
+    CHECK_THROWS_AS((void)py::personalized_pagerank(pool, gra, std::span(bad)), std::out_of_range);
+}
+
+TEST_CASE("Test katz_centrality") {
+    // Directed path 0 -> 1 -> 2: x = (1, 1 + a, 1 + a + a^2) before normalization
+    const auto gra = py::CsrGraph<>(3, Edges{{0, 1}, {1, 2}});
+    py::ThreadPool pool{2};
+    const auto raw = py::katz_centrality(pool, gra, 0.5, 1.0, 1000, 1.0e-9, false);
+    CHECK(std::abs(raw[0] - 1.0) < 1.0e-9);
+    CHECK(std::abs(raw[1] - 1.5) < 1.0e-9);
+    CHECK(std::abs(raw[2] - 1.75) < 1.0e-9);
+    const auto katz = py::katz_centrality(pool, gra, 0.5);
+    const auto norm = std::sqrt(1.0 + 1.5 * 1.5 + 1.75 * 1.75);
+    CHECK(std::abs(katz[2] - 1.75 / norm) < 1.0e-9);
+
+    // A cycle diverges when alpha exceeds the inverse of the largest eigenvalue
+    const auto cycle = py::CsrGraph<>(2, Edges{{0, 1}, {1, 0}});
+    CHECK_THROWS_AS((void)py::katz_centrality(pool, cycle, 1.5), std::runtime_error);
+}
@@ -0,0 +1,128 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/reorder.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lcg.hpp"
+
+using Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+// Largest id difference along an edge
+template <typename Graph> static auto bandwidth(const Graph& gra) -> std::size_t {
+    const auto offsets = gra.row_offsets();
+    const auto targets = gra.column_indices();
+    auto result = std::size_t{0};
+    for (auto u = std::size_t{0}; u + 1 < offsets.size(); ++u) {
+        for (auto k = offsets[u]; k != offsets[u + 1]; ++k) {
+            const auto v = static_cast<std::size_t>(targets[k]);
+            result = std::max(result, u > v ? u - v : v - u);
+        }
+    }
+    return result;
+}
+
+// A 30 x 30 grid stored in both directions, with shuffled vertex ids
+static auto shuffled_grid() -> py::CsrGraph<> {
+    constexpr auto side = std::uint32_t{30};
+    auto id = std::vector<std::uint32_t>(side * side);
+    for (auto v = std::uint32_t{0}; v != id.size(); ++v) id[v] = v;
+    auto random = Lcg{5};
+    for (auto i = id.size() - 1; i != 0; --i) std::swap(id[i], id[random(i + 1)]);
+    auto edges = Edges{};
+    for (auto r = std::uint32_t{0}; r != side; ++r) {
+        for (auto c = std::uint32_t{0}; c != side; ++c) {
+            const auto v = id[r * side + c];
+            if (c + 1 != side) edges.emplace_back(v, id[r * side + c + 1]);
+            if (r + 1 != side) edges.emplace_back(v, id[(r + 1) * side + c]);
+        }
+    }
+    const auto size = edges.size();
+    for (auto i = std::size_t{0}; i != size; ++i) {
+        edges.emplace_back(edges[i].second, edges[i].first);
+    }
+    return {side * side, edges};
+}
+
+TEST_CASE("Test reverse_cuthill_mckee_ordering") {
+    const auto gra = shuffled_grid();
+    const auto perm = py::reverse_cuthill_mckee_ordering(gra);
+    REQUIRE_EQ(perm.size(), num_vertices(gra));
+    for (auto v = std::uint32_t{0}; v != perm.size(); ++v) {
+        CHECK_EQ(perm.old_id[perm.new_id[v]], v);
+    }
+    const auto relabeled = py::relabel_nodes(gra, perm);
+    CHECK_EQ(num_edges(relabeled), num_edges(gra));
+    CHECK_GT(bandwidth(gra), 800);
+    // Level sets of a grid from a corner are diagonals of at most 30 vertices
+    CHECK_LE(bandwidth(relabeled), 60);
+
+    // Components one after another; isolated vertices too
+    const auto forest = py::CsrGraph<>(5, Edges{{3, 1}, {1, 3}});
+    const auto order = py::reverse_cuthill_mckee_ordering(forest).old_id;
+    const auto one = std::find(order.begin(), order.end(), 1U) - order.begin();
+    const auto three = std::find(order.begin(), order.end(), 3U) - order.begin();
+    CHECK_EQ(std::abs(one - three), 1);
+}
+
+TEST_CASE("Test degree_ordering and bfs_ordering") {
+    // 0 -> 1 -> 2, 0 -> 3, 4 -> 0, 4 -> 1, 4 -> 2
+    const auto gra = py::CsrGraph<>(5, Edges{{0, 1}, {1, 2}, {0, 3}, {4, 0}, {4, 1}, {4, 2}});
+    CHECK_EQ(py::degree_ordering(gra).old_id, std::vector<std::uint32_t>{4, 0, 1, 2, 3});
+    const auto bfs = py::bfs_ordering(gra);
+    CHECK_EQ(bfs.old_id, std::vector<std::uint32_t>{0, 1, 3, 2, 4});
+    CHECK_EQ(bfs.new_id, std::vector<std::uint32_t>{0, 1, 3, 2, 4});
+
+    CHECK_THROWS_AS(py::Permutation<>::from_order({0, 0, 1}), std::invalid_argument);
+    CHECK_THROWS_AS(py::relabel_nodes(gra, py::Permutation<>::from_order({1, 0})),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Test relabel_nodes on GrAdaptor with attributes") {
+    using Index = boost::property<boost::edge_index_t, std::size_t>;
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS,
+                                        boost::no_property, Index>;
+    auto G = py::GrAdaptor<Graph>(Graph(4));
+    G.add_edges_from(std::vector<std::pair<int, int>>{{0, 1}, {1, 2}, {2, 3}, {3, 0}});
+    auto label = G.node_data().add_column<int>("label");
+    auto weight = G.edge_data().add_column<double>("weight");
+    for (auto v = 0; v != 4; ++v) label[static_cast<std::size_t>(v)] = 10 * v;
+    for (auto i = 0; i != 4; ++i) weight[static_cast<std::size_t>(i)] = 0.5 + i;
+
+    const auto perm = py::Permutation<std::size_t>::from_order({2, 0, 3, 1});
+    auto H = py::relabel_nodes(G, perm);
+    CHECK_EQ(H.number_of_nodes(), 4);
+    CHECK_EQ(H.number_of_edges(), 4);
+    for (auto v = std::size_t{0}; v != 4; ++v) {
+        CHECK_EQ(H.node_attr<int>(perm.new_id[v], "label"), label[v]);
+    }
+    for (const auto& e : G.edges()) {
+        const auto u = perm.new_id[G.source(e)];
+        const auto v = perm.new_id[G.target(e)];
+        CHECK_EQ(H.edge_attr<double>(u, v, "weight"), weight[G.edge_id(e)]);
+    }
+    // Edge ids are numbered by the smaller new end
+    auto ids = std::vector<std::size_t>{};
+    for (const auto& e : H.edges()) ids.push_back(H.edge_id(e));
+    std::sort(ids.begin(), ids.end());
+    CHECK_EQ(ids, std::vector<std::size_t>{0, 1, 2, 3});
+
+    // A CsrGraph inside the adaptor, with an edge column
+    auto C = py::GrAdaptor<py::CsrGraph<>>(py::CsrGraph<>(3, Edges{{2, 0}, {0, 1}, {2, 1}}));
+    auto cost = C.edge_data().add_column<int>("cost");
+    cost[0] = 1;  // (0, 1)
+    cost[1] = 2;  // (2, 0)
+    cost[2] = 3;  // (2, 1)
+    const auto D = py::relabel_nodes(C, py::Permutation<>::from_order({2, 1, 0}));
+    CHECK_EQ(D.edge_data().column<int>("cost")[0], 2);  // (0, 2)
+    CHECK_EQ(D.edge_data().column<int>("cost")[1], 3);  // (0, 1)
+    CHECK_EQ(D.edge_data().column<int>("cost")[2], 1);  // (2, 1)
+}
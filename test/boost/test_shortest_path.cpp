@@ -0,0 +1,143 @@
+#include <doctest/doctest.h>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/fractions.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/shortest_path.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lcg.hpp"
+
+using Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+static auto random_edges(std::size_t n, std::size_t m, std::vector<int>& weight) -> Edges {
+    auto edges = Edges{};
+    auto random = Lcg{11};
+    for (auto i = std::size_t{0}; i != m; ++i) {
+        const auto u = random(n);
+        edges.emplace_back(u, random(n));
+        weight.push_back(static_cast<int>(random(100)));
+    }
+    return edges;
+}
+
+// Every reached vertex but the source has a tight edge from its predecessor
+template <typename Weight, typename Vertex>
+static void check_tree(const py::CsrGraph<Weight, Vertex>& gra,
+                       const py::ShortestPaths<Weight, Vertex>& sp, Vertex source) {
+    CHECK_EQ(sp.predecessor[source], source);
+    for (auto v = Vertex{0}; v != num_vertices(gra); ++v) {
+        if (v == source || !sp.reached(v)) continue;
+        const auto u = sp.predecessor[v];
+        auto tight = false;
+        for (auto [ei, eend] = out_edges(u, gra); ei != eend; ++ei) {
+            tight = tight || (target(*ei, gra) == v && sp.distance[u] + gra[*ei] == sp.distance[v]);
+        }
+        CHECK(tight);
+    }
+}
+
+TEST_CASE("Test RadixHeap") {
+    auto heap = py::RadixHeap<std::uint32_t, int>{};
+    for (const auto key : {5U, 3U, 9U, 3U, 1000U}) {
+        heap.push(key, static_cast<int>(key));
+    }
+    auto popped = std::vector<std::uint32_t>{};
+    while (!heap.empty()) {
+        const auto [key, value] = heap.pop();
+        popped.push_back(key);
+        if (key == 5) heap.push(7, 7);  // monotone: not below the last key
+    }
+    CHECK_EQ(popped, std::vector<std::uint32_t>{3, 3, 5, 7, 9, 1000});
+}
+
+TEST_CASE("Test single_source_dijkstra against BGL") {
+    using Weight = boost::property<boost::edge_weight_t, int>;
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                        boost::no_property, Weight>;
+    constexpr auto n = std::size_t{2000};
+    auto weight = std::vector<int>{};
+    const auto edges = random_edges(n, 8 * n, weight);
+    const auto gra = Graph(edges.begin(), edges.end(), weight.begin(), n);
+    auto expected = std::vector<int>(n);
+    boost::dijkstra_shortest_paths(gra, 0, boost::distance_map(expected.data()));
+
+    const auto csr = py::CsrGraph<int>(n, edges, weight);
+    const auto sequential = py::single_source_dijkstra(csr, 0);
+    py::ThreadPool pool{4};
+    for (const auto& sp : {sequential, py::single_source_dijkstra(pool, csr, 0, 1),
+                           py::single_source_dijkstra(pool, csr, 0, 30),
+                           py::single_source_dijkstra(pool, csr, 0, 1000)}) {
+        for (auto v = std::uint32_t{0}; v != n; ++v) {
+            if (sp.reached(v)) {
+                CHECK_EQ(sp.distance[v], expected[v]);
+            } else {
+                CHECK_EQ(expected[v], std::numeric_limits<int>::max());
+            }
+        }
+        check_tree(csr, sp, 0U);
+    }
+
+    // Any BGL graph with a weight map
+    const auto from_map = py::single_source_dijkstra(gra, 0, boost::get(boost::edge_weight, gra));
+    CHECK_EQ(from_map.distance, sequential.distance);
+    CHECK_EQ(py::single_source_dijkstra(pool, gra, 0, boost::get(boost::edge_weight, gra), 25)
+                 .distance,
+             sequential.distance);
+}
+
+TEST_CASE("Test single_source_dijkstra with Fraction weights") {
+    using Fraction = fun::Fraction<std::int64_t>;
+    using Csr = py::CsrGraph<Fraction>;
+    // 0 -> 1 -> 2 -> 3 in thirds beats 0 -> 3 at 1 + 1/100; 4 is unreachable
+    const auto third = Fraction(1, 3);
+    const auto gra = Csr(5, Edges{{0, 1}, {1, 2}, {2, 3}, {0, 3}, {3, 2}, {4, 0}},
+                         std::vector<Fraction>{third, third, third, Fraction(101, 100),
+                                               Fraction(1, 7), Fraction(1, 2)});
+    py::ThreadPool pool{2};
+    for (const auto& sp : {py::single_source_dijkstra(gra, 0),
+                           py::single_source_dijkstra(pool, gra, 0, Fraction(1, 4))}) {
+        CHECK_EQ(sp.distance[2], Fraction(2, 3));
+        CHECK_EQ(sp.distance[3], Fraction(1, 1));
+        CHECK_EQ(sp.path(3), std::vector<std::uint32_t>{0, 1, 2, 3});
+        CHECK(!sp.reached(4));
+        CHECK(sp.path(4).empty());
+        check_tree(gra, sp, 0U);
+    }
+}
+
+TEST_CASE("Test single_source_dijkstra over GrAdaptor attributes") {
+    using Index = boost::property<boost::edge_index_t, std::size_t>;
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                        boost::no_property, Index>;
+    auto G = py::GrAdaptor<Graph>(Graph(4));
+    G.add_edges_from(std::vector<std::pair<int, int>>{{0, 1}, {1, 2}, {0, 2}, {2, 3}});
+    auto cost = G.edge_data().add_column<long>("cost");
+    cost[0] = 2;
+    cost[1] = 2;
+    cost[2] = 5;
+    cost[3] = 1;
+
+    const auto sp = py::single_source_dijkstra<long>(G, 0, "cost");
+    CHECK_EQ(sp.distance, std::vector<long>{0, 2, 4, 5});
+    CHECK_EQ(sp.path(3), std::vector<std::size_t>{0, 1, 2, 3});
+    py::ThreadPool pool{2};
+    CHECK_EQ(py::single_source_dijkstra<long>(pool, G, 0, "cost", 3L).distance, sp.distance);
+
+    CHECK_THROWS_AS(py::single_source_dijkstra<long>(G, 0, "length"), std::out_of_range);
+    CHECK_THROWS_AS(py::single_source_dijkstra<long>(G, 9, "cost"), std::out_of_range);
+    cost[3] = -1;
+    CHECK_THROWS_AS(py::single_source_dijkstra<long>(G, 0, "cost"), std::invalid_argument);
+    CHECK_THROWS_AS(py::single_source_dijkstra<long>(pool, G, 0, "cost", 3L),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(py::single_source_dijkstra<long>(pool, G, 0, "cost", 0L),
+                    std::invalid_argument);
+}
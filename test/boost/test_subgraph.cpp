@@ -0,0 +1,117 @@
+#include <doctest/doctest.h>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/connected_components.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/csr_graph.hpp>
+#include <py2cpp/nx2bgl.hpp>
+#include <py2cpp/subgraph.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using Index = boost::property<boost::edge_index_t, std::size_t>;
+using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS,
+                                    boost::no_property, Index>;
+
+// The cycle 0 - 1 - 2 - 3 - 4 - 5 - 0 with the chord 0 - 3
+static auto hexagon() -> py::GrAdaptor<Graph> {
+    auto G = py::GrAdaptor<Graph>(Graph(6));
+    G.add_edges_from(
+        std::vector<std::pair<int, int>>{{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 0}, {0, 3}});
+    auto label = G.node_data().add_column<int>("label");
+    auto weight = G.edge_data().add_column<int>("weight");
+    for (auto v = std::size_t{0}; v != 6; ++v) label[v] = static_cast<int>(10 * v);
+    for (auto i = std::size_t{0}; i != 7; ++i) weight[i] = static_cast<int>(i) + 1;
+    return G;
+}
+
+TEST_CASE("Test subgraph induced by nodes") {
+    const auto G = hexagon();
+    const auto H = py::subgraph(G, std::vector<int>{0, 1, 2, 3, 42});
+    CHECK_EQ(H.number_of_nodes(), 4);
+    CHECK_EQ(H.number_of_edges(), 4);  // 0-1, 1-2, 2-3, 0-3
+    CHECK(H.has_node(2));
+    CHECK_FALSE(H.has_node(4));
+    CHECK_FALSE(H.has_node(42));
+
+    auto nodes = std::vector<std::size_t>{};
+    for (const auto v : H) nodes.push_back(v);
+    CHECK_EQ(nodes, std::vector<std::size_t>{0, 1, 2, 3});
+    auto neighbours = std::vector<std::size_t>{};
+    for (const auto v : H.adjacent_nodes(0)) neighbours.push_back(v);
+    CHECK_EQ(neighbours, std::vector<std::size_t>{1, 3});
+    auto count = 0;
+    for (const auto& e : H.neighbors(3)) {
+        CHECK_EQ(H.source(e), 3);
+        ++count;
+    }
+    CHECK_EQ(count, 2);
+
+    // Attributes are read from the graph
+    CHECK_EQ(H.node_attr<int>(2, "label"), 20);
+    auto total = 0;
+    for (const auto& e : H.edges()) total += H.edge_attr<int>(e, "weight");
+    CHECK_EQ(total, 1 + 2 + 3 + 7);
+
+    // A BGL algorithm on the view: removing 0 and 3 splits the rest in two
+    const auto K = py::subgraph(G, std::vector<int>{1, 2, 4, 5});
+    auto component = std::vector<int>(6);
+    CHECK_EQ(boost::connected_components(K, component.data()), 2);
+    CHECK_EQ(component[1], component[2]);
+    CHECK_NE(component[2], component[4]);
+}
+
+TEST_CASE("Test edge_subgraph and subgraph_view") {
+    const auto G = hexagon();
+    const auto weight = G.edge_data().column<int>("weight");
+    // Edges of odd weight: 0-1, 2-3, 4-5, 0-3
+    const auto odd = [&](const auto& e) { return weight[G.edge_id(e)] % 2 == 1; };
+    const auto H = py::edge_subgraph(G, odd);
+    CHECK_EQ(H.number_of_nodes(), 6);
+    CHECK_EQ(H.number_of_edges(), 4);
+
+    const auto K = py::subgraph_view(
+        G, [](std::size_t v) { return v != 0; },
+        [&](const auto& e) { return weight[G.edge_id(e)] <= 4; });
+    CHECK_EQ(K.number_of_nodes(), 5);
+    CHECK_EQ(K.number_of_edges(), 3);  // 1-2, 2-3, 3-4
+}
+
+TEST_CASE("Test SubgraphView::compact") {
+    const auto G = hexagon();
+    const auto H = py::subgraph(G, std::vector<int>{5, 0, 3, 4});
+    const auto [C, original] = H.compact();
+    CHECK_EQ(original, std::vector<std::size_t>{0, 3, 4, 5});
+    CHECK_EQ(C.number_of_nodes(), 4);
+    CHECK_EQ(C.number_of_edges(), 8);  // 0-3, 3-4, 4-5, 5-0 in both directions
+    CHECK_EQ(C.node_data().column<int>("label")[1], 30);
+    for (const auto& e : C.edges()) {
+        const auto u = original[C.source(e)];
+        const auto v = original[C.target(e)];
+        const auto [f, found] = boost::edge(u, v, G);
+        REQUIRE(found);
+        CHECK_EQ(C.edge_data().column<int>("weight")[C.edge_id(e)],
+                 G.edge_data().column<int>("weight")[G.edge_id(f)]);
+    }
+
+    // A view of a CsrGraph
+    using Edges = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+    const auto D = py::GrAdaptor<py::CsrGraph<>>(py::CsrGraph<>(4, Edges{{0, 1}, {1, 2}, {2, 3}}));
+    const auto E = py::subgraph(D, std::vector<std::uint32_t>{1, 2, 3});
+    CHECK_EQ(E.number_of_edges(), 2);
+    const auto compact = E.compact();
+    CHECK_EQ(compact.graph.number_of_edges(), 2);
+    CHECK_EQ(compact.original, std::vector<std::uint32_t>{1, 2, 3});
+}
+
+TEST_CASE("Test NodeMask bounds") {
+    auto mask = py::NodeMask(70);
+    mask.insert(69);
+    CHECK(mask.contains(69));
+    CHECK_FALSE(mask.contains(70));
+    CHECK_THROWS_AS(mask.insert(70), std::out_of_range);
+    CHECK_THROWS_AS(mask.insert(200), std::out_of_range);
+    CHECK_THROWS_AS(mask.insert(-1), std::out_of_range);
+}
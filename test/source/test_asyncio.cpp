@@ -0,0 +1,292 @@
+#if defined(__linux__)
+
+#    include <doctest/doctest.h>
+#    include <sys/socket.h>
+#    include <unistd.h>
+
+#    include <chrono>
+#    include <cstddef>
+#    include <cstdio>
+#    include <py2cpp/async_gen.hpp>
+#    include <py2cpp/asyncio.hpp>
+#    include <py2cpp/task.hpp>
+#    include <stdexcept>
+#    include <string>
+#    include <tuple>
+#    include <type_traits>
+#    include <utility>
+#    include <variant>
+#    include <vector>
+
+using namespace std::chrono_literals;
+
+py::Task<int> answer() { co_return 42; }
+
+py::Task<int> add_answers() {
+    auto a = co_await answer();
+    auto b = co_await answer();
+    co_return a + b;
+}
+
+TEST_CASE("Test Task run") {
+    CHECK_EQ(py::run(answer()), 42);
+    CHECK_EQ(py::run(add_answers()), 84);
+}
+
+py::Task<int> failing() {
+    co_await py::sleep(0ms);
+    throw std::runtime_error("task failed");
+}
+
+py::Task<std::string> catch_failure() {
+    try {
+        co_await failing();
+    } catch (const std::runtime_error& err) {
+        co_return std::string(err.what());
+    }
+    co_return std::string();
+}
+
+TEST_CASE("Test Task exceptions") {
+    CHECK_THROWS_AS(py::run(failing()), std::runtime_error);
+    CHECK_EQ(py::run(catch_failure()), "task failed");
+}
+
+TEST_CASE("Test EventLoop current without a running loop") {
+    CHECK_THROWS_AS(py::EventLoop::current(), std::runtime_error);
+}
+
+py::Task<void> sleeper(std::chrono::milliseconds delay, int id, std::vector<int>& order) {
+    co_await py::sleep(delay);
+    order.push_back(id);
+}
+
+TEST_CASE("Test gather runs tasks concurrently") {
+    auto order = std::vector<int>{};
+    auto tasks = std::vector<py::Task<void>>{};
+    tasks.push_back(sleeper(30ms, 1, order));
+    tasks.push_back(sleeper(10ms, 2, order));
+    tasks.push_back(sleeper(20ms, 3, order));
+
+    const auto start = std::chrono::steady_clock::now();
+    py::run(py::gather(std::move(tasks)));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    CHECK_EQ(order, std::vector<int>{2, 3, 1});
+    CHECK_LT(elapsed, 55ms);
+}
+
+py::Task<int> delayed_value(int value, std::chrono::milliseconds delay) {
+    co_await py::sleep(delay);
+    co_return value;
+}
+
+TEST_CASE("Test gather collects results in order") {
+    auto tasks = std::vector<py::Task<int>>{};
+    for (auto i = 0; i < 5; ++i) {
+        tasks.push_back(delayed_value(i, std::chrono::milliseconds(5 * (5 - i))));
+    }
+    CHECK_EQ(py::run(py::gather(std::move(tasks))), std::vector<int>{0, 1, 2, 3, 4});
+
+    auto order = std::vector<int>{};
+    auto [a, b, c] = py::run(py::gather(delayed_value(7, 5ms), sleeper(1ms, 0, order),
+                                        delayed_value(9, 0ms)));
+    CHECK_EQ(a, 7);
+    CHECK(std::is_same_v<decltype(b), std::monostate>);
+    CHECK_EQ(c, 9);
+    CHECK_EQ(order, std::vector<int>{0});
+}
+
+TEST_CASE("Test gather rethrows after all tasks finish") {
+    auto order = std::vector<int>{};
+    auto tasks = std::vector<py::Task<void>>{};
+    tasks.push_back(sleeper(10ms, 1, order));
+    tasks.push_back([]() -> py::Task<void> {
+        co_await py::sleep(1ms);
+        throw std::runtime_error("one task failed");
+    }());
+    CHECK_THROWS_AS(py::run(py::gather(std::move(tasks))), std::runtime_error);
+    CHECK_EQ(order, std::vector<int>{1});
+}
+
+struct Pipe {
+    int fds[2]{-1, -1};
+
+    Pipe() {
+        REQUIRE_EQ(::pipe(fds), 0);
+        py::set_nonblocking(fds[0]);
+        py::set_nonblocking(fds[1]);
+    }
+    ~Pipe() {
+        close_writer();
+        ::close(fds[0]);
+    }
+    void close_writer() {
+        if (fds[1] >= 0) ::close(std::exchange(fds[1], -1));
+    }
+};
+
+py::Task<void> write_chunks(Pipe& pipe, int chunks) {
+    for (auto i = 0; i < chunks; ++i) {
+        const auto text = std::to_string(i) + ";";
+        co_await py::async_write(pipe.fds[1], std::as_bytes(std::span{text}));
+        co_await py::sleep(1ms);
+    }
+    pipe.close_writer();
+}
+
+py::Task<std::string> read_all(int fd) {
+    auto result = std::string{};
+    std::byte buffer[64];
+    for (;;) {
+        const auto n = co_await py::async_read(fd, buffer);
+        if (n == 0) break;
+        for (auto i = std::size_t{0}; i < n; ++i) {
+            result.push_back(static_cast<char>(buffer[i]));
+        }
+    }
+    co_return result;
+}
+
+TEST_CASE("Test async pipe streaming") {
+    Pipe pipe;
+    auto [ignored, text] = py::run(py::gather(write_chunks(pipe, 4), read_all(pipe.fds[0])));
+    (void)ignored;
+    CHECK_EQ(text, "0;1;2;3;");
+}
+
+TEST_CASE("Test many concurrent streams") {
+    constexpr auto N = 100;
+    auto pipes = std::vector<Pipe>(N);
+    auto writers = std::vector<py::Task<void>>{};
+    auto readers = std::vector<py::Task<std::string>>{};
+    for (auto& pipe : pipes) {
+        writers.push_back(write_chunks(pipe, 3));
+        readers.push_back(read_all(pipe.fds[0]));
+    }
+    auto main = [&]() -> py::Task<std::vector<std::string>> {
+        auto [done, texts] = co_await py::gather(py::gather(std::move(writers)),
+                                                 py::gather(std::move(readers)));
+        (void)done;
+        co_return texts;
+    };
+    const auto texts = py::run(main());
+    REQUIRE_EQ(texts.size(), std::size_t{N});
+    for (const auto& text : texts) {
+        CHECK_EQ(text, "0;1;2;");
+    }
+}
+
+TEST_CASE("Test async socket echo") {
+    int fds[2];
+    REQUIRE_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    py::set_nonblocking(fds[0]);
+    py::set_nonblocking(fds[1]);
+
+    auto echo = [](int fd) -> py::Task<void> {
+        std::byte buffer[16];
+        const auto n = co_await py::async_read(fd, buffer);
+        co_await py::async_write(fd, std::span{buffer, n});
+    };
+    auto ask = [](int fd) -> py::Task<std::string> {
+        const auto msg = std::string("ping");
+        co_await py::async_write(fd, std::as_bytes(std::span{msg}));
+        std::byte buffer[16];
+        const auto n = co_await py::async_read(fd, buffer);
+        co_return std::string(reinterpret_cast<const char*>(buffer), n);
+    };
+    auto [ignored, reply] = py::run(py::gather(echo(fds[1]), ask(fds[0])));
+    (void)ignored;
+    CHECK_EQ(reply, "ping");
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_CASE("Test regular files are always ready") {
+    auto* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    const auto fd = ::fileno(file);
+    REQUIRE_EQ(::write(fd, "abc", 3), 3);
+    ::lseek(fd, 0, SEEK_SET);
+    CHECK_EQ(py::run(read_all(fd)), "abc");
+    std::fclose(file);
+}
+
+py::AsyncGenerator<int> ticker(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_await py::sleep(1ms);
+        co_yield i;
+    }
+}
+
+py::Task<std::vector<int>> collect_ticks(int n) {
+    auto values = std::vector<int>{};
+    auto gen = ticker(n);
+    for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) {
+        values.push_back(*it);
+    }
+    co_return values;
+}
+
+TEST_CASE("Test AsyncGenerator") {
+    CHECK_EQ(py::run(collect_ticks(4)), std::vector<int>{0, 1, 2, 3});
+    CHECK(py::run(collect_ticks(0)).empty());
+}
+
+TEST_CASE("Test AsyncGenerators interleave on one loop") {
+    auto results = py::run(py::gather(collect_ticks(3), collect_ticks(5)));
+    CHECK_EQ(std::get<0>(results), std::vector<int>{0, 1, 2});
+    CHECK_EQ(std::get<1>(results), std::vector<int>{0, 1, 2, 3, 4});
+}
+
+py::AsyncGenerator<std::string> lines(int fd) {
+    auto pending = std::string{};
+    std::byte buffer[8];
+    for (;;) {
+        const auto n = co_await py::async_read(fd, buffer);
+        if (n == 0) break;
+        for (auto i = std::size_t{0}; i < n; ++i) {
+            const auto ch = static_cast<char>(buffer[i]);
+            if (ch == ';') {
+                co_yield std::exchange(pending, {});
+            } else {
+                pending.push_back(ch);
+            }
+        }
+    }
+}
+
+py::AsyncGenerator<int> failing_ticker() {
+    co_yield 1;
+    co_await py::sleep(0ms);
+    throw std::runtime_error("stream failed");
+}
+
+TEST_CASE("Test AsyncGenerator over a pipe") {
+    Pipe pipe;
+    auto consume = [](int fd) -> py::Task<std::vector<std::string>> {
+        auto result = std::vector<std::string>{};
+        auto gen = lines(fd);
+        for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) {
+            result.push_back(std::move(*it));
+        }
+        co_return result;
+    };
+    auto [ignored, got] = py::run(py::gather(write_chunks(pipe, 3), consume(pipe.fds[0])));
+    (void)ignored;
+    CHECK_EQ(got, std::vector<std::string>{"0", "1", "2"});
+}
+
+TEST_CASE("Test AsyncGenerator rethrows exceptions") {
+    auto consume = []() -> py::Task<int> {
+        auto sum = 0;
+        auto gen = failing_ticker();
+        for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) {
+            sum += *it;
+        }
+        co_return sum;
+    };
+    CHECK_THROWS_AS(py::run(consume()), std::runtime_error);
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <py2cpp/attributes.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("Test AttributeTable columns") {
+    auto table = py::AttributeTable{3};
+    auto weight = table.add_column<double>("weight", 1.5);
+    REQUIRE_EQ(weight.size(), 3);
+    CHECK_EQ(weight[2], 1.5);
+    weight[1] = 4.0;
+    CHECK_EQ(table.at<double>(1, "weight"), 4.0);
+
+    table.add_column<std::string>("name");
+    table.at<std::string>(0, "name") = "a";
+    CHECK_EQ(table.names(), std::vector<std::string>{"name", "weight"});
+
+    // Adding again keeps the values
+    CHECK_EQ(table.add_column<double>("weight")[1], 4.0);
+
+    table.resize(5);
+    const auto& view = table;
+    CHECK_EQ(view.column<double>("weight").size(), 5);
+    CHECK_EQ(view.column<double>("weight")[4], 1.5);
+    CHECK_EQ(view.at<std::string>(0, "name"), "a");
+    CHECK_EQ(view.at<std::string>(4, "name"), "");
+}
+
+TEST_CASE("Test AttributeTable errors") {
+    auto table = py::AttributeTable{2};
+    table.add_column<int>("cost");
+    CHECK_THROWS_AS(table.column<int>("weight"), std::out_of_range);
+    CHECK_THROWS_AS(table.column<double>("cost"), std::invalid_argument);
+    CHECK_THROWS_AS(table.add_column<float>("cost"), std::invalid_argument);
+    CHECK_THROWS_AS(table.at<int>(2, "cost"), std::out_of_range);
+    CHECK(table.contains("cost"));
+    table.erase("cost");
+    CHECK_FALSE(table.contains("cost"));
+}
+
+TEST_CASE("Test AttributeTable copies are deep") {
+    auto table = py::AttributeTable{2};
+    table.add_column<std::int32_t>("flag")[0] = 1;
+    auto copy = table;
+    copy.column<std::int32_t>("flag")[0] = 2;
+    CHECK_EQ(table.column<std::int32_t>("flag")[0], 1);
+    CHECK_EQ(copy.column<std::int32_t>("flag")[0], 2);
+}
+
+TEST_CASE("Test AttributeTable take") {
+    auto table = py::AttributeTable{3};
+    auto weight = table.add_column<double>("weight", 1.0);
+    weight[0] = 10.0;
+    weight[2] = 30.0;
+    table.add_column<std::string>("name", "x")[1] = "b";
+
+    const auto rows = std::vector<std::size_t>{2, 1, 0, 1};
+    auto taken = table.take(rows);
+    CHECK_EQ(taken.size(), 4);
+    CHECK_EQ(taken.names(), table.names());
+    CHECK_EQ(taken.column<double>("weight")[0], 30.0);
+    CHECK_EQ(taken.column<double>("weight")[2], 10.0);
+    CHECK_EQ(taken.at<std::string>(3, "name"), "b");
+    // The fill value is kept
+    taken.resize(5);
+    CHECK_EQ(taken.at<std::string>(4, "name"), "x");
+
+    const auto bad = std::vector<std::size_t>{3};
+    CHECK_THROWS_AS(table.take(bad), std::out_of_range);
+}
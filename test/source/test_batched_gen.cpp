@@ -0,0 +1,136 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <numeric>
+#include <py2cpp/batched_gen.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+template <std::size_t N> py::BatchedGenerator<int, N> batched_range(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+
+TEST_CASE("Test BatchedGenerator iterate integers") {
+    auto gen = batched_range<4>(10);
+    auto count = 0;
+    for (auto val : gen) {
+        CHECK_EQ(val, count);
+        ++count;
+    }
+    CHECK_EQ(count, 10);
+}
+
+TEST_CASE("Test BatchedGenerator empty") {
+    auto gen = batched_range<4>(0);
+    CHECK(gen.begin() == gen.end());
+    auto gen2 = batched_range<4>(0);
+    auto batches = gen2.batches();
+    CHECK(batches.begin() == batches.end());
+}
+
+TEST_CASE("Test BatchedGenerator batch sizes") {
+    auto gen = batched_range<4>(10);
+    auto sizes = std::vector<std::size_t>{};
+    auto values = std::vector<int>{};
+    for (auto batch : gen.batches()) {
+        sizes.push_back(batch.size());
+        values.insert(values.end(), batch.begin(), batch.end());
+    }
+    CHECK_EQ(sizes, std::vector<std::size_t>{4, 4, 2});
+    REQUIRE_EQ(values.size(), std::size_t{10});
+    for (auto i = 0; i < 10; ++i) {
+        CHECK_EQ(values[static_cast<std::size_t>(i)], i);
+    }
+}
+
+TEST_CASE("Test BatchedGenerator exact multiple of batch size") {
+    auto gen = batched_range<4>(8);
+    auto sizes = std::vector<std::size_t>{};
+    for (auto batch : gen.batches()) {
+        sizes.push_back(batch.size());
+    }
+    CHECK_EQ(sizes, std::vector<std::size_t>{4, 4});
+
+    auto gen2 = batched_range<4>(8);
+    auto count = 0;
+    for ([[maybe_unused]] auto val : gen2) {
+        ++count;
+    }
+    CHECK_EQ(count, 8);
+}
+
+TEST_CASE("Test BatchedGenerator sum over batches") {
+    constexpr auto N = 10000;
+    auto gen = batched_range<256>(N);
+    auto total = 0LL;
+    for (auto batch : gen.batches()) {
+        total += std::accumulate(batch.begin(), batch.end(), 0LL);
+    }
+    CHECK_EQ(total, 1LL * N * (N - 1) / 2);
+}
+
+TEST_CASE("Test BatchedGenerator early break") {
+    auto gen = batched_range<4>(100);
+    auto count = 0;
+    for (auto val : gen) {
+        CHECK_EQ(val, count);
+        ++count;
+        if (count >= 6) break;
+    }
+    CHECK_EQ(count, 6);
+}
+
+TEST_CASE("Test BatchedGenerator strings") {
+    auto gen = []() -> py::BatchedGenerator<std::string, 2> {
+        co_yield "hello";
+        co_yield std::string("big") + "ger";
+        co_yield "world";
+    }();
+    auto expected = std::vector<std::string>{"hello", "bigger", "world"};
+    auto idx = std::size_t{0};
+    for (const auto& val : gen) {
+        CHECK_EQ(val, expected[idx]);
+        ++idx;
+    }
+    CHECK_EQ(idx, expected.size());
+}
+
+TEST_CASE("Test BatchedGenerator move semantics") {
+    auto gen1 = batched_range<3>(5);
+    auto gen2 = std::move(gen1);
+    CHECK(gen1.begin() == gen1.end());
+    auto count = 0;
+    for ([[maybe_unused]] auto val : gen2) {
+        ++count;
+    }
+    CHECK_EQ(count, 5);
+}
+
+TEST_CASE("Test BatchedGenerator default constructed") {
+    py::BatchedGenerator<int> gen;
+    CHECK(gen.begin() == gen.end());
+}
+
+py::BatchedGenerator<int, 4> batched_throws_after(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+    throw std::runtime_error("batched generator failed");
+}
+
+TEST_CASE("Test BatchedGenerator rethrows after buffered values") {
+    auto gen = batched_throws_after(6);
+    auto values = std::vector<int>{};
+    CHECK_THROWS_AS(
+        [&] {
+            for (auto val : gen) {
+                values.push_back(val);
+            }
+        }(),
+        std::runtime_error);
+    CHECK_EQ(values, std::vector<int>{0, 1, 2, 3, 4, 5});
+}
@@ -0,0 +1,159 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <py2cpp/frame_alloc.hpp>
+#include <py2cpp/gen.hpp>
+
+TEST_CASE("Test FramePool reuses blocks of the same size class") {
+    py::FramePool pool;
+    auto* p1 = pool.allocate(100);
+    pool.deallocate(p1, 100);
+    CHECK_EQ(pool.cached_blocks(), 1);
+
+    auto* p2 = pool.allocate(120);  // same 128-byte class
+    CHECK_EQ(p2, p1);
+    CHECK_EQ(pool.cached_blocks(), 0);
+
+    auto* p3 = pool.allocate(200);  // different class
+    CHECK_NE(p3, p1);
+    pool.deallocate(p2, 120);
+    pool.deallocate(p3, 200);
+    CHECK_EQ(pool.cached_blocks(), 2);
+
+    pool.release();
+    CHECK_EQ(pool.cached_blocks(), 0);
+}
+
+TEST_CASE("Test FramePool large blocks bypass the pool") {
+    py::FramePool pool;
+    constexpr auto big = py::FramePool::granularity * py::FramePool::num_classes + 1;
+    auto* ptr = pool.allocate(big);
+    pool.deallocate(ptr, big);
+    CHECK_EQ(pool.cached_blocks(), 0);
+}
+
+py::Generator<int> pooled_range(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+
+TEST_CASE("Test Generator frames are recycled") {
+    auto& pool = py::FramePool::local();
+    { [[maybe_unused]] auto warm = pooled_range(3); }
+    const auto cached = pool.cached_blocks();
+    REQUIRE(cached >= 1);
+    {
+        auto gen = pooled_range(3);
+        CHECK_EQ(pool.cached_blocks(), cached - 1);
+        auto sum = 0;
+        for (auto val : gen) {
+            sum += val;
+        }
+        CHECK_EQ(sum, 3);
+    }
+    CHECK_EQ(pool.cached_blocks(), cached);
+}
+
+template <typename T> struct CountingAllocator {
+    using value_type = T;
+
+    int* count;
+
+    explicit CountingAllocator(int* cnt) noexcept : count{cnt} {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept : count{other.count} {}
+
+    auto allocate(std::size_t n) -> T* {
+        ++*this->count;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        --*this->count;
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <typename U> auto operator==(const CountingAllocator<U>& other) const noexcept
+        -> bool {
+        return this->count == other.count;
+    }
+};
+
+// See FrameAllocated: GCC -O0 misreports the allocator-aware frames below.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+py::Generator<int> counted_range(std::allocator_arg_t, CountingAllocator<std::byte>, int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+
+TEST_CASE("Test Generator with allocator_arg") {
+    auto live = 0;
+    {
+        auto gen = counted_range(std::allocator_arg, CountingAllocator<std::byte>{&live}, 4);
+        CHECK_EQ(live, 1);
+        auto count = 0;
+        for (auto val : gen) {
+            CHECK_EQ(val, count);
+            ++count;
+        }
+        CHECK_EQ(count, 4);
+    }
+    CHECK_EQ(live, 0);
+}
+
+py::Generator<int> arena_range(std::allocator_arg_t, std::pmr::polymorphic_allocator<>, int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i * 10;
+    }
+}
+
+TEST_CASE("Test Generator with a user-supplied arena") {
+    std::array<std::byte, 4096> buffer{};
+    std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(),
+                                              std::pmr::null_memory_resource()};
+    auto sum = 0;
+    for (auto round = 0; round < 3; ++round) {
+        auto gen = arena_range(std::allocator_arg, &arena, 3);
+        for (auto val : gen) {
+            sum += val;
+        }
+    }
+    CHECK_EQ(sum, 90);
+}
+
+struct Sequence {
+    int start;
+
+    py::Generator<int> iota(std::allocator_arg_t, CountingAllocator<std::byte>, int n) const {
+        for (int i = 0; i < n; ++i) {
+            co_yield this->start + i;
+        }
+    }
+};
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#    pragma GCC diagnostic pop
+#endif
+
+TEST_CASE("Test Generator member coroutine with allocator_arg") {
+    auto live = 0;
+    const auto seq = Sequence{5};
+    {
+        auto gen = seq.iota(std::allocator_arg, CountingAllocator<std::byte>{&live}, 3);
+        CHECK_EQ(live, 1);
+        auto it = gen.begin();
+        CHECK_EQ(*it, 5);
+        ++it;
+        CHECK_EQ(*it, 6);
+    }
+    CHECK_EQ(live, 0);
+}
@@ -2,7 +2,9 @@
 
 #include <array>
 #include <cmath>
+#include <memory>
 #include <py2cpp/gen.hpp>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -349,3 +351,68 @@ TEST_CASE("Test Generator default constructed") {
     py::Generator<int> gen2 = std::move(gen);
     CHECK(gen2.begin() == gen2.end());
 }
+
+py::Generator<std::unique_ptr<int>> unique_ints(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield std::make_unique<int>(i);
+    }
+}
+
+TEST_CASE("Test Generator move-only values") {
+    auto gen = unique_ints(3);
+    std::vector<std::unique_ptr<int>> owned;
+    for (auto& ptr : gen) {
+        owned.push_back(std::move(ptr));
+    }
+    REQUIRE_EQ(owned.size(), size_t{3});
+    for (auto i = 0; i < 3; ++i) {
+        CHECK_EQ(*owned[static_cast<size_t>(i)], i);
+    }
+}
+
+TEST_CASE("Test Generator owns yielded rvalues") {
+    const std::string* local = nullptr;
+    auto gen = [](const std::string*& addr) -> py::Generator<std::string> {
+        auto big = std::string(1000, 'x');
+        addr = &big;
+        co_yield std::move(big);
+    }(local);
+    auto it = gen.begin();
+    CHECK_EQ(it->size(), size_t{1000});
+    CHECK_NE(&*it, local);  // moved into the promise, not referenced
+    CHECK(it.owns_value());
+}
+
+TEST_CASE("Test Generator lvalues are not copied") {
+    auto source = std::vector<int>{1, 2, 3};
+    auto gen = [](std::vector<int>& vec) -> py::Generator<std::vector<int>> {
+        co_yield vec;
+    }(source);
+    auto it = gen.begin();
+    CHECK_EQ(&*it, &source);
+}
+
+py::Generator<int> throws_after(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+    throw std::runtime_error("generator failed");
+}
+
+TEST_CASE("Test Generator rethrows exceptions") {
+    auto gen = throws_after(2);
+    auto values = std::vector<int>{};
+    CHECK_THROWS_AS(
+        [&] {
+            for (auto val : gen) {
+                values.push_back(val);
+            }
+        }(),
+        std::runtime_error);
+    CHECK_EQ(values, std::vector<int>{0, 1});
+}
+
+TEST_CASE("Test Generator rethrows from begin") {
+    auto gen = throws_after(0);
+    CHECK_THROWS_AS(gen.begin(), std::runtime_error);
+}
@@ -0,0 +1,107 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <py2cpp/parallel_gen.hpp>
+#include <py2cpp/recursive_gen.hpp>
+#include <py2cpp/thread_pool.hpp>
+#include <stdexcept>
+#include <vector>
+
+// Pre-order walk of an implicit complete tree; subtrees above `cutoff`
+// levels are spawned, the rest recurse inline.
+static py::RecursiveGenerator<int> tree(int id, int depth, int fanout, int cutoff) {
+    co_yield id;
+    if (depth == 0) co_return;
+    for (int i = 0; i < fanout; ++i) {
+        auto child = tree(id * fanout + i + 1, depth - 1, fanout, cutoff);
+        if (depth > cutoff) {
+            co_yield py::spawn(std::move(child));
+        } else {
+            co_yield std::move(child);
+        }
+    }
+}
+
+static auto sequential(int depth, int fanout) -> std::vector<int> {
+    auto result = std::vector<int>{};
+    for (auto val : tree(0, depth, fanout, 0)) {
+        result.push_back(val);
+    }
+    return result;
+}
+
+TEST_CASE("Test spawn runs inline without a pool") {
+    auto expected = std::vector<int>{0, 1, 3, 4, 2, 5, 6};
+    CHECK_EQ(sequential(2, 2), expected);
+}
+
+TEST_CASE("Test ParallelGenerator unordered") {
+    py::ThreadPool pool{4};
+    auto expected = sequential(8, 3);
+    auto result = std::vector<int>{};
+    for (auto val : py::parallel(pool, tree(0, 8, 3, 2))) {
+        result.push_back(val);
+    }
+    std::sort(result.begin(), result.end());
+    std::sort(expected.begin(), expected.end());
+    CHECK_EQ(result, expected);
+}
+
+TEST_CASE("Test ParallelGenerator ordered") {
+    py::ThreadPool pool{4};
+    const auto expected = sequential(8, 3);
+    auto result = std::vector<int>{};
+    for (auto val : py::parallel(pool, tree(0, 8, 3, 2), true)) {
+        result.push_back(val);
+    }
+    CHECK_EQ(result, expected);
+}
+
+TEST_CASE("Test ParallelGenerator small chunks keep order") {
+    py::ThreadPool pool{3};
+    const auto expected = sequential(6, 4);
+    auto gen = py::ParallelGenerator<int>{pool, tree(0, 6, 4, 1), true, 3};
+    auto result = std::vector<int>{};
+    for (auto val : gen) {
+        result.push_back(val);
+    }
+    CHECK_EQ(result, expected);
+}
+
+TEST_CASE("Test ParallelGenerator empty root") {
+    py::ThreadPool pool{2};
+    auto gen = py::parallel(pool, py::RecursiveGenerator<int>{});
+    CHECK(gen.begin() == gen.end());
+}
+
+TEST_CASE("Test ParallelGenerator early break cancels jobs") {
+    py::ThreadPool pool{4};
+    auto count = std::size_t{0};
+    {
+        for ([[maybe_unused]] auto val : py::parallel(pool, tree(0, 12, 3, 10))) {
+            if (++count == 100) break;
+        }
+    }
+    CHECK_EQ(count, std::size_t{100});
+}
+
+static py::RecursiveGenerator<int> failing_subtree(int depth) {
+    co_yield depth;
+    if (depth == 0) {
+        throw std::runtime_error("subtree failed");
+    }
+    co_yield py::spawn(failing_subtree(depth - 1));
+}
+
+TEST_CASE("Test ParallelGenerator rethrows from spawned subtrees") {
+    py::ThreadPool pool{2};
+    for (auto ordered : {false, true}) {
+        CHECK_THROWS_AS(
+            [&] {
+                for ([[maybe_unused]] auto val : py::parallel(pool, failing_subtree(5), ordered)) {
+                }
+            }(),
+            std::runtime_error);
+    }
+}
@@ -0,0 +1,172 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <memory>
+#include <py2cpp/gen.hpp>
+#include <py2cpp/prefetch.hpp>
+#include <py2cpp/recursive_gen.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Test SpscRing push and pop") {
+    auto ring = py::SpscRing<int>(3);
+    CHECK_EQ(ring.capacity(), 4);
+    for (auto i = 0; i < 4; ++i) {
+        CHECK(ring.try_push(i));
+    }
+    CHECK_FALSE(ring.try_push(4));
+
+    REQUIRE(ring.wait_front());
+    CHECK_EQ(ring.front(), 0);
+    ring.pop();
+    CHECK(ring.try_push(4));
+
+    ring.close();
+    auto values = std::vector<int>{};
+    while (ring.wait_front()) {
+        values.push_back(ring.front());
+        ring.pop();
+    }
+    CHECK_EQ(values, std::vector<int>{1, 2, 3, 4});
+}
+
+TEST_CASE("Test SpscRing cancel releases a blocked producer") {
+    auto ring = py::SpscRing<int>(1);
+    CHECK(ring.push(1));
+    ring.cancel();
+    CHECK_FALSE(ring.push(2));
+}
+
+py::Generator<int> count_up(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+
+TEST_CASE("Test prefetch preserves order") {
+    constexpr auto N = 10000;
+    auto count = 0;
+    for (auto val : py::prefetch(count_up(N), 16)) {
+        CHECK_EQ(val, count);
+        ++count;
+    }
+    CHECK_EQ(count, N);
+}
+
+TEST_CASE("Test prefetch with capacity one") {
+    auto values = std::vector<int>{};
+    for (auto val : py::prefetch(count_up(5), 1)) {
+        values.push_back(val);
+    }
+    CHECK_EQ(values, std::vector<int>{0, 1, 2, 3, 4});
+}
+
+TEST_CASE("Test prefetch empty generator") {
+    auto pre = py::prefetch(count_up(0));
+    CHECK(pre.begin() == pre.end());
+}
+
+TEST_CASE("Test prefetch strings") {
+    auto gen = []() -> py::Generator<std::string> {
+        co_yield "hello";
+        co_yield std::string("wor") + "ld";
+    }();
+    auto values = std::vector<std::string>{};
+    for (auto& val : py::prefetch(std::move(gen))) {
+        values.push_back(std::move(val));
+    }
+    CHECK_EQ(values, std::vector<std::string>{"hello", "world"});
+}
+
+py::Generator<int> endless() {
+    for (int i = 0;; ++i) {
+        co_yield i;
+    }
+}
+
+TEST_CASE("Test prefetch cancels on early destruction") {
+    auto count = 0;
+    {
+        auto pre = py::prefetch(endless(), 4);
+        for (auto val : pre) {
+            CHECK_EQ(val, count);
+            if (++count == 10) break;
+        }
+    }
+    CHECK_EQ(count, 10);
+    { [[maybe_unused]] auto unused = py::prefetch(endless(), 4); }
+}
+
+py::RecursiveGenerator<int> failing_after(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+    throw std::runtime_error("producer failed");
+}
+
+TEST_CASE("Test prefetch forwards producer exceptions") {
+    auto pre = py::prefetch(failing_after(3), 2);
+    auto values = std::vector<int>{};
+    auto caught = false;
+    try {
+        for (auto val : pre) {
+            values.push_back(val);
+        }
+    } catch (const std::runtime_error& err) {
+        caught = std::string(err.what()) == "producer failed";
+    }
+    CHECK(caught);
+    CHECK_EQ(values, std::vector<int>{0, 1, 2});
+}
+
+py::Generator<int> generator_failing_after(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+    throw std::runtime_error("generator failed");
+}
+
+TEST_CASE("Test prefetch forwards Generator exceptions") {
+    auto values = std::vector<int>{};
+    CHECK_THROWS_AS(
+        [&] {
+            for (auto val : py::prefetch(generator_failing_after(5), 2)) {
+                values.push_back(val);
+            }
+        }(),
+        std::runtime_error);
+    CHECK_EQ(values, std::vector<int>{0, 1, 2, 3, 4});
+}
+
+py::Generator<std::unique_ptr<int>> boxed(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield std::make_unique<int>(i);
+    }
+}
+
+TEST_CASE("Test prefetch move-only values") {
+    auto values = std::vector<int>{};
+    for (auto& ptr : py::prefetch(boxed(5), 2)) {
+        auto owned = std::move(ptr);
+        REQUIRE(owned != nullptr);
+        values.push_back(*owned);
+    }
+    CHECK_EQ(values, std::vector<int>{0, 1, 2, 3, 4});
+}
+
+TEST_CASE("Test prefetch copies yielded lvalues") {
+    auto kept = std::string{};
+    auto gen = [](std::string& out) -> py::Generator<std::string> {
+        auto word = std::string("borrowed");
+        co_yield word;
+        out = word;
+    }(kept);
+    auto values = std::vector<std::string>{};
+    for (auto& val : py::prefetch(std::move(gen))) {
+        values.push_back(val);
+    }
+    CHECK_EQ(values, std::vector<std::string>{"borrowed"});
+    CHECK_EQ(kept, "borrowed");
+}
@@ -1,6 +1,9 @@
 #include <doctest/doctest.h>
 
+#include <cstddef>
+#include <py2cpp/frame_alloc.hpp>
 #include <py2cpp/recursive_gen.hpp>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -197,3 +200,78 @@ TEST_CASE("Test RecursiveGenerator empty sub-generator") {
     }
     CHECK_EQ(idx, expected.size());
 }
+
+// --- Deep trees: symmetric transfer and frame recycling ---
+
+py::RecursiveGenerator<int> chain(int depth) {
+    if (depth > 1) {
+        co_yield chain(depth - 1);
+    }
+    co_yield depth;
+}
+
+TEST_CASE("Test RecursiveGenerator very deep post-order chain") {
+    // Every level descends before yielding anything
+    constexpr auto depth = 2000;
+    auto gen = chain(depth);
+    auto expected = 1;
+    for (auto val : gen) {
+        CHECK_EQ(val, expected);
+        ++expected;
+    }
+    CHECK_EQ(expected, depth + 1);
+}
+
+py::RecursiveGenerator<int> complete_tree(int level, int depth, int fanout) {
+    co_yield level;
+    if (level < depth) {
+        for (int i = 0; i < fanout; ++i) {
+            co_yield complete_tree(level + 1, depth, fanout);
+        }
+    }
+}
+
+TEST_CASE("Test RecursiveGenerator wide tree reuses frames") {
+    auto& pool = py::FramePool::local();
+    auto count = 0;
+    for ([[maybe_unused]] auto val : complete_tree(0, 3, 4)) {
+        ++count;
+    }
+    CHECK_EQ(count, 1 + 4 + 16 + 64);
+    // One frame per level is live at a time; the rest come from the pool
+    const auto cached = pool.cached_blocks();
+    CHECK_GE(cached, std::size_t{4});
+    for ([[maybe_unused]] auto val : complete_tree(0, 3, 4)) {
+    }
+    CHECK_EQ(pool.cached_blocks(), cached);
+}
+
+py::RecursiveGenerator<int> throws_at_depth(int depth) {
+    co_yield depth;
+    if (depth == 0) {
+        throw std::runtime_error("leaf failed");
+    }
+    co_yield throws_at_depth(depth - 1);
+    co_yield -1;  // never reached
+}
+
+TEST_CASE("Test RecursiveGenerator rethrows from nested generators") {
+    auto values = std::vector<int>{};
+    CHECK_THROWS_AS(
+        [&] {
+            for (auto val : throws_at_depth(3)) {
+                values.push_back(val);
+            }
+        }(),
+        std::runtime_error);
+    CHECK_EQ(values, std::vector<int>{3, 2, 1, 0});
+}
+
+TEST_CASE("Test RecursiveGenerator early break destroys nested frames") {
+    auto count = 0;
+    for (auto val : complete_tree(0, 4, 3)) {
+        if (val == 3) break;
+        ++count;
+    }
+    CHECK_EQ(count, 3);
+}
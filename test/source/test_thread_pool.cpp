@@ -0,0 +1,110 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <py2cpp/thread_pool.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Test ThreadPool runs every job") {
+    auto count = std::atomic<int>{0};
+    {
+        py::ThreadPool pool{4};
+        CHECK_EQ(pool.size(), std::size_t{4});
+        for (auto i = 0; i < 1000; ++i) {
+            pool.submit([&count] { count.fetch_add(1); });
+        }
+    }  // the destructor drains the queues
+    CHECK_EQ(count.load(), 1000);
+}
+
+TEST_CASE("Test ThreadPool accepts move-only jobs") {
+    auto sum = std::atomic<int>{0};
+    {
+        py::ThreadPool pool{2};
+        auto value = std::make_unique<int>(42);
+        pool.submit([&sum, value = std::move(value)] { sum.fetch_add(*value); });
+    }
+    CHECK_EQ(sum.load(), 42);
+}
+
+// Fork a binary tree of jobs from inside the workers
+static void fork_tree(py::ThreadPool& pool, int depth, std::atomic<int>& leaves) {
+    if (depth == 0) {
+        leaves.fetch_add(1);
+        return;
+    }
+    for (auto i = 0; i < 2; ++i) {
+        pool.submit([&pool, depth, &leaves] { fork_tree(pool, depth - 1, leaves); });
+    }
+}
+
+TEST_CASE("Test ThreadPool nested submission") {
+    auto leaves = std::atomic<int>{0};
+    {
+        py::ThreadPool pool{3};
+        pool.submit([&pool, &leaves] { fork_tree(pool, 10, leaves); });
+        while (leaves.load() != 1024) {
+            std::this_thread::yield();
+        }
+    }
+    CHECK_EQ(leaves.load(), 1024);
+}
+
+TEST_CASE("Test ThreadPool current_worker") {
+    py::ThreadPool pool{2};
+    CHECK_EQ(pool.current_worker(), py::ThreadPool::npos);
+    auto index = std::atomic<std::size_t>{py::ThreadPool::npos};
+    pool.submit([&] { index.store(pool.current_worker()); });
+    while (index.load() == py::ThreadPool::npos) {
+        std::this_thread::yield();
+    }
+    CHECK_LT(index.load(), std::size_t{2});
+}
+
+TEST_CASE("Test parallel_for covers the range once") {
+    py::ThreadPool pool{3};
+    auto hits = std::vector<std::atomic<int>>(1001);
+    auto chunks_seen = std::atomic<std::size_t>{0};
+    py::parallel_for(pool, hits.size(), 8, [&](std::size_t, std::size_t lo, std::size_t hi) {
+        chunks_seen.fetch_add(1);
+        for (auto i = lo; i != hi; ++i) {
+            hits[i].fetch_add(1);
+        }
+    });
+    CHECK_EQ(chunks_seen.load(), std::size_t{8});
+    CHECK(std::all_of(hits.begin(), hits.end(), [](const auto& h) { return h.load() == 1; }));
+
+    auto calls = 0;
+    py::parallel_for(pool, 0, 4, [&](std::size_t c, std::size_t lo, std::size_t hi) {
+        CHECK_EQ(c, std::size_t{0});
+        CHECK_EQ(lo, hi);
+        ++calls;
+    });
+    CHECK_EQ(calls, 1);
+}
+
+TEST_CASE("Test parallel_for nested inside jobs") {
+    py::ThreadPool pool{2};
+    auto total = std::atomic<std::size_t>{0};
+    py::parallel_for(pool, 4, 4, [&](std::size_t, std::size_t lo, std::size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            py::parallel_for(pool, 100, 4, [&](std::size_t, std::size_t a, std::size_t b) {
+                total.fetch_add(b - a);
+            });
+        }
+    });
+    CHECK_EQ(total.load(), std::size_t{400});
+}
+
+TEST_CASE("Test parallel_for rethrows") {
+    py::ThreadPool pool{2};
+    CHECK_THROWS_AS(py::parallel_for(pool, 10, 5,
+                                     [](std::size_t c, std::size_t, std::size_t) {
+                                         if (c == 3) throw std::runtime_error("chunk failed");
+                                     }),
+                    std::runtime_error);
+}
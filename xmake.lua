@@ -2,7 +2,7 @@ add_rules("mode.debug", "mode.release", "mode.coverage")
 add_requires("doctest", {alias = "doctest"})
 add_requires("fmt", {alias = "fmt"})
 add_requires("boost", {alias = "boost", configs = {cmake = false}})
--- add_requires("benchmark", {alias = "benchmark"})
+add_requires("benchmark", {alias = "benchmark"})
 
 if is_mode("coverage") then
     add_cxflags("-ftest-coverage", "-fprofile-arcs", {force = true})
@@ -11,6 +11,7 @@ end
 if is_plat("linux") then
     set_warnings("all", "error")
     add_cxflags("-Wconversion", {force = true})
+    add_syslinks("pthread")
     -- Check if we're on Termux/Android
     local termux_prefix = os.getenv("PREFIX")
     if termux_prefix then
@@ -34,6 +35,16 @@ target("test_py2cpp")
     add_packages("boost")
     add_tests("default")
 
+target("bench_py2cpp")
+    set_languages("c++20")
+    set_kind("binary")
+    add_includedirs("include", {public = true})
+    add_files("bench/source/*.cpp")
+    add_packages("benchmark")
+    add_files("bench/boost/*.cpp")
+    add_packages("boost")
+    add_links("benchmark_main")
+
 
 -- If you want to known more usage about xmake, please see https://xmake.io
 --